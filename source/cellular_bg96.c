@@ -27,6 +27,9 @@
 
 
 #include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include "cellular_platform.h"
 #include "cellular_config.h"
 #include "cellular_config_defaults.h"
@@ -38,58 +41,1231 @@
 
 #define ENBABLE_MODULE_UE_RETRY_COUNT      ( 3U )
 #define ENBABLE_MODULE_UE_RETRY_TIMEOUT    ( 5000U )
+#define BG96_CFUN_RETRY_TIMEOUT            ( 15000U ) /* Maximum response time of AT+CFUN. */
+#define BG96_FAST_CMD_RESPONSE_TIME        ( 300U )   /* Maximum response time of ATE0 and AT. */
 #define BG96_NWSCANSEQ_CMD_MAX_SIZE        ( 29U ) /* The length of AT+QCFG="nwscanseq",020301,1\0. */
+#define BG96_NWSCANSEQ_CMD_PREFIX          "AT+QCFG=\"nwscanseq\","
+#define BG96_ENABLE_UE_CMDS_MAX            ( 8U )
+#define BG96_ENABLE_URC_CMDS_MAX           ( 6U )
+#define BG96_BAND_CMD_PREFIX               "AT+QCFG=\"band\","
+#define BG96_BAND_CMD_MAX_SIZE             ( 72U ) /* The length of the prefix and three 64 bits masks. */
+#define BG96_IPR_CMD_MAX_SIZE              ( 20U ) /* The length of AT+IPR=921600;&W\0. */
+#define BG96_BAUD_RATE_SETTLE_MS           ( 100U )
+
+/* Values written by Cellular_ModuleEnableUE. */
+#define BG96_NWSCANMODE_CONFIG             "0"
+#define BG96_IOTOPMODE_CONFIG              "2"
+
+#if ( CELLULAR_BG96_FAST_BOOT == 1 )
+    #define BG96_BOOT_CONFIG_QUERY_CMD \
+    "AT+QCFG=\"band\";+QCFG=\"nwscanmode\";+QCFG=\"iotopmode\";+QCFG=\"nwscanseq\""
+    #define BG96_BOOT_CONFIG_VALUE_MAX_SIZE    ( 32U )
+#endif
+
+#if ( CELLULAR_BG96_BAND_SCAN_PLAN == 1 )
+    #define BG96_BAND_SCAN_EVT_REGISTERED        ( 0x0001UL )
+    #define BG96_BAND_SCAN_EVT_FAILED            ( 0x0002UL )
+    #define BG96_BAND_SCAN_EVT_STOP              ( 0x0004UL )
+    #define BG96_BAND_SCAN_EVT_THREAD_STOPPED    ( 0x0008UL )
+#endif
+
+#if ( CELLULAR_BG96_REQUEST_PRIORITY == 1 )
+    #define BG96_REQUEST_LANE_RELEASED    ( 0x0001U )
+    #define BG96_REQUEST_LANE_POLL_MS     ( 100U )
+#endif
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Retry policy of an initialization AT command.
+ */
+typedef struct bg96RetryPolicy
+{
+    uint8_t tryCount;        /* Maximum number of tries. */
+    uint32_t firstTimeoutMs; /* Timeout of the first try. Doubled after every timed out try. */
+    uint32_t maxTimeoutMs;   /* Upper bound of the timeout. */
+    bool retryOnError;       /* Retry if the modem responds with an error result code. */
+} bg96RetryPolicy_t;
+
+/**
+ * @brief NV stored settings written by Cellular_ModuleEnableUE.
+ */
+typedef enum bg96BootConfigItem
+{
+    BG96_BOOT_CONFIG_BAND,
+    BG96_BOOT_CONFIG_NWSCANMODE,
+    BG96_BOOT_CONFIG_IOTOPMODE,
+    BG96_BOOT_CONFIG_NWSCANSEQ,
+    BG96_BOOT_CONFIG_MAX
+} bg96BootConfigItem_t;
+
+/**
+ * @brief Current values of the NV stored settings. An empty value is unknown.
+ */
+typedef struct bg96BootConfig
+{
+    #if ( CELLULAR_BG96_FAST_BOOT == 1 )
+        char values[ BG96_BOOT_CONFIG_MAX ][ BG96_BOOT_CONFIG_VALUE_MAX_SIZE ];
+    #else
+        uint8_t reserved;
+    #endif
+} bg96BootConfig_t;
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t sendAtCommandWithRetryTimeout( CellularContext_t * pContext,
+                                                      const CellularAtReq_t * pAtReq,
+                                                      const bg96RetryPolicy_t * pRetryPolicy );
+static CellularError_t sendAtCommandSequence( CellularContext_t * pContext,
+                                              const char * const * ppAtCmds,
+                                              uint8_t cmdCount,
+                                              const bg96RetryPolicy_t * pRetryPolicy,
+                                              bool stopOnError,
+                                              uint8_t * pFailedIndex );
+static CellularError_t sendAtCommandBatch( CellularContext_t * pContext,
+                                           const char * const * ppAtCmds,
+                                           uint8_t cmdCount,
+                                           const bg96RetryPolicy_t * pRetryPolicy,
+                                           bool stopOnError,
+                                           uint8_t * pFailedIndex );
+static bool bootConfigApplied( const bg96BootConfig_t * pBootConfig,
+                               bg96BootConfigItem_t configItem,
+                               const char * pConfigValue );
+static uint8_t appendPortSettings( const char ** ppInitCmds,
+                                   uint8_t initCmdCount );
+
+#if ( CELLULAR_BG96_BAND_SCAN_PLAN == 1 )
+    static bool applyScanPlan( CellularBG96BandMask_t * pBandMask );
+    static void bandScanThread( void * pUserData );
+    static void startBandScanThread( CellularContext_t * pContext,
+                                     cellularModuleContext_t * pModuleContext );
+#endif
+static void bandScanCleanup( cellularModuleContext_t * pModuleContext );
+
+#if ( CELLULAR_BG96_BAUD_RATE > 0U )
+    static CellularError_t verifyBaudRate( CellularContext_t * pContext );
+    static bool probeBaudRate( CellularContext_t * pContext );
+    static CellularError_t sendBaudRate( CellularContext_t * pContext,
+                                         uint32_t baudRate );
+    static CellularError_t setBaudRate( CellularContext_t * pContext,
+                                        uint32_t baudRate );
+#endif
+static bool createDnsQueues( void );
+static void deleteDnsQueues( void );
+
+/*-----------------------------------------------------------*/
+
+/* The first try of a command must wait for its maximum response time. A response
+ * received after the timeout would be taken for the response of the next try. */
+#if ( CELLULAR_BG96_AT_RETRY_FIRST_TIMEOUT_MS < BG96_FAST_CMD_RESPONSE_TIME )
+    #error "CELLULAR_BG96_AT_RETRY_FIRST_TIMEOUT_MS is shorter than the maximum response time of ATE0."
+#endif
+
+/* ATE0 and AT respond within BG96_FAST_CMD_RESPONSE_TIME. They may fail while
+ * the modem UART is settling. */
+static const bg96RetryPolicy_t retryPolicyStartup =
+{
+    ENBABLE_MODULE_UE_RETRY_COUNT, CELLULAR_BG96_AT_RETRY_FIRST_TIMEOUT_MS, ENBABLE_MODULE_UE_RETRY_TIMEOUT, true
+};
+
+/* A band or scan setting may start a network rescan and respond late. Every try
+ * waits ENBABLE_MODULE_UE_RETRY_TIMEOUT. An error result code of a setting is
+ * permanent. Only timeouts are retried. */
+static const bg96RetryPolicy_t retryPolicySetting =
+{
+    ENBABLE_MODULE_UE_RETRY_COUNT, ENBABLE_MODULE_UE_RETRY_TIMEOUT, ENBABLE_MODULE_UE_RETRY_TIMEOUT, false
+};
+
+/* The URC settings are sent once with the default timeout. */
+static const bg96RetryPolicy_t retryPolicyUrc =
+{
+    1U, PACKET_REQ_TIMEOUT_MS, PACKET_REQ_TIMEOUT_MS, false
+};
+
+/* AT+CFUN may take up to BG96_CFUN_RETRY_TIMEOUT. */
+static const bg96RetryPolicy_t retryPolicyCfun =
+{
+    ENBABLE_MODULE_UE_RETRY_COUNT, BG96_CFUN_RETRY_TIMEOUT, BG96_CFUN_RETRY_TIMEOUT, true
+};
+
+#if ( CELLULAR_BG96_BAUD_RATE > 0U )
+    /* The baud rate probe sends AT once at each baud rate. */
+    static const bg96RetryPolicy_t retryPolicyProbe =
+    {
+        1U, BG96_FAST_CMD_RESPONSE_TIME, BG96_FAST_CMD_RESPONSE_TIME, false
+    };
+#endif
+
+static cellularModuleContext_t cellularBg96Context = { 0 };
+
+#if ( CELLULAR_BG96_BAND_SCAN_PLAN == 1 )
+    /* Set before Cellular_Init. The module context is cleared by Cellular_ModuleInit. */
+    static CellularBG96BandMask_t scanPlanBandMask = { 0 };
+#endif
+
+const char * CellularSrcTokenErrorTable[] =
+{ "ERROR", "BUSY", "NO CARRIER", "NO ANSWER", "NO DIALTONE", "ABORTED", "+CMS ERROR", "+CME ERROR", "SEND FAIL" };
+uint32_t CellularSrcTokenErrorTableSize = sizeof( CellularSrcTokenErrorTable ) / sizeof( char * );
+
+const char * CellularSrcTokenSuccessTable[] =
+{ "OK", "CONNECT", "SEND OK", ">" };
+uint32_t CellularSrcTokenSuccessTableSize = sizeof( CellularSrcTokenSuccessTable ) / sizeof( char * );
+
+const char * CellularUrcTokenWoPrefixTable[] =
+{ "POWERED DOWN", "PSM POWER DOWN", "RDY" };
+uint32_t CellularUrcTokenWoPrefixTableSize = sizeof( CellularUrcTokenWoPrefixTable ) / sizeof( char * );
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t sendAtCommandWithRetryTimeout( CellularContext_t * pContext,
+                                                      const CellularAtReq_t * pAtReq,
+                                                      const bg96RetryPolicy_t * pRetryPolicy )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    uint8_t tryCount = 0;
+    uint32_t timeoutMs = 0;
+    TickType_t startTick = xTaskGetTickCount();
+
+    if( ( pAtReq == NULL ) || ( pRetryPolicy == NULL ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        timeoutMs = pRetryPolicy->firstTimeoutMs;
+
+        for( ; tryCount < pRetryPolicy->tryCount; tryCount++ )
+        {
+            pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, *pAtReq, timeoutMs );
+            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                break;
+            }
+            else if( pktStatus == CELLULAR_PKT_STATUS_TIMED_OUT )
+            {
+                /* The modem may be busy. Wait longer on the next try. */
+                timeoutMs = ( ( timeoutMs * 2U ) < pRetryPolicy->maxTimeoutMs ) ? ( timeoutMs * 2U ) : pRetryPolicy->maxTimeoutMs;
+            }
+            else if( ( pktStatus == CELLULAR_PKT_STATUS_FAILURE ) && ( pRetryPolicy->retryOnError == false ) )
+            {
+                LogDebug( ( "%s error result, no retry", pAtReq->pAtCmd ) );
+                break;
+            }
+            else
+            {
+                /* Retry immediately. */
+            }
+        }
+
+        _Cellular_BootTimingCommand( &cellularBg96Context, pAtReq->pAtCmd, startTick,
+                                     ( tryCount < pRetryPolicy->tryCount ) ? ( tryCount + 1U ) : tryCount, cellularStatus );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( CELLULAR_BG96_FAST_BOOT == 1 )
+
+    static const char * const bootConfigNames[ BG96_BOOT_CONFIG_MAX ] =
+    {
+        "band",
+        "nwscanmode",
+        "iotopmode",
+        "nwscanseq"
+    };
+
+/*-----------------------------------------------------------*/
+
+/* Parse the +QCFG responses of BG96_BOOT_CONFIG_QUERY_CMD. */
+    static CellularPktStatus_t _Cellular_RecvFuncGetBootConfig( CellularContext_t * pContext,
+                                                                const CellularATCommandResponse_t * pAtResp,
+                                                                void * pData,
+                                                                uint16_t dataLen )
+    {
+        CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+        CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+        const CellularATCommandLine_t * pCommandItem = NULL;
+        bg96BootConfig_t * pBootConfig = NULL;
+        char * pInputLine = NULL;
+        char * pToken = NULL;
+        uint32_t i = 0;
+
+        if( pContext == NULL )
+        {
+            LogError( ( "GetBootConfig: Invalid context" ) );
+            pktStatus = CELLULAR_PKT_STATUS_FAILURE;
+        }
+        else if( ( pAtResp == NULL ) || ( pData == NULL ) || ( dataLen != sizeof( bg96BootConfig_t ) ) )
+        {
+            LogError( ( "GetBootConfig: Invalid param" ) );
+            pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
+        }
+        else
+        {
+            pBootConfig = ( bg96BootConfig_t * ) pData;
+
+            for( pCommandItem = pAtResp->pItm; pCommandItem != NULL; pCommandItem = pCommandItem->pNext )
+            {
+                pInputLine = pCommandItem->pLine;
+                atCoreStatus = Cellular_ATRemovePrefix( &pInputLine );
+
+                if( atCoreStatus == CELLULAR_AT_SUCCESS )
+                {
+                    atCoreStatus = Cellular_ATRemoveAllDoubleQuote( pInputLine );
+                }
+
+                if( atCoreStatus == CELLULAR_AT_SUCCESS )
+                {
+                    atCoreStatus = Cellular_ATRemoveAllWhiteSpaces( pInputLine );
+                }
+
+                if( atCoreStatus == CELLULAR_AT_SUCCESS )
+                {
+                    atCoreStatus = Cellular_ATGetNextTok( &pInputLine, &pToken );
+                }
+
+                /* The remaining string is the value of the setting. */
+                for( i = 0; ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( pInputLine != NULL ) &&
+                     ( i < ( uint32_t ) BG96_BOOT_CONFIG_MAX ); i++ )
+                {
+                    if( ( strcmp( pToken, bootConfigNames[ i ] ) == 0 ) &&
+                        ( strlen( pInputLine ) < BG96_BOOT_CONFIG_VALUE_MAX_SIZE ) )
+                    {
+                        ( void ) strncpy( pBootConfig->values[ i ], pInputLine, BG96_BOOT_CONFIG_VALUE_MAX_SIZE - 1U );
+                        break;
+                    }
+                }
+            }
+        }
+
+        return pktStatus;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Read the NV stored settings in one AT command. A setting is written if it is
+ * not read successfully. */
+    static void readBootConfig( CellularContext_t * pContext,
+                                bg96BootConfig_t * pBootConfig )
+    {
+        CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+        TickType_t startTick = xTaskGetTickCount();
+        CellularAtReq_t atReqGetBootConfig =
+        {
+            BG96_BOOT_CONFIG_QUERY_CMD,
+            CELLULAR_AT_MULTI_WITH_PREFIX,
+            "+QCFG",
+            _Cellular_RecvFuncGetBootConfig,
+            NULL,
+            sizeof( bg96BootConfig_t ),
+        };
+
+        atReqGetBootConfig.pData = pBootConfig;
+        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqGetBootConfig, ENBABLE_MODULE_UE_RETRY_TIMEOUT );
+        _Cellular_BootTimingCommand( &cellularBg96Context, atReqGetBootConfig.pAtCmd, startTick, 1U,
+                                     _Cellular_TranslatePktStatus( pktStatus ) );
+
+        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        {
+            LogWarn( ( "Cellular_ModuleEnableUE: read configuration fail %d", pktStatus ) );
+            ( void ) memset( pBootConfig, 0, sizeof( bg96BootConfig_t ) );
+        }
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Value of a digit in base 10 or 16. Returns base if c is not a digit. */
+    static uint32_t bootConfigDigit( char c,
+                                     uint32_t base )
+    {
+        uint32_t digit = base;
+
+        if( ( c >= '0' ) && ( c <= '9' ) )
+        {
+            digit = ( uint32_t ) c - ( uint32_t ) '0';
+        }
+        else if( ( c >= 'a' ) && ( c <= 'f' ) )
+        {
+            digit = ( uint32_t ) c - ( uint32_t ) 'a' + 10U;
+        }
+        else if( ( c >= 'A' ) && ( c <= 'F' ) )
+        {
+            digit = ( uint32_t ) c - ( uint32_t ) 'A' + 10U;
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
+
+        return ( digit < base ) ? digit : base;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Parse the number at *ppValue up to the next comma. *ppDigits points to the
+ * significant digits. Returns false if the number has no digit or an invalid
+ * character. The band masks may be wider than 64 bits, so the digits are
+ * compared instead of converted. */
+    static bool bootConfigNumber( const char ** ppValue,
+                                  uint32_t base,
+                                  const char ** ppDigits,
+                                  uint32_t * pDigitsLength )
+    {
+        const char * pValue = *ppValue;
+        bool valid = true;
+
+        if( ( base == 16U ) && ( pValue[ 0 ] == '0' ) && ( ( pValue[ 1 ] == 'x' ) || ( pValue[ 1 ] == 'X' ) ) )
+        {
+            pValue = &pValue[ 2 ];
+        }
+
+        if( ( *pValue == ',' ) || ( *pValue == '\0' ) )
+        {
+            valid = false;
+        }
+
+        while( *pValue == '0' )
+        {
+            pValue++;
+        }
+
+        *ppDigits = pValue;
+
+        while( ( valid == true ) && ( *pValue != ',' ) && ( *pValue != '\0' ) )
+        {
+            if( bootConfigDigit( *pValue, base ) == base )
+            {
+                valid = false;
+            }
+            else
+            {
+                pValue++;
+            }
+        }
+
+        *pDigitsLength = ( uint32_t ) ( pValue - *ppDigits );
+        *ppValue = pValue;
+
+        return valid;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Compare two comma separated lists of numbers. Leading zeros and the 0x prefix
+ * of hexadecimal numbers are ignored. */
+    static bool bootConfigMatch( const char * pCurrentValue,
+                                 const char * pConfigValue,
+                                 uint32_t base )
+    {
+        const char * pCurrent = pCurrentValue;
+        const char * pConfig = pConfigValue;
+        const char * pCurrentDigits = NULL;
+        const char * pConfigDigits = NULL;
+        uint32_t currentLength = 0;
+        uint32_t configLength = 0;
+        uint32_t i = 0;
+        bool match = ( *pCurrent != '\0' ) ? true : false;
+
+        while( ( match == true ) && ( *pConfig != '\0' ) )
+        {
+            if( ( bootConfigNumber( &pCurrent, base, &pCurrentDigits, &currentLength ) == false ) ||
+                ( bootConfigNumber( &pConfig, base, &pConfigDigits, &configLength ) == false ) ||
+                ( currentLength != configLength ) || ( *pCurrent != *pConfig ) )
+            {
+                match = false;
+            }
+
+            for( i = 0; ( match == true ) && ( i < currentLength ); i++ )
+            {
+                match = ( bootConfigDigit( pCurrentDigits[ i ], base ) == bootConfigDigit( pConfigDigits[ i ], base ) ) ? true : false;
+            }
+
+            if( ( match == true ) && ( *pConfig == ',' ) )
+            {
+                pCurrent++;
+                pConfig++;
+            }
+        }
+
+        return match;
+    }
+
+#endif /* CELLULAR_BG96_FAST_BOOT. */
+
+/*-----------------------------------------------------------*/
+
+/* Returns true if the value read by readBootConfig is the same as pConfigValue. */
+static bool bootConfigApplied( const bg96BootConfig_t * pBootConfig,
+                               bg96BootConfigItem_t configItem,
+                               const char * pConfigValue )
+{
+    bool configApplied = false;
+
+    #if ( CELLULAR_BG96_FAST_BOOT == 1 )
+        configApplied = bootConfigMatch( pBootConfig->values[ configItem ], pConfigValue,
+                                         ( configItem == BG96_BOOT_CONFIG_BAND ) ? 16U : 10U );
+
+        if( configApplied == true )
+        {
+            LogDebug( ( "Cellular_ModuleEnableUE: skip %s", bootConfigNames[ configItem ] ) );
+        }
+    #else
+        ( void ) pBootConfig;
+        ( void ) configItem;
+        ( void ) pConfigValue;
+    #endif
+
+    return configApplied;
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( CELLULAR_BG96_BATCH_AT_COMMANDS == 1 )
+
+/* Join the leading extended AT commands of ppAtCmds into pCmdBuf. Returns the
+ * number of commands joined. */
+    static uint8_t joinAtCommands( const char * const * ppAtCmds,
+                                   uint8_t cmdCount,
+                                   char * pCmdBuf,
+                                   uint32_t cmdBufSize )
+    {
+        uint8_t joinCount = 0;
+        uint32_t cmdLen = 0;
+        uint32_t appendLen = 0;
+
+        pCmdBuf[ 0 ] = '\0';
+
+        for( joinCount = 0; joinCount < cmdCount; joinCount++ )
+        {
+            if( strncmp( ppAtCmds[ joinCount ], "AT+", 3 ) != 0 )
+            {
+                break;
+            }
+
+            /* "AT+X" starts the command line and ";+X" is appended after. */
+            appendLen = ( joinCount == 0U ) ? strlen( ppAtCmds[ joinCount ] ) : ( strlen( ppAtCmds[ joinCount ] ) - 1U );
+
+            if( ( cmdLen + appendLen ) >= cmdBufSize )
+            {
+                break;
+            }
+
+            if( joinCount == 0U )
+            {
+                ( void ) strcpy( pCmdBuf, ppAtCmds[ joinCount ] );
+            }
+            else
+            {
+                ( void ) strcat( pCmdBuf, ";" );
+                ( void ) strcat( pCmdBuf, &ppAtCmds[ joinCount ][ 2 ] );
+            }
+
+            cmdLen = cmdLen + appendLen;
+        }
+
+        return joinCount;
+    }
+
+#endif /* CELLULAR_BG96_BATCH_AT_COMMANDS. */
+
+/*-----------------------------------------------------------*/
+
+/* Send the AT commands one at a time. *pFailedIndex is the index of the first
+ * failing command. */
+static CellularError_t sendAtCommandSequence( CellularContext_t * pContext,
+                                              const char * const * ppAtCmds,
+                                              uint8_t cmdCount,
+                                              const bg96RetryPolicy_t * pRetryPolicy,
+                                              bool stopOnError,
+                                              uint8_t * pFailedIndex )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularError_t sendStatus = CELLULAR_SUCCESS;
+    uint8_t i = 0;
+    CellularAtReq_t atReqGetNoResult =
+    {
+        NULL,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0
+    };
+
+    for( i = 0; i < cmdCount; i++ )
+    {
+        atReqGetNoResult.pAtCmd = ppAtCmds[ i ];
+        sendStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult, pRetryPolicy );
+
+        if( ( sendStatus != CELLULAR_SUCCESS ) && ( cellularStatus == CELLULAR_SUCCESS ) )
+        {
+            LogWarn( ( "%s failed %d", ppAtCmds[ i ], sendStatus ) );
+            cellularStatus = sendStatus;
+            *pFailedIndex = i;
+
+            if( stopOnError == true )
+            {
+                break;
+            }
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Send AT commands without result. *pFailedIndex is set to the index of the first
+ * failing command or cmdCount if all the commands succeed. */
+static CellularError_t sendAtCommandBatch( CellularContext_t * pContext,
+                                           const char * const * ppAtCmds,
+                                           uint8_t cmdCount,
+                                           const bg96RetryPolicy_t * pRetryPolicy,
+                                           bool stopOnError,
+                                           uint8_t * pFailedIndex )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularError_t sendStatus = CELLULAR_SUCCESS;
+    uint8_t cmdIndex = 0;
+    uint8_t batchCount = 0;
+    uint8_t failedIndex = 0;
+
+    #if ( CELLULAR_BG96_BATCH_AT_COMMANDS == 1 )
+        CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+        TickType_t startTick = 0;
+        char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
+        CellularAtReq_t atReqGetNoResult =
+        {
+            cmdBuf,
+            CELLULAR_AT_NO_RESULT,
+            NULL,
+            NULL,
+            NULL,
+            0
+        };
+    #endif
+
+    *pFailedIndex = cmdCount;
+
+    while( ( cmdIndex < cmdCount ) && ( ( cellularStatus == CELLULAR_SUCCESS ) || ( stopOnError == false ) ) )
+    {
+        batchCount = 1;
+        sendStatus = CELLULAR_UNKNOWN;
+
+        #if ( CELLULAR_BG96_BATCH_AT_COMMANDS == 1 )
+            batchCount = joinAtCommands( &ppAtCmds[ cmdIndex ], cmdCount - cmdIndex, cmdBuf, CELLULAR_AT_CMD_MAX_SIZE );
+
+            if( batchCount > 1U )
+            {
+                startTick = xTaskGetTickCount();
+                pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqGetNoResult,
+                                                                       pRetryPolicy->maxTimeoutMs * batchCount );
+                sendStatus = _Cellular_TranslatePktStatus( pktStatus );
+                _Cellular_BootTimingCommand( &cellularBg96Context, cmdBuf, startTick, 1U, sendStatus );
+
+                if( sendStatus != CELLULAR_SUCCESS )
+                {
+                    /* The modem stops at the failing command without telling which one. */
+                    LogDebug( ( "%s failed %d, send one at a time", cmdBuf, sendStatus ) );
+                }
+            }
+            else
+            {
+                batchCount = 1;
+            }
+        #endif
+
+        if( sendStatus != CELLULAR_SUCCESS )
+        {
+            sendStatus = sendAtCommandSequence( pContext, &ppAtCmds[ cmdIndex ], batchCount,
+                                                pRetryPolicy, stopOnError, &failedIndex );
+
+            if( ( sendStatus != CELLULAR_SUCCESS ) && ( cellularStatus == CELLULAR_SUCCESS ) )
+            {
+                cellularStatus = sendStatus;
+                *pFailedIndex = cmdIndex + failedIndex;
+            }
+        }
+
+        cmdIndex = cmdIndex + batchCount;
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Append the band masks as the values of AT+QCFG="band". */
+void _Cellular_FormatBandMask( cellularAtBuilder_t * pCmdBuilder,
+                               const CellularBG96BandMask_t * pBandMask )
+{
+    _Cellular_AtBuilderAppendHex( pCmdBuilder, pBandMask->gsmBandMask );
+    _Cellular_AtBuilderAppendLiteral( pCmdBuilder, "," );
+    _Cellular_AtBuilderAppendHex( pCmdBuilder, pBandMask->catm1BandMask );
+    _Cellular_AtBuilderAppendLiteral( pCmdBuilder, "," );
+    _Cellular_AtBuilderAppendHex( pCmdBuilder, pBandMask->nbiotBandMask );
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96SetScanPlan( const CellularBG96BandMask_t * pFirstBandMask )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    #if ( CELLULAR_BG96_BAND_SCAN_PLAN == 1 )
+        if( pFirstBandMask == NULL )
+        {
+            ( void ) memset( &scanPlanBandMask, 0, sizeof( CellularBG96BandMask_t ) );
+        }
+        else
+        {
+            scanPlanBandMask = *pFirstBandMask;
+        }
+    #else
+        ( void ) pFirstBandMask;
+        cellularStatus = CELLULAR_UNSUPPORTED;
+    #endif
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( CELLULAR_BG96_BAND_SCAN_PLAN == 1 )
+
+/* Narrow the band masks to the scan plan bands. Returns true if any RAT is narrowed. */
+    static bool applyScanPlan( CellularBG96BandMask_t * pBandMask )
+    {
+        bool narrowed = false;
+
+        if( ( pBandMask->gsmBandMask & scanPlanBandMask.gsmBandMask ) != 0U )
+        {
+            pBandMask->gsmBandMask &= scanPlanBandMask.gsmBandMask;
+            narrowed = true;
+        }
+
+        if( ( pBandMask->catm1BandMask & scanPlanBandMask.catm1BandMask ) != 0U )
+        {
+            pBandMask->catm1BandMask &= scanPlanBandMask.catm1BandMask;
+            narrowed = true;
+        }
+
+        if( ( pBandMask->nbiotBandMask & scanPlanBandMask.nbiotBandMask ) != 0U )
+        {
+            pBandMask->nbiotBandMask &= scanPlanBandMask.nbiotBandMask;
+            narrowed = true;
+        }
+
+        return narrowed;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Widen the band scan if the modem doesn't register on the scan plan bands. The
+ * URC handler can't send AT commands, so the band write is sent by this thread. */
+    static void bandScanThread( void * pUserData )
+    {
+        CellularContext_t * pContext = ( CellularContext_t * ) pUserData;
+        cellularModuleContext_t * pModuleContext = &cellularBg96Context;
+        PlatformEventGroup_EventBits uxBits = 0;
+
+        uxBits = PlatformEventGroup_WaitBits( pModuleContext->bandScanEvent,
+                                              BG96_BAND_SCAN_EVT_REGISTERED | BG96_BAND_SCAN_EVT_FAILED | BG96_BAND_SCAN_EVT_STOP,
+                                              pdTRUE, pdFALSE, pdMS_TO_TICKS( CELLULAR_BG96_BAND_SCAN_PLAN_TIMEOUT_MS ) );
+
+        if( ( uxBits & ( BG96_BAND_SCAN_EVT_REGISTERED | BG96_BAND_SCAN_EVT_STOP ) ) == 0U )
+        {
+            LogInfo( ( "bandScanThread: not registered on the scan plan bands" ) );
+            ( void ) _Cellular_WidenBandScan( pContext, pModuleContext );
+        }
+
+        ( void ) PlatformEventGroup_SetBits( pModuleContext->bandScanEvent, BG96_BAND_SCAN_EVT_THREAD_STOPPED );
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void startBandScanThread( CellularContext_t * pContext,
+                                     cellularModuleContext_t * pModuleContext )
+    {
+        PlatformEventGroupHandle_t bandScanEvent = PlatformEventGroup_Create();
+
+        if( bandScanEvent == NULL )
+        {
+            LogWarn( ( "startBandScanThread: create event group failed" ) );
+        }
+        else
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pModuleContext->bandScanEvent = bandScanEvent;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+            if( Platform_CreateDetachedThread( bandScanThread, pContext, CELLULAR_BG96_BAND_SCAN_THREAD_PRIORITY,
+                                               CELLULAR_BG96_BAND_SCAN_THREAD_STACK_SIZE ) == false )
+            {
+                LogWarn( ( "startBandScanThread: the band scan is widened by the application only" ) );
+                PlatformMutex_Lock( &pModuleContext->stateMutex );
+                pModuleContext->bandScanEvent = NULL;
+                PlatformMutex_Unlock( &pModuleContext->stateMutex );
+                PlatformEventGroup_Delete( bandScanEvent );
+            }
+        }
+    }
+
+#endif /* CELLULAR_BG96_BAND_SCAN_PLAN. */
+
+/*-----------------------------------------------------------*/
+
+static void bandScanCleanup( cellularModuleContext_t * pModuleContext )
+{
+    #if ( CELLULAR_BG96_BAND_SCAN_PLAN == 1 )
+        bool threadStarted = false;
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        threadStarted = ( pModuleContext->bandScanEvent != NULL );
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        if( threadStarted == true )
+        {
+            ( void ) PlatformEventGroup_SetBits( pModuleContext->bandScanEvent, BG96_BAND_SCAN_EVT_STOP );
+            ( void ) PlatformEventGroup_WaitBits( pModuleContext->bandScanEvent, BG96_BAND_SCAN_EVT_THREAD_STOPPED,
+                                                  pdTRUE, pdFALSE, portMAX_DELAY );
+
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            PlatformEventGroup_Delete( pModuleContext->bandScanEvent );
+            pModuleContext->bandScanEvent = NULL;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pModuleContext;
+    #endif /* CELLULAR_BG96_BAND_SCAN_PLAN. */
+}
+
+/*-----------------------------------------------------------*/
+
+/* Called by the URC handler with the <stat> of a registration URC. 0 means the
+ * modem stopped searching and 3 means the registration is denied. */
+void _Cellular_BandScanRegistration( cellularModuleContext_t * pModuleContext,
+                                     int32_t regStatus )
+{
+    #if ( CELLULAR_BG96_BAND_SCAN_PLAN == 1 )
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+        if( pModuleContext->bandScanEvent == NULL )
+        {
+            /* The band scan is not narrowed. */
+        }
+        else if( ( regStatus == 1 ) || ( regStatus == 5 ) )
+        {
+            ( void ) PlatformEventGroup_SetBits( pModuleContext->bandScanEvent, BG96_BAND_SCAN_EVT_REGISTERED );
+        }
+        else if( ( regStatus == 0 ) || ( regStatus == 3 ) )
+        {
+            ( void ) PlatformEventGroup_SetBits( pModuleContext->bandScanEvent, BG96_BAND_SCAN_EVT_FAILED );
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    #else
+        ( void ) pModuleContext;
+        ( void ) regStatus;
+    #endif /* CELLULAR_BG96_BAND_SCAN_PLAN. */
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_BootTimingPhase( cellularModuleContext_t * pModuleContext,
+                                CellularBG96BootPhase_t bootPhase )
+{
+    #if ( CELLULAR_BG96_BOOT_TIMING == 1 )
+        uint32_t phaseBit = ( uint32_t ) 1U << ( uint32_t ) bootPhase;
+
+        if( ( pModuleContext != NULL ) && ( bootPhase < CELLULAR_BG96_BOOT_PHASE_MAX ) )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            /* Only the first time a phase is reached is recorded. */
+            if( ( pModuleContext->bootTiming.phaseMask & phaseBit ) == 0U )
+            {
+                pModuleContext->bootTiming.phaseMask |= phaseBit;
+                pModuleContext->bootTiming.phaseMs[ bootPhase ] =
+                    ( uint32_t ) ( xTaskGetTickCount() - pModuleContext->bootTimingStartTick ) * portTICK_PERIOD_MS;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pModuleContext;
+        ( void ) bootPhase;
+    #endif /* CELLULAR_BG96_BOOT_TIMING. */
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_BootTimingCommand( cellularModuleContext_t * pModuleContext,
+                                  const char * pAtCmd,
+                                  TickType_t startTick,
+                                  uint8_t tryCount,
+                                  CellularError_t cellularStatus )
+{
+    #if ( CELLULAR_BG96_BOOT_TIMING == 1 )
+        CellularBG96BootCommandTiming_t * pCommandTiming = NULL;
+        TickType_t endTick = xTaskGetTickCount();
+
+        if( ( pModuleContext != NULL ) && ( pAtCmd != NULL ) )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            if( pModuleContext->bootTiming.commandCount < CELLULAR_BG96_BOOT_TIMING_COMMANDS_MAX )
+            {
+                pCommandTiming = &pModuleContext->bootTiming.commands[ pModuleContext->bootTiming.commandCount ];
+                ( void ) strncpy( pCommandTiming->command, pAtCmd, CELLULAR_BG96_BOOT_TIMING_COMMAND_SIZE - 1U );
+                pCommandTiming->command[ CELLULAR_BG96_BOOT_TIMING_COMMAND_SIZE - 1U ] = '\0';
+                pCommandTiming->startMs = ( uint32_t ) ( startTick - pModuleContext->bootTimingStartTick ) * portTICK_PERIOD_MS;
+                pCommandTiming->durationMs = ( uint32_t ) ( endTick - startTick ) * portTICK_PERIOD_MS;
+                pCommandTiming->tryCount = tryCount;
+                pCommandTiming->status = cellularStatus;
+                pModuleContext->bootTiming.commandCount++;
+            }
+            else if( pModuleContext->bootTiming.commandDropped < UINT8_MAX )
+            {
+                pModuleContext->bootTiming.commandDropped++;
+            }
+            else
+            {
+                /* Empty else MISRA 15.7 */
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pModuleContext;
+        ( void ) pAtCmd;
+        ( void ) startTick;
+        ( void ) tryCount;
+        ( void ) cellularStatus;
+    #endif /* CELLULAR_BG96_BOOT_TIMING. */
+}
+
+/*-----------------------------------------------------------*/
+
+/* The buffer is cleared. It is owned by the caller until it is released. Take
+ * it before the request lane so that the lane is not held while waiting. */
+char * _Cellular_CommandBufferAcquire( cellularModuleContext_t * pModuleContext )
+{
+    char * pCmdBuf = NULL;
+
+    if( pModuleContext != NULL )
+    {
+        PlatformMutex_Lock( &pModuleContext->commandBufferMutex );
+        ( void ) memset( pModuleContext->commandBuffer, 0, CELLULAR_BG96_COMMAND_BUFFER_SIZE );
+        pCmdBuf = pModuleContext->commandBuffer;
+    }
+
+    return pCmdBuf;
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_CommandBufferRelease( cellularModuleContext_t * pModuleContext )
+{
+    if( pModuleContext != NULL )
+    {
+        PlatformMutex_Unlock( &pModuleContext->commandBufferMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* The lane only orders the requests of the port waiting for the AT channel. A
+ * request already sent to the modem is not preempted. */
+void _Cellular_RequestLaneAcquire( cellularModuleContext_t * pModuleContext,
+                                   CellularBG96RequestClass_t requestClass )
+{
+    #if ( CELLULAR_BG96_REQUEST_PRIORITY == 1 )
+        CellularBG96RequestStats_t * pStats = NULL;
+        TickType_t startTick = xTaskGetTickCount();
+        uint32_t waitMs = 0;
+        uint32_t i = 0;
+        bool acquired = false;
+
+        if( ( pModuleContext != NULL ) && ( requestClass < CELLULAR_BG96_REQUEST_CLASS_MAX ) )
+        {
+            pStats = &pModuleContext->requestStats[ requestClass ];
+
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pStats->queueDepth++;
+
+            if( pStats->queueDepth > pStats->maxQueueDepth )
+            {
+                pStats->maxQueueDepth = pStats->queueDepth;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+            while( acquired == false )
+            {
+                PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+                if( pModuleContext->requestLaneBusy == false )
+                {
+                    acquired = true;
+
+                    /* Give way to the requests of the higher classes. */
+                    for( i = 0; i < ( uint32_t ) requestClass; i++ )
+                    {
+                        if( pModuleContext->requestStats[ i ].queueDepth > 0U )
+                        {
+                            acquired = false;
+                            break;
+                        }
+                    }
+                }
+
+                if( acquired == true )
+                {
+                    waitMs = ( uint32_t ) ( xTaskGetTickCount() - startTick ) * portTICK_PERIOD_MS;
+                    pModuleContext->requestLaneBusy = true;
+                    pStats->queueDepth--;
+                    pStats->requestCount++;
+                    pStats->totalWaitMs += waitMs;
+
+                    if( waitMs > pStats->maxWaitMs )
+                    {
+                        pStats->maxWaitMs = waitMs;
+                    }
+                }
+
+                PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+                if( acquired == false )
+                {
+                    /* All the waiters wake up on release and the highest class wins. */
+                    ( void ) PlatformEventGroup_WaitBits( pModuleContext->requestLaneEvent,
+                                                          BG96_REQUEST_LANE_RELEASED,
+                                                          pdTRUE, pdFALSE,
+                                                          pdMS_TO_TICKS( BG96_REQUEST_LANE_POLL_MS ) );
+                }
+            }
+        }
+    #else
+        ( void ) pModuleContext;
+        ( void ) requestClass;
+    #endif /* CELLULAR_BG96_REQUEST_PRIORITY. */
+}
 
 /*-----------------------------------------------------------*/
 
-static CellularError_t sendAtCommandWithRetryTimeout( CellularContext_t * pContext,
-                                                      const CellularAtReq_t * pAtReq );
+void _Cellular_RequestLaneRelease( cellularModuleContext_t * pModuleContext )
+{
+    #if ( CELLULAR_BG96_REQUEST_PRIORITY == 1 )
+        if( pModuleContext != NULL )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pModuleContext->requestLaneBusy = false;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+            ( void ) PlatformEventGroup_SetBits( pModuleContext->requestLaneEvent, BG96_REQUEST_LANE_RELEASED );
+        }
+    #else
+        ( void ) pModuleContext;
+    #endif /* CELLULAR_BG96_REQUEST_PRIORITY. */
+}
 
 /*-----------------------------------------------------------*/
 
-static cellularModuleContext_t cellularBg96Context = { 0 };
+CellularBG96RequestClass_t _Cellular_SocketRequestClass( cellularModuleContext_t * pModuleContext,
+                                                         uint32_t socketId )
+{
+    CellularBG96RequestClass_t requestClass = CELLULAR_BG96_REQUEST_BULK;
 
-const char * CellularSrcTokenErrorTable[] =
-{ "ERROR", "BUSY", "NO CARRIER", "NO ANSWER", "NO DIALTONE", "ABORTED", "+CMS ERROR", "+CME ERROR", "SEND FAIL" };
-uint32_t CellularSrcTokenErrorTableSize = sizeof( CellularSrcTokenErrorTable ) / sizeof( char * );
+    #if ( CELLULAR_BG96_REQUEST_PRIORITY == 1 )
+        if( ( pModuleContext != NULL ) && ( socketId < CELLULAR_NUM_SOCKET_MAX ) )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            requestClass = pModuleContext->socketRequestClass[ socketId ];
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pModuleContext;
+        ( void ) socketId;
+    #endif /* CELLULAR_BG96_REQUEST_PRIORITY. */
 
-const char * CellularSrcTokenSuccessTable[] =
-{ "OK", "CONNECT", "SEND OK", ">" };
-uint32_t CellularSrcTokenSuccessTableSize = sizeof( CellularSrcTokenSuccessTable ) / sizeof( char * );
+    return requestClass;
+}
 
-const char * CellularUrcTokenWoPrefixTable[] =
-{ "POWERED DOWN", "PSM POWER DOWN", "RDY" };
-uint32_t CellularUrcTokenWoPrefixTableSize = sizeof( CellularUrcTokenWoPrefixTable ) / sizeof( char * );
+/*-----------------------------------------------------------*/
+
+#if ( CELLULAR_BG96_BAUD_RATE > 0U )
+
+/* Verify the link with AT at the baud rate of the comm interface. */
+    static CellularError_t verifyBaudRate( CellularContext_t * pContext )
+    {
+        CellularAtReq_t atReqVerify =
+        {
+            "AT",
+            CELLULAR_AT_NO_RESULT,
+            NULL,
+            NULL,
+            NULL,
+            0
+        };
+
+        /* The modem and the UART may drop the first bytes after the switch. */
+        Platform_Delay( BG96_BAUD_RATE_SETTLE_MS );
+
+        return sendAtCommandWithRetryTimeout( pContext, &atReqVerify, &retryPolicyStartup );
+    }
 
 /*-----------------------------------------------------------*/
 
-static CellularError_t sendAtCommandWithRetryTimeout( CellularContext_t * pContext,
-                                                      const CellularAtReq_t * pAtReq )
-{
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    uint8_t tryCount = 0;
+/* The baud rate is saved in the modem. After a reset of the host alone the comm
+ * interface is back at the boot baud rate while the modem still runs at
+ * CELLULAR_BG96_BAUD_RATE. Returns true if the modem answers at
+ * CELLULAR_BG96_BAUD_RATE. Otherwise the comm interface is left at the boot
+ * baud rate. */
+    static bool probeBaudRate( CellularContext_t * pContext )
+    {
+        bool atBaudRate = false;
+        CellularAtReq_t atReqProbe =
+        {
+            "AT",
+            CELLULAR_AT_NO_RESULT,
+            NULL,
+            NULL,
+            NULL,
+            0
+        };
+
+        if( ( sendAtCommandWithRetryTimeout( pContext, &atReqProbe, &retryPolicyProbe ) != CELLULAR_SUCCESS ) &&
+            ( CELLULAR_BG96_COMM_SET_BAUD_RATE( CELLULAR_BG96_BAUD_RATE ) == true ) )
+        {
+            Platform_Delay( BG96_BAUD_RATE_SETTLE_MS );
+
+            if( sendAtCommandWithRetryTimeout( pContext, &atReqProbe, &retryPolicyProbe ) == CELLULAR_SUCCESS )
+            {
+                LogInfo( ( "probeBaudRate: modem is at %lu", ( unsigned long ) CELLULAR_BG96_BAUD_RATE ) );
+                atBaudRate = true;
+            }
+            else
+            {
+                ( void ) CELLULAR_BG96_COMM_SET_BAUD_RATE( CELLULAR_BG96_BOOT_BAUD_RATE );
+                Platform_Delay( BG96_BAUD_RATE_SETTLE_MS );
+            }
+        }
+
+        return atBaudRate;
+    }
+
+/*-----------------------------------------------------------*/
 
-    if( pAtReq == NULL )
+/* Send AT+IPR=baudRate and save it with AT&W, so that the modem comes back at
+ * this baud rate after a reboot of its own and "RDY" is still received. The
+ * modem responds OK at its current baud rate and then switches. */
+    static CellularError_t sendBaudRate( CellularContext_t * pContext,
+                                         uint32_t baudRate )
     {
-        cellularStatus = CELLULAR_BAD_PARAMETER;
+        CellularError_t cellularStatus = CELLULAR_SUCCESS;
+        char cmdBuf[ BG96_IPR_CMD_MAX_SIZE ] = { '\0' };
+        cellularAtBuilder_t cmdBuilder;
+        CellularAtReq_t atReqSetBaudRate =
+        {
+            cmdBuf,
+            CELLULAR_AT_NO_RESULT,
+            NULL,
+            NULL,
+            NULL,
+            0
+        };
+
+        _Cellular_AtBuilderInit( &cmdBuilder, cmdBuf, BG96_IPR_CMD_MAX_SIZE );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "AT+IPR=" );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, baudRate );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, ";&W" );
+        cellularStatus = _Cellular_AtBuilderStatus( &cmdBuilder );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqSetBaudRate, &retryPolicySetting );
+        }
+
+        return cellularStatus;
     }
-    else
+
+/*-----------------------------------------------------------*/
+
+/* Switch the modem and the comm interface to baudRate. If the link doesn't work
+ * at baudRate, both ends are switched back to the boot baud rate, which is saved
+ * again. */
+    static CellularError_t setBaudRate( CellularContext_t * pContext,
+                                        uint32_t baudRate )
     {
-        for( ; tryCount < ENBABLE_MODULE_UE_RETRY_COUNT; tryCount++ )
+        CellularError_t cellularStatus = CELLULAR_SUCCESS;
+        bool modemSwitched = false;
+
+        /* The modem can't be switched back if the comm interface can't follow it,
+         * so the comm interface is checked first. */
+        if( CELLULAR_BG96_COMM_SET_BAUD_RATE( baudRate ) != true )
         {
-            pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, *pAtReq, ENBABLE_MODULE_UE_RETRY_TIMEOUT );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            LogError( ( "setBaudRate: comm interface doesn't support %lu", ( unsigned long ) baudRate ) );
+            cellularStatus = CELLULAR_UNSUPPORTED;
+        }
+        else if( CELLULAR_BG96_COMM_SET_BAUD_RATE( CELLULAR_BG96_BOOT_BAUD_RATE ) != true )
+        {
+            LogError( ( "setBaudRate: comm interface can't restore %lu", ( unsigned long ) CELLULAR_BG96_BOOT_BAUD_RATE ) );
+            cellularStatus = CELLULAR_INTERNAL_FAILURE;
+        }
+        else
+        {
+            cellularStatus = sendBaudRate( pContext, baudRate );
+        }
 
-            if( cellularStatus == CELLULAR_SUCCESS )
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            modemSwitched = true;
+
+            if( CELLULAR_BG96_COMM_SET_BAUD_RATE( baudRate ) != true )
             {
-                break;
+                LogError( ( "setBaudRate: comm interface doesn't support %lu", ( unsigned long ) baudRate ) );
+                cellularStatus = CELLULAR_INTERNAL_FAILURE;
+            }
+            else
+            {
+                cellularStatus = verifyBaudRate( pContext );
+            }
+        }
+
+        if( ( cellularStatus != CELLULAR_SUCCESS ) && ( modemSwitched == true ) )
+        {
+            /* Switch the modem back at the baud rate it is expected to use now. If
+             * it doesn't respond, it may have kept the boot baud rate. */
+            LogWarn( ( "setBaudRate: %lu failed, restore %lu",
+                       ( unsigned long ) baudRate, ( unsigned long ) CELLULAR_BG96_BOOT_BAUD_RATE ) );
+
+            if( sendBaudRate( pContext, CELLULAR_BG96_BOOT_BAUD_RATE ) != CELLULAR_SUCCESS )
+            {
+                LogWarn( ( "setBaudRate: no response at %lu", ( unsigned long ) baudRate ) );
+            }
+
+            ( void ) CELLULAR_BG96_COMM_SET_BAUD_RATE( CELLULAR_BG96_BOOT_BAUD_RATE );
+
+            if( verifyBaudRate( pContext ) != CELLULAR_SUCCESS )
+            {
+                LogError( ( "setBaudRate: modem not responding after roll back" ) );
             }
         }
+
+        return cellularStatus;
     }
 
-    return cellularStatus;
-}
+#endif /* CELLULAR_BG96_BAUD_RATE. */
 
 /*-----------------------------------------------------------*/
 
@@ -124,12 +1300,58 @@ static bool appendRatList( char * pRatList,
 
 /*-----------------------------------------------------------*/
 
+static bool createDnsQueues( void )
+{
+    bool status = true;
+    uint32_t i = 0;
+
+    for( i = 0; i < CELLULAR_BG96_DNS_QUERY_SLOTS; i++ )
+    {
+        cellularBg96Context.dnsQueries[ i ].resultQueue = xQueueCreate( 1, sizeof( cellularDnsQueryResult_t ) );
+
+        if( cellularBg96Context.dnsQueries[ i ].resultQueue == NULL )
+        {
+            status = false;
+            break;
+        }
+    }
+
+    if( status == false )
+    {
+        deleteDnsQueues();
+    }
+
+    return status;
+}
+
+/*-----------------------------------------------------------*/
+
+static void deleteDnsQueues( void )
+{
+    uint32_t i = 0;
+
+    for( i = 0; i < CELLULAR_BG96_DNS_QUERY_SLOTS; i++ )
+    {
+        if( cellularBg96Context.dnsQueries[ i ].resultQueue != NULL )
+        {
+            vQueueDelete( cellularBg96Context.dnsQueries[ i ].resultQueue );
+            cellularBg96Context.dnsQueries[ i ].resultQueue = NULL;
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
 CellularError_t Cellular_ModuleInit( const CellularContext_t * pContext,
                                      void ** ppModuleContext )
 {
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     bool status = false;
 
+    #if ( CELLULAR_BG96_REQUEST_PRIORITY == 1 )
+        uint32_t socketId = 0;
+    #endif
+
     if( pContext == NULL )
     {
         cellularStatus = CELLULAR_INVALID_HANDLE;
@@ -142,6 +1364,27 @@ CellularError_t Cellular_ModuleInit( const CellularContext_t * pContext,
     {
         /* Initialize the module context. */
         ( void ) memset( &cellularBg96Context, 0, sizeof( cellularModuleContext_t ) );
+        cellularBg96Context.csqUrcMinIntervalMs = CELLULAR_BG96_CSQ_URC_MIN_INTERVAL_MS;
+        cellularBg96Context.csqUrcHysteresisDb = CELLULAR_BG96_CSQ_URC_HYSTERESIS_DB;
+        cellularBg96Context.bandMask.gsmBandMask = CELLULAR_BG96_GSM_BAND_MASK;
+        cellularBg96Context.bandMask.catm1BandMask = CELLULAR_BG96_CATM1_BAND_MASK;
+        cellularBg96Context.bandMask.nbiotBandMask = CELLULAR_BG96_NBIOT_BAND_MASK;
+
+        #if ( CELLULAR_BG96_BOOT_TIMING == 1 )
+            cellularBg96Context.bootTimingStartTick = xTaskGetTickCount();
+            cellularBg96Context.bootTiming.phaseMask = ( uint32_t ) 1U << ( uint32_t ) CELLULAR_BG96_BOOT_PHASE_MODULE_INIT;
+        #endif
+
+        #if ( CELLULAR_BG96_POWER_STATS == 1 )
+            cellularBg96Context.powerStateTick = xTaskGetTickCount();
+        #endif
+
+        #if ( CELLULAR_BG96_REQUEST_PRIORITY == 1 )
+            for( socketId = 0; socketId < CELLULAR_NUM_SOCKET_MAX; socketId++ )
+            {
+                cellularBg96Context.socketRequestClass[ socketId ] = CELLULAR_BG96_REQUEST_BULK;
+            }
+        #endif
 
         /* Create the mutex for DNS. */
         status = PlatformMutex_Create( &cellularBg96Context.contextMutex, false );
@@ -152,19 +1395,66 @@ CellularError_t Cellular_ModuleInit( const CellularContext_t * pContext,
         }
         else
         {
-            /* Create the queue for DNS. */
-            cellularBg96Context.pktDnsQueue = xQueueCreate( 1, sizeof( cellularDnsQueryResult_t ) );
+            /* Create the queues for DNS. */
+            status = createDnsQueues();
 
-            if( cellularBg96Context.pktDnsQueue == NULL )
+            if( status == false )
             {
                 PlatformMutex_Destroy( &cellularBg96Context.contextMutex );
                 cellularStatus = CELLULAR_NO_MEMORY;
             }
             else
             {
-                *ppModuleContext = ( void * ) &cellularBg96Context;
+                /* Create the mutex for the module state shared with the URC handlers. */
+                status = PlatformMutex_Create( &cellularBg96Context.stateMutex, false );
+
+                if( status == false )
+                {
+                    deleteDnsQueues();
+                    PlatformMutex_Destroy( &cellularBg96Context.contextMutex );
+                    cellularStatus = CELLULAR_NO_MEMORY;
+                }
+                else
+                {
+                    *ppModuleContext = ( void * ) &cellularBg96Context;
+                }
+            }
+        }
+
+        /* Create the mutex for the command buffer. */
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            status = PlatformMutex_Create( &cellularBg96Context.commandBufferMutex, false );
+
+            if( status == false )
+            {
+                PlatformMutex_Destroy( &cellularBg96Context.stateMutex );
+                deleteDnsQueues();
+                PlatformMutex_Destroy( &cellularBg96Context.contextMutex );
+                *ppModuleContext = NULL;
+                cellularStatus = CELLULAR_NO_MEMORY;
+            }
+        }
+
+        #if ( CELLULAR_BG96_REQUEST_PRIORITY == 1 )
+        {
+            /* Create the event of the AT channel request lane. */
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                cellularBg96Context.requestLaneEvent = PlatformEventGroup_Create();
+
+                if( cellularBg96Context.requestLaneEvent == NULL )
+                {
+                    PlatformMutex_Destroy( &cellularBg96Context.commandBufferMutex );
+                    PlatformMutex_Destroy( &cellularBg96Context.stateMutex );
+                    deleteDnsQueues();
+                    PlatformMutex_Destroy( &cellularBg96Context.contextMutex );
+                    *ppModuleContext = NULL;
+                    cellularStatus = CELLULAR_NO_MEMORY;
+                }
             }
         }
+        #endif /* CELLULAR_BG96_REQUEST_PRIORITY. */
 
         #if ( CELLULAR_BG96_SUPPPORT_DIRECT_PUSH_SOCKET == 1 )
         {
@@ -192,11 +1482,34 @@ CellularError_t Cellular_ModuleCleanUp( const CellularContext_t * pContext )
     }
     else
     {
-        /* Delete DNS queue. */
-        vQueueDelete( cellularBg96Context.pktDnsQueue );
+        /* Stop the restore, PSM scheduler, held back URC, DNS refresh and band
+         * scan threads before the mutexes are deleted. */
+        _Cellular_SessionRestoreCleanup( &cellularBg96Context );
+        _Cellular_PsmSchedulerCleanup( &cellularBg96Context );
+        _Cellular_SignalStrengthUrcCleanup( &cellularBg96Context );
+        _Cellular_DnsRefreshCleanup( &cellularBg96Context );
+        bandScanCleanup( &cellularBg96Context );
+
+        /* Delete DNS queues. */
+        deleteDnsQueues();
 
         /* Delete the mutex for DNS. */
         PlatformMutex_Destroy( &cellularBg96Context.contextMutex );
+
+        /* Delete the mutex for the module state. */
+        PlatformMutex_Destroy( &cellularBg96Context.stateMutex );
+
+        /* Delete the mutex for the command buffer. */
+        PlatformMutex_Destroy( &cellularBg96Context.commandBufferMutex );
+
+        #if ( CELLULAR_BG96_REQUEST_PRIORITY == 1 )
+            /* Delete the event of the AT channel request lane. */
+            if( cellularBg96Context.requestLaneEvent != NULL )
+            {
+                PlatformEventGroup_Delete( cellularBg96Context.requestLaneEvent );
+                cellularBg96Context.requestLaneEvent = NULL;
+            }
+        #endif
     }
 
     return cellularStatus;
@@ -204,6 +1517,32 @@ CellularError_t Cellular_ModuleCleanUp( const CellularContext_t * pContext )
 
 /*-----------------------------------------------------------*/
 
+/* The UART and URC port settings. They are lost when the modem reboots. */
+static uint8_t appendPortSettings( const char ** ppInitCmds,
+                                   uint8_t initCmdCount )
+{
+    uint8_t cmdCount = initCmdCount;
+
+    /* Disable DTR function. */
+    ppInitCmds[ cmdCount++ ] = "AT&D0";
+
+    #ifndef CELLULAR_CONFIG_DISABLE_FLOW_CONTROL
+        /* Enable RTS/CTS hardware flow control. */
+        ppInitCmds[ cmdCount++ ] = "AT+IFC=2,2";
+    #endif
+
+    /* Setting URC output port. */
+    #if defined( CELLULAR_BG96_URC_PORT_USBAT ) || defined( BG96_URC_PORT_USBAT )
+        ppInitCmds[ cmdCount++ ] = "AT+QURCCFG=\"urcport\",\"usbat\"";
+    #else
+        ppInitCmds[ cmdCount++ ] = "AT+QURCCFG=\"urcport\",\"uart1\"";
+    #endif
+
+    return cmdCount;
+}
+
+/*-----------------------------------------------------------*/
+
 CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
 {
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
@@ -225,88 +1564,140 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
         NULL,
         0
     };
-    char ratSelectCmd[ BG96_NWSCANSEQ_CMD_MAX_SIZE ] = "AT+QCFG=\"nwscanseq\",";
+    char ratSelectCmd[ BG96_NWSCANSEQ_CMD_MAX_SIZE ] = BG96_NWSCANSEQ_CMD_PREFIX;
+    char ratList[ BG96_NWSCANSEQ_CMD_MAX_SIZE ] = "";
     bool retAppendRat = true;
+    bg96BootConfig_t bootConfig = { 0 };
+    char bandCmd[ BG96_BAND_CMD_MAX_SIZE ] = "";
+    cellularAtBuilder_t bandCmdBuilder;
+    CellularBG96BandMask_t firstBandMask = { 0 };
+    cellularModuleContext_t * pModuleContext = NULL;
+    const char * initCmds[ BG96_ENABLE_UE_CMDS_MAX ] = { NULL };
+    uint8_t initCmdCount = 0;
+    uint8_t failedIndex = 0;
+
+    #if ( CELLULAR_BG96_BAUD_RATE > 0U )
+        bool atBaudRate = false;
+    #endif
 
     if( pContext != NULL )
     {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        #if ( CELLULAR_BG96_BAUD_RATE > 0U )
+            if( CELLULAR_BG96_BAUD_RATE != CELLULAR_BG96_BOOT_BAUD_RATE )
+            {
+                atBaudRate = probeBaudRate( pContext );
+            }
+        #endif
+
         /* Disable echo. */
         atReqGetWithResult.pAtCmd = "ATE0";
-        cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetWithResult );
-
-        if( cellularStatus == CELLULAR_SUCCESS )
-        {
-            /* Disable DTR function. */
-            atReqGetNoResult.pAtCmd = "AT&D0";
-            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
-        }
+        cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetWithResult, &retryPolicyStartup );
 
-        #ifndef CELLULAR_CONFIG_DISABLE_FLOW_CONTROL
+        #if ( CELLULAR_BG96_FAST_BOOT == 1 )
             if( cellularStatus == CELLULAR_SUCCESS )
             {
-                /* Enable RTS/CTS hardware flow control. */
-                atReqGetNoResult.pAtCmd = "AT+IFC=2,2";
-                cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
+                readBootConfig( pContext, &bootConfig );
             }
         #endif
 
         if( cellularStatus == CELLULAR_SUCCESS )
         {
-            /* Setting URC output port. */
-            #if defined( CELLULAR_BG96_URC_PORT_USBAT ) || defined( BG96_URC_PORT_USBAT )
-                atReqGetNoResult.pAtCmd = "AT+QURCCFG=\"urcport\",\"usbat\"";
-            #else
-                atReqGetNoResult.pAtCmd = "AT+QURCCFG=\"urcport\",\"uart1\"";
+            initCmdCount = appendPortSettings( initCmds, initCmdCount );
+
+            /* Configure the bands to scan. */
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            firstBandMask = pModuleContext->bandMask;
+
+            #if ( CELLULAR_BG96_BAND_SCAN_PLAN == 1 )
+                pModuleContext->bandScanNarrowed = applyScanPlan( &firstBandMask );
             #endif
-            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
-        }
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
 
-        if( cellularStatus == CELLULAR_SUCCESS )
-        {
-            /* Configure Band configuration to all bands. */
-            atReqGetNoResult.pAtCmd = "AT+QCFG=\"band\",f,400a0e189f,a0e189f";
-            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
-        }
+            _Cellular_AtBuilderInit( &bandCmdBuilder, bandCmd, BG96_BAND_CMD_MAX_SIZE );
+            _Cellular_AtBuilderAppendLiteral( &bandCmdBuilder, BG96_BAND_CMD_PREFIX );
+            _Cellular_FormatBandMask( &bandCmdBuilder, &firstBandMask );
+
+            /* The buffer is sized for the longest masks. */
+            ( void ) _Cellular_AtBuilderStatus( &bandCmdBuilder );
+
+            if( bootConfigApplied( &bootConfig, BG96_BOOT_CONFIG_BAND, &bandCmd[ strlen( BG96_BAND_CMD_PREFIX ) ] ) == false )
+            {
+                initCmds[ initCmdCount++ ] = bandCmd;
+            }
 
-        if( cellularStatus == CELLULAR_SUCCESS )
-        {
             /* Configure RAT(s) to be Searched to Automatic. */
-            atReqGetNoResult.pAtCmd = "AT+QCFG=\"nwscanmode\",0,1";
-            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
-        }
+            if( bootConfigApplied( &bootConfig, BG96_BOOT_CONFIG_NWSCANMODE, BG96_NWSCANMODE_CONFIG ) == false )
+            {
+                initCmds[ initCmdCount++ ] = "AT+QCFG=\"nwscanmode\"," BG96_NWSCANMODE_CONFIG ",1";
+            }
 
-        if( cellularStatus == CELLULAR_SUCCESS )
-        {
             /* Configure Network Category to be Searched under LTE RAT to LTE Cat M1 and Cat NB1. */
-            atReqGetNoResult.pAtCmd = "AT+QCFG=\"iotopmode\",2,1";
-            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
-        }
+            if( bootConfigApplied( &bootConfig, BG96_BOOT_CONFIG_IOTOPMODE, BG96_IOTOPMODE_CONFIG ) == false )
+            {
+                initCmds[ initCmdCount++ ] = "AT+QCFG=\"iotopmode\"," BG96_IOTOPMODE_CONFIG ",1";
+            }
 
-        if( cellularStatus == CELLULAR_SUCCESS )
-        {
-            retAppendRat = appendRatList( ratSelectCmd, CELLULAR_CONFIG_DEFAULT_RAT );
+            retAppendRat = appendRatList( ratList, CELLULAR_CONFIG_DEFAULT_RAT );
             configASSERT( retAppendRat == true );
 
             #ifdef CELLULAR_CONFIG_DEFAULT_RAT_2
-                retAppendRat = appendRatList( ratSelectCmd, CELLULAR_CONFIG_DEFAULT_RAT_2 );
+                retAppendRat = appendRatList( ratList, CELLULAR_CONFIG_DEFAULT_RAT_2 );
                 configASSERT( retAppendRat == true );
             #endif
 
             #ifdef CELLULAR_CONFIG_DEFAULT_RAT_3
-                retAppendRat = appendRatList( ratSelectCmd, CELLULAR_CONFIG_DEFAULT_RAT_3 );
+                retAppendRat = appendRatList( ratList, CELLULAR_CONFIG_DEFAULT_RAT_3 );
                 configASSERT( retAppendRat == true );
             #endif
 
-            strcat( ratSelectCmd, ",1" ); /* Take effect immediately. */
-            atReqGetNoResult.pAtCmd = ratSelectCmd;
-            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
+            if( bootConfigApplied( &bootConfig, BG96_BOOT_CONFIG_NWSCANSEQ, ratList ) == false )
+            {
+                strcat( ratSelectCmd, ratList );
+                strcat( ratSelectCmd, ",1" ); /* Take effect immediately. */
+                initCmds[ initCmdCount++ ] = ratSelectCmd;
+            }
+
+            cellularStatus = sendAtCommandBatch( pContext, initCmds, initCmdCount, &retryPolicySetting, true, &failedIndex );
+
+            if( cellularStatus != CELLULAR_SUCCESS )
+            {
+                LogError( ( "Cellular_ModuleEnableUE: %s failed", initCmds[ failedIndex ] ) );
+            }
         }
 
+        #if ( CELLULAR_BG96_BAUD_RATE > 0U )
+            /* Flow control is configured before switching to a higher baud rate. */
+            if( ( cellularStatus == CELLULAR_SUCCESS ) && ( CELLULAR_BG96_BAUD_RATE != CELLULAR_BG96_BOOT_BAUD_RATE ) &&
+                ( atBaudRate == false ) )
+            {
+                cellularStatus = setBaudRate( pContext, CELLULAR_BG96_BAUD_RATE );
+            }
+        #endif
+
         if( cellularStatus == CELLULAR_SUCCESS )
         {
+            _Cellular_BootTimingPhase( pModuleContext, CELLULAR_BG96_BOOT_PHASE_ENABLE_UE );
             atReqGetNoResult.pAtCmd = "AT+CFUN=1";
-            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult );
+            cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetNoResult, &retryPolicyCfun );
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            _Cellular_BootTimingPhase( pModuleContext, CELLULAR_BG96_BOOT_PHASE_CFUN );
         }
+
+        #if ( CELLULAR_BG96_BAND_SCAN_PLAN == 1 )
+            if( ( cellularStatus == CELLULAR_SUCCESS ) && ( pModuleContext->bandScanNarrowed == true ) &&
+                ( CELLULAR_BG96_BAND_SCAN_PLAN_TIMEOUT_MS > 0U ) )
+            {
+                startBandScanThread( pContext, pModuleContext );
+            }
+        #endif
     }
 
     return cellularStatus;
@@ -317,30 +1708,82 @@ CellularError_t Cellular_ModuleEnableUE( CellularContext_t * pContext )
 CellularError_t Cellular_ModuleEnableUrc( CellularContext_t * pContext )
 {
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularAtReq_t atReqGetNoResult =
+    uint8_t failedIndex = 0;
+    static const char * const urcCmds[ BG96_ENABLE_URC_CMDS_MAX ] =
     {
-        NULL,
-        CELLULAR_AT_NO_RESULT,
+        "AT+COPS=3,2",
+        "AT+CREG=2",
+        "AT+CGREG=2",
+        "AT+CEREG=2",
+        "AT+CTZR=1",
+        /* Enable SIM card insertion status report. */
+        "AT+QSIMSTAT=1"
+    };
+
+    /* The URC settings are best effort. A failing command doesn't stop the others. */
+    ( void ) sendAtCommandBatch( pContext, urcCmds, BG96_ENABLE_URC_CMDS_MAX, &retryPolicyUrc, false, &failedIndex );
+    _Cellular_BootTimingPhase( &cellularBg96Context, CELLULAR_BG96_BOOT_PHASE_ENABLE_URC );
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Send again the settings of Cellular_ModuleEnableUE and Cellular_ModuleEnableUrc
+ * after the modem rebooted by itself. The band, RAT and baud rate settings are
+ * saved by the modem and are not sent. */
+CellularError_t _Cellular_ModuleRestoreSettings( CellularContext_t * pContext )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    const char * initCmds[ BG96_ENABLE_UE_CMDS_MAX ] = { NULL };
+    uint8_t initCmdCount = 0;
+    uint8_t failedIndex = 0;
+    bool csqUrcEnabled = false;
+    CellularAtReq_t atReqGetWithResult =
+    {
+        "ATE0",
+        CELLULAR_AT_MULTI_WO_PREFIX,
         NULL,
         NULL,
         NULL,
         0
     };
 
-    atReqGetNoResult.pAtCmd = "AT+COPS=3,2";
-    ( void ) _Cellular_AtcmdRequestWithCallback( pContext, atReqGetNoResult );
+    cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Disable echo. */
+        cellularStatus = sendAtCommandWithRetryTimeout( pContext, &atReqGetWithResult, &retryPolicyStartup );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        initCmdCount = appendPortSettings( initCmds, initCmdCount );
+
+        /* The signal strength URC enabled by the application. */
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        csqUrcEnabled = pModuleContext->csqUrcEnabled;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
 
-    atReqGetNoResult.pAtCmd = "AT+CREG=2";
-    ( void ) _Cellular_AtcmdRequestWithCallback( pContext, atReqGetNoResult );
+        if( csqUrcEnabled == true )
+        {
+            initCmds[ initCmdCount++ ] = "AT+QINDCFG=\"csq\",1";
+        }
 
-    atReqGetNoResult.pAtCmd = "AT+CGREG=2";
-    ( void ) _Cellular_AtcmdRequestWithCallback( pContext, atReqGetNoResult );
+        cellularStatus = sendAtCommandBatch( pContext, initCmds, initCmdCount, &retryPolicySetting, true, &failedIndex );
 
-    atReqGetNoResult.pAtCmd = "AT+CEREG=2";
-    ( void ) _Cellular_AtcmdRequestWithCallback( pContext, atReqGetNoResult );
+        if( cellularStatus != CELLULAR_SUCCESS )
+        {
+            LogError( ( "_Cellular_ModuleRestoreSettings: %s failed", initCmds[ failedIndex ] ) );
+        }
+    }
 
-    atReqGetNoResult.pAtCmd = "AT+CTZR=1";
-    ( void ) _Cellular_AtcmdRequestWithCallback( pContext, atReqGetNoResult );
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = Cellular_ModuleEnableUrc( pContext );
+    }
 
     return cellularStatus;
 }
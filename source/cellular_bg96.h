@@ -57,6 +57,290 @@
     #define CELLULAR_BG96_DIRECT_PUSH_SOCKET_BUFFER_SIZE    ( 2048UL )
 #endif /* CELLULAR_BG96_DIRECT_PUSH_SOCKET_BUFFER_SIZE. */
 
+/* Read the NV stored configuration in Cellular_ModuleEnableUE and only write the
+ * settings which differ. Rewriting the band and scan settings may start a network rescan.
+ * The time from the boot to the registration is recorded with CELLULAR_BG96_BOOT_TIMING. */
+#ifndef CELLULAR_BG96_FAST_BOOT
+    #define CELLULAR_BG96_FAST_BOOT    0
+#endif
+
+/* Timeout of the first try of ATE0 and of the AT sent after a baud rate change.
+ * The timeout is doubled after every timed out try. It can't be shorter than the
+ * 300 ms maximum response time of these commands. The other initialization
+ * commands wait for their own maximum response time. */
+#ifndef CELLULAR_BG96_AT_RETRY_FIRST_TIMEOUT_MS
+    #define CELLULAR_BG96_AT_RETRY_FIRST_TIMEOUT_MS    ( 1000U )
+#endif
+
+/* Join consecutive extended AT commands of the initialization sequences into one
+ * "AT+A;+B;+C" command line. A failing command line is sent again one command at
+ * a time to find the failing command. */
+#ifndef CELLULAR_BG96_BATCH_AT_COMMANDS
+    #define CELLULAR_BG96_BATCH_AT_COMMANDS    0
+#endif
+
+/* Band mask bit of LTE band n in AT+QCFG="band". Bands 1 to 64 are supported. */
+#define CELLULAR_BG96_LTE_BAND( n )    ( 1ULL << ( ( uint64_t ) ( n ) - 1ULL ) )
+
+/* Band mask bits of the GSM bands in AT+QCFG="band". */
+#define CELLULAR_BG96_GSM_BAND_900     ( 0x1ULL )
+#define CELLULAR_BG96_GSM_BAND_1800    ( 0x2ULL )
+#define CELLULAR_BG96_GSM_BAND_850     ( 0x4ULL )
+#define CELLULAR_BG96_GSM_BAND_1900    ( 0x8ULL )
+
+/* Band masks written by Cellular_ModuleEnableUE. The default is all the bands
+ * supported by BG96. A band list is built with CELLULAR_BG96_LTE_BAND, for example
+ * ( CELLULAR_BG96_LTE_BAND( 2 ) | CELLULAR_BG96_LTE_BAND( 4 ) | CELLULAR_BG96_LTE_BAND( 12 ) ). */
+#ifndef CELLULAR_BG96_GSM_BAND_MASK
+    #define CELLULAR_BG96_GSM_BAND_MASK    ( 0xFULL )
+#endif
+
+#ifndef CELLULAR_BG96_CATM1_BAND_MASK
+    #define CELLULAR_BG96_CATM1_BAND_MASK    ( 0x400A0E189FULL )
+#endif
+
+#ifndef CELLULAR_BG96_NBIOT_BAND_MASK
+    #define CELLULAR_BG96_NBIOT_BAND_MASK    ( 0xA0E189FULL )
+#endif
+
+/* Start the network scan with the band set by Cellular_BG96SetScanPlan. The
+ * scan is widened to all the configured bands if the registration is denied or
+ * not done in CELLULAR_BG96_BAND_SCAN_PLAN_TIMEOUT_MS, or with
+ * Cellular_BG96WidenBandScan. */
+#ifndef CELLULAR_BG96_BAND_SCAN_PLAN
+    #define CELLULAR_BG96_BAND_SCAN_PLAN    0
+#endif
+
+/* Time from AT+CFUN=1 to register on the scan plan bands. 0 leaves the widening
+ * to the application. */
+#ifndef CELLULAR_BG96_BAND_SCAN_PLAN_TIMEOUT_MS
+    #define CELLULAR_BG96_BAND_SCAN_PLAN_TIMEOUT_MS    ( 60000UL )
+#endif
+
+/* The thread widening the band scan. */
+#ifndef CELLULAR_BG96_BAND_SCAN_THREAD_PRIORITY
+    #define CELLULAR_BG96_BAND_SCAN_THREAD_PRIORITY    PLATFORM_THREAD_DEFAULT_PRIORITY
+#endif
+
+#ifndef CELLULAR_BG96_BAND_SCAN_THREAD_STACK_SIZE
+    #define CELLULAR_BG96_BAND_SCAN_THREAD_STACK_SIZE    PLATFORM_THREAD_DEFAULT_STACK_SIZE
+#endif
+
+/* UART baud rate negotiated with AT+IPR in Cellular_ModuleEnableUE. 0 keeps the
+ * baud rate of the boot. The application defines CELLULAR_BG96_COMM_SET_BAUD_RATE( baudRate )
+ * to change the baud rate of its comm interface. It returns true on success.
+ * Cellular_Init fails if the link doesn't work at this baud rate. The modem and
+ * the comm interface are then switched back to CELLULAR_BG96_BOOT_BAUD_RATE.
+ * The baud rate is saved with AT&W, so the modem keeps it when it reboots alone
+ * after a PSM wake, a crash or AT+CFUN=1,1. Cellular_ModuleEnableUE tries the
+ * boot baud rate and then this baud rate, for a host reset while the modem runs. */
+#ifndef CELLULAR_BG96_BAUD_RATE
+    #define CELLULAR_BG96_BAUD_RATE    ( 0U )
+#endif
+
+/* Baud rate of the comm interface and the modem when Cellular_Init is called. */
+#ifndef CELLULAR_BG96_BOOT_BAUD_RATE
+    #define CELLULAR_BG96_BOOT_BAUD_RATE    ( 115200U )
+#endif
+
+#if ( CELLULAR_BG96_BAUD_RATE > 0U ) && !defined( CELLULAR_BG96_COMM_SET_BAUD_RATE )
+    #error "CELLULAR_BG96_COMM_SET_BAUD_RATE is required to change CELLULAR_BG96_BAUD_RATE."
+#endif
+
+/* Record the time of the boot phases and of the AT commands sent by
+ * Cellular_ModuleEnableUE and Cellular_ModuleEnableUrc. The record is read with
+ * Cellular_BG96GetBootTiming. */
+#ifndef CELLULAR_BG96_BOOT_TIMING
+    #define CELLULAR_BG96_BOOT_TIMING    0
+#endif
+
+/* Number of AT commands kept in the boot timing record. */
+#ifndef CELLULAR_BG96_BOOT_TIMING_COMMANDS_MAX
+    #define CELLULAR_BG96_BOOT_TIMING_COMMANDS_MAX    ( 16U )
+#endif
+
+/* Size of the AT command text kept in a boot timing record. Longer commands are truncated. */
+#ifndef CELLULAR_BG96_BOOT_TIMING_COMMAND_SIZE
+    #define CELLULAR_BG96_BOOT_TIMING_COMMAND_SIZE    ( 24U )
+#endif
+
+/* Size of the command buffer of the module context. The APIs sending long AT
+ * commands build them in this buffer instead of on the stack of the caller. It
+ * must hold CELLULAR_AT_CMD_MAX_SIZE and the 280 bytes of AT+QIDNSGIP. */
+#ifndef CELLULAR_BG96_COMMAND_BUFFER_SIZE
+    #define CELLULAR_BG96_COMMAND_BUFFER_SIZE    ( ( CELLULAR_AT_CMD_MAX_SIZE > 280U ) ? CELLULAR_AT_CMD_MAX_SIZE : 280U )
+#endif
+
+/* Order the AT requests of the port by request class. A request waiting for
+ * the AT channel is served before any waiting request of a lower class. */
+#ifndef CELLULAR_BG96_REQUEST_PRIORITY
+    #define CELLULAR_BG96_REQUEST_PRIORITY    0
+#endif
+
+/* Hold the payloads of Cellular_BG96PsmSend while the modem is in PSM and send
+ * them together when the modem wakes. The scheduler runs in its own thread,
+ * started by Cellular_BG96PsmSchedulerStart. */
+#ifndef CELLULAR_BG96_PSM_SCHEDULER
+    #define CELLULAR_BG96_PSM_SCHEDULER    0
+#endif
+
+/* Number of payloads the PSM scheduler can hold. */
+#ifndef CELLULAR_BG96_PSM_SCHEDULER_QUEUE_SIZE
+    #define CELLULAR_BG96_PSM_SCHEDULER_QUEUE_SIZE    ( 8U )
+#endif
+
+#ifndef CELLULAR_BG96_PSM_SCHEDULER_THREAD_PRIORITY
+    #define CELLULAR_BG96_PSM_SCHEDULER_THREAD_PRIORITY    PLATFORM_THREAD_DEFAULT_PRIORITY
+#endif
+
+#ifndef CELLULAR_BG96_PSM_SCHEDULER_THREAD_STACK_SIZE
+    #define CELLULAR_BG96_PSM_SCHEDULER_THREAD_STACK_SIZE    PLATFORM_THREAD_DEFAULT_STACK_SIZE
+#endif
+
+/* Track the time the modem spends awake, in PSM and powered down, and the
+ * wakeup latencies. The record is read with Cellular_BG96GetPowerStats. */
+#ifndef CELLULAR_BG96_POWER_STATS
+    #define CELLULAR_BG96_POWER_STATS    0
+#endif
+
+/* Record the PDN configs, the active PDNs and the connected sockets, and
+ * restore them when the modem reports "RDY" after PSM or a reboot. The restore
+ * runs in its own thread, started by Cellular_BG96SessionRestoreStart. */
+#ifndef CELLULAR_BG96_SESSION_RESTORE
+    #define CELLULAR_BG96_SESSION_RESTORE    0
+#endif
+
+/* Number of PDN contexts the session restore records. */
+#ifndef CELLULAR_BG96_SESSION_RESTORE_PDN_SLOTS
+    #define CELLULAR_BG96_SESSION_RESTORE_PDN_SLOTS    ( 2U )
+#endif
+
+/* Time from "RDY" the restore waits for the network registration and the
+ * socket connections. */
+#ifndef CELLULAR_BG96_SESSION_RESTORE_TIMEOUT_MS
+    #define CELLULAR_BG96_SESSION_RESTORE_TIMEOUT_MS    ( 60000UL )
+#endif
+
+/* Interval of the network registration queries of the restore. */
+#ifndef CELLULAR_BG96_SESSION_RESTORE_POLL_MS
+    #define CELLULAR_BG96_SESSION_RESTORE_POLL_MS    ( 500UL )
+#endif
+
+#ifndef CELLULAR_BG96_SESSION_RESTORE_THREAD_PRIORITY
+    #define CELLULAR_BG96_SESSION_RESTORE_THREAD_PRIORITY    PLATFORM_THREAD_DEFAULT_PRIORITY
+#endif
+
+#ifndef CELLULAR_BG96_SESSION_RESTORE_THREAD_STACK_SIZE
+    #define CELLULAR_BG96_SESSION_RESTORE_THREAD_STACK_SIZE    PLATFORM_THREAD_DEFAULT_STACK_SIZE
+#endif
+
+/* Suppress repeated "+QIURC: "recv"" data ready callbacks for a socket until
+ * the application reads from it with Cellular_SocketRecv. */
+#ifndef CELLULAR_BG96_COALESCE_DATA_READY_URC
+    #define CELLULAR_BG96_COALESCE_DATA_READY_URC    1
+#endif
+
+/* Serve Cellular_GetSimCardStatus and Cellular_GetSimCardInfo from the SIM
+ * card status and identity maintained by the QSIMSTAT and CPIN URCs. The
+ * "+QSIMSTAT" URC is only reported if the SIM card detection is enabled with
+ * AT+QSIMDET=1,<insert_level>, with the level of the SIM card detect pin of the
+ * board. The port doesn't send AT+QSIMDET, the setting is saved by the modem.
+ * Without it, a swapped SIM card is not detected until the modem reboots. */
+#ifndef CELLULAR_BG96_SIM_STATUS_CACHE
+    #define CELLULAR_BG96_SIM_STATUS_CACHE    0
+#endif
+
+/* Serve Cellular_GetPdnStatus and Cellular_GetIPAddress from the PDN status
+ * maintained by the PDN activation results and the "pdpdeact" URC. A PDN
+ * context activated or deactivated with Cellular_ATCommandRaw is not seen. */
+#ifndef CELLULAR_BG96_PDN_STATUS_CACHE
+    #define CELLULAR_BG96_PDN_STATUS_CACHE    1
+#endif
+
+/* Minimum interval between two signal strength changed callbacks. The latest
+ * signal strength URC held back by this interval is reported when the interval
+ * expires. 0 disables the rate limit. */
+#ifndef CELLULAR_BG96_CSQ_URC_MIN_INTERVAL_MS
+    #define CELLULAR_BG96_CSQ_URC_MIN_INTERVAL_MS    ( 0UL )
+#endif
+
+/* The thread reporting the held back signal strength URC. */
+#ifndef CELLULAR_BG96_CSQ_URC_THREAD_PRIORITY
+    #define CELLULAR_BG96_CSQ_URC_THREAD_PRIORITY    PLATFORM_THREAD_DEFAULT_PRIORITY
+#endif
+
+#ifndef CELLULAR_BG96_CSQ_URC_THREAD_STACK_SIZE
+    #define CELLULAR_BG96_CSQ_URC_THREAD_STACK_SIZE    PLATFORM_THREAD_DEFAULT_STACK_SIZE
+#endif
+
+/* Minimum RSSI change in dB for a signal strength URC to be reported to the
+ * application. 0 reports every URC. */
+#ifndef CELLULAR_BG96_CSQ_URC_HYSTERESIS_DB
+    #define CELLULAR_BG96_CSQ_URC_HYSTERESIS_DB    ( 0U )
+#endif
+
+/* Number of Cellular_GetHostByName queries that can wait for the modem at
+ * the same time. */
+#ifndef CELLULAR_BG96_DNS_QUERY_SLOTS
+    #define CELLULAR_BG96_DNS_QUERY_SLOTS    ( 4U )
+#endif
+
+/* Maximum number of addresses kept for a DNS query. The addresses reported by
+ * the modem beyond this number are dropped. */
+#ifndef CELLULAR_BG96_DNS_MAX_ADDRESSES
+    #define CELLULAR_BG96_DNS_MAX_ADDRESSES    ( 4U )
+#endif
+
+/* Number of host names kept in the DNS cache of Cellular_GetHostByName. The
+ * least recently used entry is replaced when the cache is full. 0 disables the cache. */
+#ifndef CELLULAR_BG96_DNS_CACHE_ENTRIES
+    #define CELLULAR_BG96_DNS_CACHE_ENTRIES    ( 4U )
+#endif
+
+/* Maximum length of a host name kept in the DNS cache. Longer host names are
+ * always resolved by the modem. */
+#ifndef CELLULAR_BG96_DNS_CACHE_HOSTNAME_MAX_SIZE
+    #define CELLULAR_BG96_DNS_CACHE_HOSTNAME_MAX_SIZE    ( 64U )
+#endif
+
+/* Upper bound of the TTL reported by the modem for a DNS cache entry. */
+#ifndef CELLULAR_BG96_DNS_CACHE_MAX_TTL_S
+    #define CELLULAR_BG96_DNS_CACHE_MAX_TTL_S    ( 3600UL )
+#endif
+
+/* Time a DNS failure reported by the modem is kept in the DNS cache. 0 disables
+ * the negative caching. */
+#ifndef CELLULAR_BG96_DNS_CACHE_NEGATIVE_TTL_MS
+    #define CELLULAR_BG96_DNS_CACHE_NEGATIVE_TTL_MS    ( 30000UL )
+#endif
+
+/* A host name found in the DNS cache this many times within
+ * CELLULAR_BG96_DNS_REFRESH_AHEAD_WINDOW_MS is resolved again in the background
+ * before its entry expires. 0 disables the refresh-ahead. */
+#ifndef CELLULAR_BG96_DNS_REFRESH_AHEAD_HITS
+    #define CELLULAR_BG96_DNS_REFRESH_AHEAD_HITS    ( 3U )
+#endif
+
+/* Window to count the DNS cache hits of a host name. */
+#ifndef CELLULAR_BG96_DNS_REFRESH_AHEAD_WINDOW_MS
+    #define CELLULAR_BG96_DNS_REFRESH_AHEAD_WINDOW_MS    ( 60000UL )
+#endif
+
+/* The refresh of a hot host name starts when its DNS cache entry expires in less
+ * than this time. */
+#ifndef CELLULAR_BG96_DNS_REFRESH_AHEAD_MS
+    #define CELLULAR_BG96_DNS_REFRESH_AHEAD_MS    ( 10000UL )
+#endif
+
+/* The thread sending the refresh of the hot host names. */
+#ifndef CELLULAR_BG96_DNS_REFRESH_THREAD_PRIORITY
+    #define CELLULAR_BG96_DNS_REFRESH_THREAD_PRIORITY    PLATFORM_THREAD_DEFAULT_PRIORITY
+#endif
+
+#ifndef CELLULAR_BG96_DNS_REFRESH_THREAD_STACK_SIZE
+    #define CELLULAR_BG96_DNS_REFRESH_THREAD_STACK_SIZE    PLATFORM_THREAD_DEFAULT_STACK_SIZE
+#endif
+
 /*-----------------------------------------------------------*/
 
 /**
@@ -70,24 +354,349 @@ typedef enum cellularDnsQueryResult
     CELLULAR_DNS_QUERY_UNKNOWN
 } cellularDnsQueryResult_t;
 
+/**
+ * @brief Addresses resolved by a DNS query.
+ */
+typedef struct cellularDnsAddressList
+{
+    uint8_t addressCount;                                                                  /* Number of addresses. */
+    char addresses[ CELLULAR_BG96_DNS_MAX_ADDRESSES ][ CELLULAR_IP_ADDRESS_MAX_SIZE + 1U ]; /* Resolved addresses in the order reported by the modem. */
+} cellularDnsAddressList_t;
+
+/**
+ * @brief DNS cache entry.
+ */
+typedef struct cellularDnsCacheEntry
+{
+    uint8_t contextId;                                              /* PDN context ID of the query. 0 if the entry is free. */
+    char hostName[ CELLULAR_BG96_DNS_CACHE_HOSTNAME_MAX_SIZE + 1U ]; /* Host name of the query. */
+    cellularDnsAddressList_t addressList;                           /* Resolved addresses. Empty for a negative entry. */
+    cellularDnsQueryResult_t result;                                /* Result of the query. */
+    TickType_t insertTick;                                          /* Tick count when the entry is stored. */
+    TickType_t ttlTicks;                                            /* Time to live of the entry. */
+    uint32_t lastUsed;                                              /* LRU stamp of the entry. */
+    uint16_t hitCount;                                              /* Cache hits in the current window. */
+    TickType_t hitWindowTick;                                       /* Tick count when the hit window starts. */
+    bool refreshPending;                                            /* Background refresh of the entry is queued or sent. */
+    bool refreshQueued;                                             /* Background refresh of the entry is to be sent by the refresh thread. */
+} cellularDnsCacheEntry_t;
+
+/**
+ * @brief Completion callback of Cellular_BG96GetHostByNameAsync.
+ *
+ * @param[in] requestId The request ID returned by Cellular_BG96GetHostByNameAsync.
+ * @param[in] dnsStatus CELLULAR_SUCCESS if the host name is resolved, CELLULAR_UNKNOWN
+ * if the modem reports a failure or CELLULAR_TIMEOUT if no result is received.
+ * @param[in] pAddresses The resolved addresses. NULL if dnsStatus is not CELLULAR_SUCCESS.
+ * @param[in] addressesNum The number of addresses in pAddresses.
+ * @param[in] pCallbackContext The pCallbackContext passed to Cellular_BG96GetHostByNameAsync.
+ */
+typedef void ( * CellularBG96DnsResultCallback_t )( uint32_t requestId,
+                                                   CellularError_t dnsStatus,
+                                                   const CellularIPAddress_t * pAddresses,
+                                                   uint8_t addressesNum,
+                                                   void * pCallbackContext );
+
+/**
+ * @brief DNS query slot state.
+ */
+typedef enum cellularDnsQueryState
+{
+    CELLULAR_DNS_QUERY_STATE_FREE,     /* The slot is not used. */
+    CELLULAR_DNS_QUERY_STATE_WAITING,  /* AT+QIDNSGIP is sent. Waiting for the URC results. */
+    CELLULAR_DNS_QUERY_STATE_ORPHANED, /* The query timed out. Its URC results are consumed and discarded, or the slot expires. */
+    CELLULAR_DNS_QUERY_STATE_DONE      /* The URC results are received. */
+} cellularDnsQueryState_t;
+
+/**
+ * @brief DNS query slot.
+ *
+ * The "+QIURC: "dnsgip"" URCs don't include the host name. The modem reports
+ * the results in the order of the AT+QIDNSGIP commands, so the URCs are
+ * matched to the waiting slot with the lowest sequence number. A query which
+ * times out keeps its slot until its results are received, otherwise they
+ * would be matched to the next query. The slot is freed if the results are
+ * not received within another DNS query timeout.
+ */
+typedef struct cellularDnsQuery
+{
+    cellularDnsQueryState_t state;                                   /* State of the slot. */
+    uint32_t sequence;                                               /* Order of the AT+QIDNSGIP command. */
+    QueueHandle_t resultQueue;                                       /* Queue to wake up the waiting task. */
+    cellularDnsQueryResult_t result;                                 /* DNS query result. */
+    uint8_t resultNumber;                                            /* Number of addresses reported by the modem. */
+    uint8_t resultIndex;                                             /* Number of addresses received. */
+    uint32_t ttl;                                                    /* TTL in seconds reported by the modem. */
+    cellularDnsAddressList_t addressList;                            /* Resolved addresses. */
+
+    /* Asynchronous query. The slot is freed by the URC handler. */
+    bool asyncQuery;                                                 /* The query is sent by Cellular_BG96GetHostByNameAsync. */
+    CellularBG96DnsResultCallback_t callback;                        /* Completion callback. NULL if the query is cancelled. */
+    void * pCallbackContext;                                         /* Context of the completion callback. */
+    TickType_t startTick;                                            /* Tick count when AT+QIDNSGIP is sent or when the query is orphaned. */
+    uint8_t contextId;                                               /* PDN context ID of the query. */
+    char hostName[ CELLULAR_BG96_DNS_CACHE_HOSTNAME_MAX_SIZE + 1U ]; /* Host name to store the result in the DNS cache. */
+    bool refreshQuery;                                               /* Refresh of a DNS cache entry. A failure keeps the cached addresses. */
+} cellularDnsQuery_t;
+
+/**
+ * @brief Band masks of AT+QCFG="band".
+ */
+typedef struct CellularBG96BandMask
+{
+    uint64_t gsmBandMask;   /* GSM bands. CELLULAR_BG96_GSM_BAND_XXX bits. */
+    uint64_t catm1BandMask; /* Cat M1 bands. CELLULAR_BG96_LTE_BAND bits. */
+    uint64_t nbiotBandMask; /* Cat NB1 bands. CELLULAR_BG96_LTE_BAND bits. */
+} CellularBG96BandMask_t;
+
+/**
+ * @brief Boot phases recorded in CellularBG96BootTiming_t.
+ */
+typedef enum CellularBG96BootPhase
+{
+    CELLULAR_BG96_BOOT_PHASE_MODULE_INIT,   /* Cellular_ModuleInit. Start of the record. */
+    CELLULAR_BG96_BOOT_PHASE_RDY,           /* "RDY" URC received. */
+    CELLULAR_BG96_BOOT_PHASE_ENABLE_UE,     /* Configuration of Cellular_ModuleEnableUE sent, before AT+CFUN=1. */
+    CELLULAR_BG96_BOOT_PHASE_CFUN,          /* AT+CFUN=1 completed. */
+    CELLULAR_BG96_BOOT_PHASE_ENABLE_URC,    /* Cellular_ModuleEnableUrc completed. */
+    CELLULAR_BG96_BOOT_PHASE_REGISTERED,    /* First registration URC with home or roaming status. */
+    CELLULAR_BG96_BOOT_PHASE_PDN_ACTIVATED, /* First successful Cellular_ActivatePdn. */
+    CELLULAR_BG96_BOOT_PHASE_MAX
+} CellularBG96BootPhase_t;
+
+/**
+ * @brief Timing of an AT command sent during boot.
+ */
+typedef struct CellularBG96BootCommandTiming
+{
+    char command[ CELLULAR_BG96_BOOT_TIMING_COMMAND_SIZE ]; /* AT command text, truncated. */
+    uint32_t startMs;                                       /* Start time since Cellular_ModuleInit. */
+    uint32_t durationMs;                                    /* Time spent in all the tries. */
+    uint8_t tryCount;                                       /* Number of tries. */
+    CellularError_t status;                                 /* Status of the last try. */
+} CellularBG96BootCommandTiming_t;
+
+/**
+ * @brief Boot timing record.
+ */
+typedef struct CellularBG96BootTiming
+{
+    uint32_t phaseMask;                                                         /* Bit ( 1 << phase ) is set if the phase is reached. */
+    uint32_t phaseMs[ CELLULAR_BG96_BOOT_PHASE_MAX ];                           /* Time of each phase since Cellular_ModuleInit. */
+    uint8_t commandCount;                                                       /* Number of AT commands in commands. */
+    uint8_t commandDropped;                                                     /* Number of AT commands not recorded, saturated at 255. */
+    CellularBG96BootCommandTiming_t commands[ CELLULAR_BG96_BOOT_TIMING_COMMANDS_MAX ]; /* AT commands in the order sent. */
+} CellularBG96BootTiming_t;
+
+/**
+ * @brief Request classes of the AT channel, from the highest priority.
+ */
+typedef enum CellularBG96RequestClass
+{
+    CELLULAR_BG96_REQUEST_HIGH,   /* Latency sensitive requests. Socket close. */
+    CELLULAR_BG96_REQUEST_NORMAL, /* Control requests. Socket connect and DNS queries. */
+    CELLULAR_BG96_REQUEST_BULK,   /* Socket data transfer. Default class of the sockets. */
+    CELLULAR_BG96_REQUEST_CLASS_MAX
+} CellularBG96RequestClass_t;
+
+/**
+ * @brief Statistics of a request class.
+ */
+typedef struct CellularBG96RequestStats
+{
+    uint32_t queueDepth;    /* Requests of the class waiting for the AT channel now. */
+    uint32_t maxQueueDepth; /* Highest queueDepth seen. */
+    uint32_t requestCount;  /* Requests of the class served. */
+    uint32_t totalWaitMs;   /* Total time the served requests waited for the AT channel. */
+    uint32_t maxWaitMs;     /* Longest time a request waited for the AT channel. */
+} CellularBG96RequestStats_t;
+
+/* Duration in seconds of a deactivated PSM timer. */
+#define CELLULAR_BG96_PSM_TIMER_DEACTIVATED    ( UINT32_MAX )
+
+/**
+ * @brief PSM timers of CellularPsmSettings_t, 3GPP TS 24.008.
+ */
+typedef enum CellularBG96PsmTimer
+{
+    CELLULAR_BG96_PSM_TIMER_PERIODIC_TAU, /* T3412 extended, periodicTauValue. GPRS Timer 3. */
+    CELLULAR_BG96_PSM_TIMER_ACTIVE_TIME,  /* T3324, activeTimeValue. GPRS Timer 2. */
+    CELLULAR_BG96_PSM_TIMER_PERIODIC_RAU, /* T3312 extended, periodicRauValue. GPRS Timer 3. */
+    CELLULAR_BG96_PSM_TIMER_GPRS_READY,   /* T3314, gprsReadyTimer. GPRS Timer. */
+    CELLULAR_BG96_PSM_TIMER_MAX
+} CellularBG96PsmTimer_t;
+
+/**
+ * @brief Rounding of a duration that the PSM timer can't encode exactly.
+ */
+typedef enum CellularBG96PsmRounding
+{
+    CELLULAR_BG96_PSM_ROUND_NEAREST, /* Closest encodable duration. */
+    CELLULAR_BG96_PSM_ROUND_UP,      /* Shortest encodable duration not below the request. */
+    CELLULAR_BG96_PSM_ROUND_DOWN,    /* Longest encodable duration not above the request. */
+    CELLULAR_BG96_PSM_ROUND_MAX
+} CellularBG96PsmRounding_t;
+
+/**
+ * @brief Power states of the modem, from the "PSM POWER DOWN", "POWERED DOWN" and "RDY" URCs.
+ */
+typedef enum CellularBG96PowerState
+{
+    CELLULAR_BG96_POWER_ACTIVE, /* Awake, from Cellular_Init or the last "RDY". */
+    CELLULAR_BG96_POWER_PSM,    /* In PSM, from "PSM POWER DOWN". */
+    CELLULAR_BG96_POWER_OFF,    /* Powered down, from "POWERED DOWN". */
+    CELLULAR_BG96_POWER_STATE_MAX
+} CellularBG96PowerState_t;
+
+/**
+ * @brief Latency statistics.
+ */
+typedef struct CellularBG96LatencyStats
+{
+    uint32_t count;   /* Number of samples. */
+    uint32_t lastMs;  /* Last sample. */
+    uint32_t maxMs;   /* Largest sample. */
+    uint32_t totalMs; /* Sum of the samples. */
+} CellularBG96LatencyStats_t;
+
+/**
+ * @brief Power state record.
+ */
+typedef struct CellularBG96PowerStats
+{
+    CellularBG96PowerState_t state;                    /* Current power state. */
+    uint32_t stateMs[ CELLULAR_BG96_POWER_STATE_MAX ]; /* Time spent in each state since Cellular_Init, including the current state. */
+    uint32_t psmEntryCount;                            /* Number of "PSM POWER DOWN" URCs. */
+    uint32_t wakeupCount;                              /* Number of "RDY" URCs after PSM. */
+    uint32_t wakeRequestCount;                         /* Number of wakeups requested by the application. */
+    CellularBG96LatencyStats_t wakeToRdy;              /* From the wake request to "RDY". */
+    CellularBG96LatencyStats_t wakeToSocket;           /* From the wake request, or "RDY" if not requested, to the first connected socket. */
+} CellularBG96PowerStats_t;
+
+/**
+ * @brief Completion callback of Cellular_BG96PsmSend.
+ *
+ * @param[in] socketHandle The socket passed to Cellular_BG96PsmSend.
+ * @param[in] pData The payload passed to Cellular_BG96PsmSend.
+ * @param[in] sentLength The number of bytes sent.
+ * @param[in] sendStatus CELLULAR_SUCCESS if the whole payload is sent, otherwise
+ * the error of the send or of the wake callback.
+ * @param[in] pCallbackContext The pCallbackContext passed to Cellular_BG96PsmSend.
+ */
+typedef void ( * CellularBG96PsmSendCallback_t )( CellularSocketHandle_t socketHandle,
+                                                  const uint8_t * pData,
+                                                  uint32_t sentLength,
+                                                  CellularError_t sendStatus,
+                                                  void * pCallbackContext );
+
+/**
+ * @brief Wake callback of the PSM scheduler.
+ *
+ * Called from the scheduler thread when a payload reaches its deadline while
+ * the modem is in PSM. The application wakes the modem with PSM_EINT or PWRKEY
+ * and connects the sockets again.
+ *
+ * @param[in] pWakeContext The pWakeContext passed to Cellular_BG96PsmSchedulerStart.
+ *
+ * @return CELLULAR_SUCCESS if the sockets can be used, otherwise the error
+ * reported to the due payloads.
+ */
+typedef CellularError_t ( * CellularBG96PsmWakeCallback_t )( void * pWakeContext );
+
+/**
+ * @brief Payload held by the PSM scheduler.
+ */
+typedef struct cellularPsmTxEntry
+{
+    bool inUse;                             /* The entry holds a payload. */
+    CellularSocketHandle_t socketHandle;    /* Socket to send the payload. */
+    const uint8_t * pData;                  /* Payload, owned by the application until the callback. */
+    uint32_t dataLength;                    /* Length of the payload. */
+    TickType_t queueTick;                   /* Tick count when the payload is queued. */
+    TickType_t deadlineTicks;               /* The payload is due deadlineTicks after queueTick. */
+    CellularBG96PsmSendCallback_t callback; /* Completion callback. */
+    void * pCallbackContext;                /* Context of the completion callback. */
+} cellularPsmTxEntry_t;
+
+/**
+ * @brief Result of a session restore.
+ */
+typedef struct CellularBG96SessionRestoreResult
+{
+    CellularError_t status; /* CELLULAR_SUCCESS if the PDNs and the sockets are restored, otherwise the first error. */
+    uint8_t pdnRestored;    /* PDN contexts activated again. */
+    uint8_t pdnFailed;      /* PDN contexts that couldn't be activated. */
+    uint8_t socketRestored; /* Sockets connected again. */
+    uint8_t socketFailed;   /* Sockets that couldn't be connected. */
+    uint32_t elapsedMs;     /* Time from "RDY" to the end of the restore. */
+} CellularBG96SessionRestoreResult_t;
+
+/**
+ * @brief Completion callback of the session restore.
+ *
+ * Called from the restore thread when the restore started by "RDY" ends. The
+ * sockets also report the connection with their open callbacks. The sockets
+ * held by the restore are released before it is called.
+ *
+ * @param[in] pResult The result of the restore.
+ * @param[in] pCallbackContext The pCallbackContext passed to Cellular_BG96SessionRestoreStart.
+ */
+typedef void ( * CellularBG96SessionRestoreCallback_t )( const CellularBG96SessionRestoreResult_t * pResult,
+                                                         void * pCallbackContext );
+
+/**
+ * @brief PDN context recorded by the session restore.
+ */
+typedef struct cellularSessionPdn
+{
+    uint8_t contextId;             /* PDN context ID. 0 if the slot is free. */
+    bool configValid;              /* pdnConfig is set with Cellular_SetPdnConfig. */
+    bool active;                   /* Activated with Cellular_ActivatePdn and not deactivated. */
+    CellularPdnConfig_t pdnConfig; /* Last PDN config set. */
+} cellularSessionPdn_t;
+
+/**
+ * @brief AT command builder. The buffer is always terminated. Once an append
+ * fails the status is kept and the following appends are ignored.
+ */
+typedef struct cellularAtBuilder
+{
+    char * pBuf;            /* Command buffer. */
+    uint32_t bufSize;       /* Size of pBuf including the terminator. */
+    uint32_t length;        /* Length of the command built so far. */
+    CellularError_t status; /* CELLULAR_NO_MEMORY on overflow, CELLULAR_BAD_PARAMETER on invalid input. */
+} cellularAtBuilder_t;
+
 typedef struct cellularModuleContext cellularModuleContext_t;
 
 /**
  * @brief DNS query URC callback fucntion.
  */
 typedef void ( * CellularDnsResultEventCallback_t )( cellularModuleContext_t * pModuleContext,
-                                                     char * pDnsResult,
-                                                     char * pDnsUsrData );
+                                                     char * pDnsResult );
 
 typedef struct cellularModuleContext
 {
     PlatformMutex_t contextMutex; /* Mutex for module context. */
+    PlatformMutex_t stateMutex;   /* Mutex for the module state shared with the URC handlers. Not held across AT commands. */
 
-    /* DNS related variables. */
-    QueueHandle_t pktDnsQueue; /* DNS queue to receive the DNS query result. */
-    uint8_t dnsResultNumber;   /* DNS query result number. */
-    uint8_t dnsIndex;          /* DNS query current index. */
-    char * pDnsUsrData;        /* DNS user data to store the result. */
+    /* Command buffer. Protected by commandBufferMutex, held from the building of the command to its response. */
+    PlatformMutex_t commandBufferMutex;
+    char commandBuffer[ CELLULAR_BG96_COMMAND_BUFFER_SIZE ];
+
+    /* DNS related variables. Protected by stateMutex. */
+    cellularDnsQuery_t dnsQueries[ CELLULAR_BG96_DNS_QUERY_SLOTS ]; /* DNS queries sent to the modem. */
+    uint32_t dnsQuerySequence;                                      /* Sequence number of the last DNS query. */
+    bool dnsHeaderLost;                                             /* The addresses are discarded until the next header. */
+
+    #if ( CELLULAR_BG96_DNS_CACHE_ENTRIES > 0U )
+        /* DNS cache. Protected by stateMutex. */
+        cellularDnsCacheEntry_t dnsCache[ CELLULAR_BG96_DNS_CACHE_ENTRIES ];
+        uint32_t dnsCacheUseCount;                  /* LRU stamp given to the last used entry. */
+        CellularHandle_t dnsRefreshCellularHandle;  /* Handle used to send the refresh queries. */
+        bool dnsRefreshThreadStarted;               /* The refresh thread is running. */
+        PlatformEventGroupHandle_t dnsRefreshEvent; /* Wakes up and stops the refresh thread. */
+    #endif /* CELLULAR_BG96_DNS_CACHE_ENTRIES. */
 
     #if ( CELLULAR_BG96_SUPPPORT_DIRECT_PUSH_SOCKET == 1 )
         uint8_t pSocketBuffer[ CELLULAR_NUM_SOCKET_MAX ][ CELLULAR_BG96_DIRECT_PUSH_SOCKET_BUFFER_SIZE ];
@@ -95,6 +704,103 @@ typedef struct cellularModuleContext
     #endif /* CELLULAR_BG96_SUPPPORT_DIRECT_PUSH_SOCKET. */
 
     CellularDnsResultEventCallback_t dnsEventCallback;
+
+    /* Socket data ready notification coalescing. Protected by stateMutex. */
+    bool dataReadyPending[ CELLULAR_NUM_SOCKET_MAX ];             /* Data ready callback delivered, socket not read yet. */
+    uint32_t dataReadySuppressedCount[ CELLULAR_NUM_SOCKET_MAX ]; /* Data ready URCs suppressed while pending. */
+
+    /* Signal strength URC filter. Protected by stateMutex. */
+    uint32_t csqUrcMinIntervalMs;           /* Minimum interval between two reported signal strength URCs. */
+    uint16_t csqUrcHysteresisDb;            /* Minimum RSSI change to report a signal strength URC. */
+    bool csqUrcEnabled;                     /* The signal strength URC is enabled. Enabled again after a reboot. */
+    bool csqUrcReported;                    /* A signal strength URC has been reported since enabled. */
+    int16_t csqUrcLastRssi;                 /* RSSI of the last reported signal strength URC. */
+    TickType_t csqUrcLastTick;              /* Tick count of the last reported signal strength URC. */
+    bool csqUrcPending;                     /* A URC held back by the interval is to be reported. */
+    int16_t csqUrcPendingRssi;              /* RSSI of the held back URC. */
+    int16_t csqUrcPendingBer;               /* BER of the held back URC. */
+    CellularHandle_t csqUrcCellularHandle;  /* Handle used to report the held back URC. */
+    bool csqUrcThreadStarted;               /* The held back URC thread is running. */
+    PlatformEventGroupHandle_t csqUrcEvent; /* Wakes up and stops the held back URC thread. */
+
+    /* Signal information snapshot. Protected by stateMutex. */
+    CellularSignalInfo_t signalInfo; /* Last signal information from AT+QCSQ, refreshed by signal strength URCs. */
+    CellularRat_t signalRat;         /* RAT used to compute the signal bars. */
+    TickType_t signalInfoTick;       /* Tick count of the last RSSI and BER update, from AT+QCSQ or URCs. */
+    TickType_t signalLteTick;        /* Tick count of the last RSRP, RSRQ and SINR update, from AT+QCSQ only. */
+    bool signalInfoValid;            /* The signal information snapshot is valid. */
+
+    /* SIM card status. Protected by stateMutex. */
+    CellularSimCardStatus_t simCardStatus; /* SIM insertion and lock state from queries and URCs. */
+    bool simCardStateValid;                /* simCardStatus.simCardState is up to date. */
+    bool simCardLockStateValid;            /* simCardStatus.simCardLockState is up to date. */
+
+    /* SIM card identity. Protected by stateMutex. */
+    CellularSimCardInfo_t simCardInfo; /* IMSI, ICCID and HPLMN read from the SIM card. */
+    bool simCardInfoValid;             /* simCardInfo is read from the current SIM card. */
+    uint32_t simCardGeneration;        /* Incremented when the SIM card or its status may have been changed. */
+
+    /* PDN status. Protected by stateMutex. */
+    CellularPdnStatus_t pdnStatus[ CELLULAR_PDN_CONTEXT_ID_MAX ]; /* Indexed by context ID. contextId is 0 if not activated. */
+    bool pdnStatusValid;                                          /* pdnStatus is up to date. */
+    uint32_t pdnStatusGeneration;                                 /* Incremented when a PDN context may have been changed. */
+
+    /* Band configuration. */
+    CellularBG96BandMask_t bandMask; /* Band masks to scan. Protected by stateMutex. */
+    bool bandScanNarrowed;           /* The modem scans the scan plan bands only. Protected by stateMutex. */
+
+    #if ( CELLULAR_BG96_BAND_SCAN_PLAN == 1 )
+        PlatformEventGroupHandle_t bandScanEvent; /* Wakes up and stops the band scan thread. Protected by stateMutex. */
+    #endif /* CELLULAR_BG96_BAND_SCAN_PLAN. */
+
+    #if ( CELLULAR_BG96_BOOT_TIMING == 1 )
+        /* Boot timing record. Protected by stateMutex. */
+        CellularBG96BootTiming_t bootTiming;
+        TickType_t bootTimingStartTick; /* Tick count of Cellular_ModuleInit. */
+    #endif /* CELLULAR_BG96_BOOT_TIMING. */
+
+    #if ( CELLULAR_BG96_REQUEST_PRIORITY == 1 )
+        /* AT channel request lane. Protected by stateMutex. */
+        PlatformEventGroupHandle_t requestLaneEvent;                                /* Signaled when the lane is released. */
+        bool requestLaneBusy;                                                       /* A request holds the AT channel. */
+        CellularBG96RequestStats_t requestStats[ CELLULAR_BG96_REQUEST_CLASS_MAX ]; /* Statistics of each request class. */
+        CellularBG96RequestClass_t socketRequestClass[ CELLULAR_NUM_SOCKET_MAX ];   /* Request class of the data transfer of each socket. */
+    #endif /* CELLULAR_BG96_REQUEST_PRIORITY. */
+
+    #if ( CELLULAR_BG96_POWER_STATS == 1 )
+        /* Power state record. Protected by stateMutex. */
+        CellularBG96PowerStats_t powerStats;
+        TickType_t powerStateTick;  /* Tick count when the current state is entered. */
+        TickType_t wakeRequestTick; /* Tick count of the pending wake request. */
+        TickType_t wakeStartTick;   /* Start of the pending wake to socket measurement. */
+        bool wakeRequestPending;    /* A wake request waits for "RDY". */
+        bool wakeSocketPending;     /* A wakeup waits for the first connected socket. */
+    #endif /* CELLULAR_BG96_POWER_STATS. */
+
+    #if ( CELLULAR_BG96_PSM_SCHEDULER == 1 )
+        /* PSM transmit scheduler. Protected by stateMutex. */
+        PlatformEventGroupHandle_t psmSchedulerEvent;                              /* Wakes up the scheduler thread. */
+        bool psmSchedulerStarted;                                                  /* The scheduler thread is running. */
+        bool psmWindowOpen;                                                        /* The modem is awake and the sockets can be used. */
+        TickType_t psmLastActivityTick;                                            /* Tick count of the window opening or of the last payload sent. */
+        uint32_t psmActiveTimeMs;                                                  /* Active time T3324. 0 if PSM is disabled. */
+        CellularHandle_t psmCellularHandle;                                        /* Handle to send the payloads. */
+        CellularBG96PsmWakeCallback_t psmWakeCallback;                             /* Wakes the modem for a due payload. */
+        void * pPsmWakeContext;                                                    /* Context of the wake callback. */
+        cellularPsmTxEntry_t psmTxQueue[ CELLULAR_BG96_PSM_SCHEDULER_QUEUE_SIZE ]; /* Payloads waiting for the active window. */
+    #endif /* CELLULAR_BG96_PSM_SCHEDULER. */
+
+    #if ( CELLULAR_BG96_SESSION_RESTORE == 1 )
+        /* Session restore. Protected by stateMutex. */
+        cellularSessionPdn_t sessionPdn[ CELLULAR_BG96_SESSION_RESTORE_PDN_SLOTS ]; /* PDN contexts to restore. */
+        PlatformEventGroupHandle_t sessionEvent;                                    /* Wakes up the restore thread. */
+        bool sessionRestoreStarted;                                                 /* The restore thread is running. */
+        TickType_t sessionRdyTick;                                                  /* Tick count of the last "RDY". */
+        CellularHandle_t sessionCellularHandle;                                     /* Handle to restore the session. */
+        CellularBG96SessionRestoreCallback_t sessionRestoreCallback;                /* Reports the end of a restore. */
+        void * pSessionRestoreContext;                                              /* Context of the restore callback. */
+        bool sessionSocketRestoring[ CELLULAR_NUM_SOCKET_MAX ];                     /* The restore holds the socket. */
+    #endif /* CELLULAR_BG96_SESSION_RESTORE. */
 } cellularModuleContext_t;
 
 /*-----------------------------------------------------------*/
@@ -102,6 +808,120 @@ typedef struct cellularModuleContext
 CellularPktStatus_t _Cellular_ParseSimstat( char * pInputStr,
                                             CellularSimCardState_t * pSimState );
 
+CellularSimCardLockState_t _Cellular_ParseSimLockState( const char * pToken );
+
+void _Cellular_DnsCacheFlush( cellularModuleContext_t * pModuleContext,
+                              uint8_t contextId );
+
+void _Cellular_DnsQueryAbort( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_DnsRefreshCleanup( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_PdnStatusInvalidate( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_PdnStatusDeactivated( cellularModuleContext_t * pModuleContext,
+                                     uint8_t contextId );
+
+void _Cellular_FormatBandMask( cellularAtBuilder_t * pCmdBuilder,
+                               const CellularBG96BandMask_t * pBandMask );
+
+CellularError_t _Cellular_WidenBandScan( CellularContext_t * pContext,
+                                         cellularModuleContext_t * pModuleContext );
+
+void _Cellular_BandScanRegistration( cellularModuleContext_t * pModuleContext,
+                                     int32_t regStatus );
+
+void _Cellular_BootTimingPhase( cellularModuleContext_t * pModuleContext,
+                                CellularBG96BootPhase_t bootPhase );
+
+void _Cellular_BootTimingCommand( cellularModuleContext_t * pModuleContext,
+                                  const char * pAtCmd,
+                                  TickType_t startTick,
+                                  uint8_t tryCount,
+                                  CellularError_t cellularStatus );
+
+void _Cellular_AtBuilderInit( cellularAtBuilder_t * pBuilder,
+                              char * pBuf,
+                              uint32_t bufSize );
+
+void _Cellular_AtBuilderAppendLiteral( cellularAtBuilder_t * pBuilder,
+                                       const char * pLiteral );
+
+void _Cellular_AtBuilderAppendUnsigned( cellularAtBuilder_t * pBuilder,
+                                        uint32_t value );
+
+void _Cellular_AtBuilderAppendSigned( cellularAtBuilder_t * pBuilder,
+                                      int32_t value );
+
+void _Cellular_AtBuilderAppendHex( cellularAtBuilder_t * pBuilder,
+                                   uint64_t value );
+
+void _Cellular_AtBuilderAppendQuoted( cellularAtBuilder_t * pBuilder,
+                                      const char * pString );
+
+CellularError_t _Cellular_AtBuilderStatus( const cellularAtBuilder_t * pBuilder );
+
+char * _Cellular_CommandBufferAcquire( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_CommandBufferRelease( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_RequestLaneAcquire( cellularModuleContext_t * pModuleContext,
+                                  CellularBG96RequestClass_t requestClass );
+
+void _Cellular_RequestLaneRelease( cellularModuleContext_t * pModuleContext );
+
+CellularBG96RequestClass_t _Cellular_SocketRequestClass( cellularModuleContext_t * pModuleContext,
+                                                         uint32_t socketId );
+
+void _Cellular_PsmWindowClose( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_PowerStateChange( cellularModuleContext_t * pModuleContext,
+                                 CellularBG96PowerState_t powerState );
+
+void _Cellular_PowerWakeRequested( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_PowerSocketConnected( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_PsmSchedulerCleanup( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_SignalStrengthUrcCleanup( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_SessionPdnConfigured( cellularModuleContext_t * pModuleContext,
+                                     uint8_t contextId,
+                                     const CellularPdnConfig_t * pPdnConfig );
+
+void _Cellular_SessionPdnActive( cellularModuleContext_t * pModuleContext,
+                                 uint8_t contextId,
+                                 bool active );
+
+void _Cellular_SessionModemReady( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_SessionSocketOpened( cellularModuleContext_t * pModuleContext );
+
+void _Cellular_SessionRestoreCleanup( cellularModuleContext_t * pModuleContext );
+
+bool _Cellular_SessionSocketRestoring( cellularModuleContext_t * pModuleContext,
+                                       uint32_t socketId );
+
+CellularError_t _Cellular_ModuleRestoreSettings( CellularContext_t * pContext );
+
+CellularError_t _Cellular_SocketConnect( CellularHandle_t cellularHandle,
+                                         CellularSocketHandle_t socketHandle,
+                                         CellularSocketAccessMode_t dataAccessMode,
+                                         const CellularSocketAddress_t * pRemoteSocketAddress );
+
+CellularError_t _Cellular_CmuxSocketSend( const char * pAtCmd,
+                                          const uint8_t * pData,
+                                          uint32_t dataLength,
+                                          uint32_t * pSentDataLength,
+                                          uint32_t timeoutMs );
+
+CellularError_t _Cellular_CmuxSocketRecv( const char * pAtCmd,
+                                          uint8_t * pBuffer,
+                                          uint32_t bufferLength,
+                                          uint32_t * pReceivedDataLength,
+                                          uint32_t timeoutMs );
+
 CellularPktStatus_t Cellular_BG96InputBufferCallback( void * pInputBufferCallbackContext,
                                                       char * pBuffer,
                                                       uint32_t bufferLength,
@@ -109,6 +929,524 @@ CellularPktStatus_t Cellular_BG96InputBufferCallback( void * pInputBufferCallbac
 
 /*-----------------------------------------------------------*/
 
+/**
+ * @brief Get the number of data ready URCs suppressed for a socket.
+ *
+ * In buffer access mode, repeated "+QIURC: "recv"" URCs received before the
+ * application calls Cellular_SocketRecv are not forwarded to the data ready
+ * callback. The count is reset when the socket is connected.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] socketHandle Socket handle returned from the Cellular_CreateSocket call.
+ * @param[out] pSuppressedCount The number of suppressed data ready URCs.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96GetDataReadySuppressedCount( CellularHandle_t cellularHandle,
+                                                           CellularSocketHandle_t socketHandle,
+                                                           uint32_t * pSuppressedCount );
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Configure the filter applied to "+QIND: "csq"" signal strength URCs.
+ *
+ * The signal strength changed callback is called only if the RSSI changed by at
+ * least hysteresisDb since the last reported URC. A change received within
+ * minIntervalMs of the last reported URC is held back, and the latest one is
+ * reported when the interval expires. Changes between valid and invalid RSSI
+ * are always reported.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] minIntervalMs Minimum interval between two callbacks. 0 disables the rate limit.
+ * @param[in] hysteresisDb Minimum RSSI change in dB. 0 disables the hysteresis.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96SetSignalStrengthUrcFilter( CellularHandle_t cellularHandle,
+                                                         uint32_t minIntervalMs,
+                                                         uint16_t hysteresisDb );
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the signal information, served from the module snapshot if it is
+ * not older than maxAgeMs.
+ *
+ * The snapshot is updated by every AT+QCSQ query and refreshed by "+QIND: "csq""
+ * URCs. The URCs update RSSI and BER only, the LTE fields come from the last
+ * AT+QCSQ query. On an LTE RAT the age of the snapshot is the age of the LTE
+ * fields. If the snapshot is too old, Cellular_GetSignalInfo is called.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[out] pSignalInfo Out parameter to provide the signal information.
+ * @param[in] maxAgeMs Maximum age of the snapshot. 0 always queries the modem.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96GetSignalInfoCached( CellularHandle_t cellularHandle,
+                                                  CellularSignalInfo_t * pSignalInfo,
+                                                  uint32_t maxAgeMs );
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the SIM card IMSI, ICCID and HPLMN.
+ *
+ * The SIM card identity is read once with AT+CIMI, AT+CRSM and AT+QCCID and
+ * kept in the module context. It is read again after a "+QSIMSTAT" URC or a
+ * modem reset, or if forceRefresh is true. The "+QSIMSTAT" URC requires the
+ * SIM card detection, see CELLULAR_BG96_SIM_STATUS_CACHE.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[out] pSimCardInfo Out parameter to provide the SIM card information.
+ * @param[in] forceRefresh Read the SIM card identity from the modem.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96GetSimCardInfo( CellularHandle_t cellularHandle,
+                                             CellularSimCardInfo_t * pSimCardInfo,
+                                             bool forceRefresh );
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get all the IP addresses of a host name.
+ *
+ * The addresses are returned in the order reported by the modem, so the
+ * application can try the next address if a connection fails. At most
+ * CELLULAR_BG96_DNS_MAX_ADDRESSES addresses are kept for a query. The DNS
+ * cache is shared with Cellular_GetHostByName.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] contextId Context ID of the PDN context for which DNS query is sent.
+ * @param[in] pcHostName The host name to resolve.
+ * @param[out] pResolvedAddresses Out parameter to provide the resolved addresses.
+ * @param[in] addressesLength The number of entries in pResolvedAddresses.
+ * @param[out] pAddressesNum The number of addresses returned.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96GetHostByNameAll( CellularHandle_t cellularHandle,
+                                               uint8_t contextId,
+                                               const char * pcHostName,
+                                               CellularIPAddress_t * pResolvedAddresses,
+                                               uint8_t addressesLength,
+                                               uint8_t * pAddressesNum );
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Resolve a host name without blocking the calling task.
+ *
+ * The callback is called from the URC handler when the modem reports the
+ * result. It must not call APIs that send AT commands. If the result is in the
+ * DNS cache, the callback is called before this function returns and the
+ * request ID is 0. A request that doesn't complete in DNS_QUERY_TIMEOUT_MS is
+ * reported with CELLULAR_TIMEOUT when the next DNS query or result is handled.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] contextId Context ID of the PDN context for which DNS query is sent.
+ * @param[in] pcHostName The host name to resolve.
+ * @param[in] dnsResultCallback The callback to report the result.
+ * @param[in] pCallbackContext The context passed to the callback.
+ * @param[out] pRequestId The request ID to cancel the request.
+ *
+ * @return CELLULAR_SUCCESS if the request is sent or served from the DNS cache,
+ * otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96GetHostByNameAsync( CellularHandle_t cellularHandle,
+                                                 uint8_t contextId,
+                                                 const char * pcHostName,
+                                                 CellularBG96DnsResultCallback_t dnsResultCallback,
+                                                 void * pCallbackContext,
+                                                 uint32_t * pRequestId );
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Cancel a request of Cellular_BG96GetHostByNameAsync.
+ *
+ * The callback of a cancelled request is not called. The query slot is freed
+ * when the modem reports the result.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] requestId The request ID returned by Cellular_BG96GetHostByNameAsync.
+ *
+ * @return CELLULAR_SUCCESS if the request is cancelled, CELLULAR_BAD_PARAMETER
+ * if the request is completed or unknown.
+ */
+CellularError_t Cellular_BG96CancelHostByName( CellularHandle_t cellularHandle,
+                                               uint32_t requestId );
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Set the bands scanned by the modem.
+ *
+ * The band masks are written with AT+QCFG="band" and used until the next
+ * Cellular_Init, which writes the CELLULAR_BG96_XXX_BAND_MASK configuration.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] pBandMask The band masks of each RAT.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96SetBandMask( CellularHandle_t cellularHandle,
+                                          const CellularBG96BandMask_t * pBandMask );
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the band of the serving cell.
+ *
+ * The band reported by AT+QNWINFO is returned as a band mask with a single bit
+ * set for the RAT of the serving cell. The application keeps it to start the next
+ * network scan with Cellular_BG96SetScanPlan.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[out] pCampedBandMask The band of the serving cell.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_UNKNOWN if
+ * the modem has no serving cell, otherwise an error code indicating the cause
+ * of the error.
+ */
+CellularError_t Cellular_BG96GetCampedBand( CellularHandle_t cellularHandle,
+                                            CellularBG96BandMask_t * pCampedBandMask );
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Set the bands scanned first by Cellular_Init.
+ *
+ * This function is called before Cellular_Init. With CELLULAR_BG96_BAND_SCAN_PLAN
+ * enabled, Cellular_ModuleEnableUE writes the bands of the scan plan which are
+ * in the configured band masks. A RAT without such a band scans all its
+ * configured bands.
+ *
+ * @param[in] pFirstBandMask The bands to scan first, usually the last camped
+ * band from Cellular_BG96GetCampedBand. NULL clears the scan plan.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96SetScanPlan( const CellularBG96BandMask_t * pFirstBandMask );
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Scan all the configured bands after the scan plan bands fail.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful or the scan is not
+ * narrowed, otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96WidenBandScan( CellularHandle_t cellularHandle );
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Get the boot timing record.
+ *
+ * The record holds the time of each boot phase and of each AT command sent by
+ * Cellular_ModuleEnableUE and Cellular_ModuleEnableUrc since Cellular_ModuleInit.
+ * It is available if CELLULAR_BG96_BOOT_TIMING is enabled.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[out] pBootTiming Out parameter to provide the boot timing record.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_UNSUPPORTED
+ * if the boot timing is not enabled, otherwise an error code indicating the
+ * cause of the error.
+ */
+CellularError_t Cellular_BG96GetBootTiming( CellularHandle_t cellularHandle,
+                                            CellularBG96BootTiming_t * pBootTiming );
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Set the request class of the data transfer of a socket.
+ *
+ * Cellular_SocketSend and Cellular_SocketRecv of the socket wait for the AT
+ * channel in this class. Sockets are created in CELLULAR_BG96_REQUEST_BULK.
+ * Use CELLULAR_BG96_REQUEST_HIGH for a socket carrying keepalives. It is
+ * available if CELLULAR_BG96_REQUEST_PRIORITY is enabled.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] socketHandle Socket handle returned from the Cellular_CreateSocket call.
+ * @param[in] requestClass The request class of the socket.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_UNSUPPORTED
+ * if the request priority is not enabled, otherwise an error code indicating
+ * the cause of the error.
+ */
+CellularError_t Cellular_BG96SetSocketRequestClass( CellularHandle_t cellularHandle,
+                                                    CellularSocketHandle_t socketHandle,
+                                                    CellularBG96RequestClass_t requestClass );
+
+/**
+ * @brief Get the statistics of a request class.
+ *
+ * It is available if CELLULAR_BG96_REQUEST_PRIORITY is enabled.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] requestClass The request class.
+ * @param[out] pRequestStats Out parameter to provide the statistics of the class.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_UNSUPPORTED
+ * if the request priority is not enabled, otherwise an error code indicating
+ * the cause of the error.
+ */
+CellularError_t Cellular_BG96GetRequestStats( CellularHandle_t cellularHandle,
+                                              CellularBG96RequestClass_t requestClass,
+                                              CellularBG96RequestStats_t * pRequestStats );
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Start the PSM transmit scheduler.
+ *
+ * The active time T3324 is read with Cellular_GetPsmSettings. The active window
+ * is open when the scheduler starts. It closes on the "PSM POWER DOWN" and "RDY"
+ * URCs, or when no payload is sent for the active time. T3324 starts after the
+ * network releases the connection, so the scheduler closes the window before
+ * the modem enters PSM. It is available if CELLULAR_BG96_PSM_SCHEDULER is enabled.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] wakeCallback The callback to wake the modem for a due payload. NULL
+ * sends the due payloads without waking the modem.
+ * @param[in] pWakeContext The context passed to the wake callback.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_UNSUPPORTED
+ * if the PSM scheduler is not enabled, otherwise an error code indicating the
+ * cause of the error.
+ */
+CellularError_t Cellular_BG96PsmSchedulerStart( CellularHandle_t cellularHandle,
+                                                CellularBG96PsmWakeCallback_t wakeCallback,
+                                                void * pWakeContext );
+
+/**
+ * @brief Stop the PSM transmit scheduler.
+ *
+ * The payloads still held are reported to their callbacks with
+ * CELLULAR_INTERNAL_FAILURE.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_UNSUPPORTED
+ * if the PSM scheduler is not enabled, otherwise an error code indicating the
+ * cause of the error.
+ */
+CellularError_t Cellular_BG96PsmSchedulerStop( CellularHandle_t cellularHandle );
+
+/**
+ * @brief Open the active window and send the held payloads.
+ *
+ * The sockets are lost when the modem wakes from PSM. The application calls
+ * this function once it has connected the sockets again after the
+ * CELLULAR_MODEM_EVENT_BOOTUP_OR_REBOOT event.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_UNSUPPORTED
+ * if the PSM scheduler is not enabled or not started, otherwise an error code
+ * indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96PsmSchedulerFlush( CellularHandle_t cellularHandle );
+
+/**
+ * @brief Send a payload in the next active window of the modem.
+ *
+ * The payload is sent by the scheduler thread right away if the active window
+ * is open. Otherwise it is held until the window opens or its deadline is
+ * reached. A due payload is sent after the wake callback, together with all
+ * the held payloads. Payloads are sent in the order of their deadlines.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] socketHandle Socket handle returned from the Cellular_CreateSocket call.
+ * @param[in] pData The payload. It must stay valid until the callback is called.
+ * @param[in] dataLength The length of the payload.
+ * @param[in] deadlineMs The latest time to send the payload. 0 sends it right away.
+ * @param[in] sendCallback The completion callback. It is called from the
+ * scheduler thread and may call the cellular APIs.
+ * @param[in] pCallbackContext The context passed to the callback.
+ *
+ * @return CELLULAR_SUCCESS if the payload is queued, CELLULAR_NO_MEMORY if the
+ * queue is full, CELLULAR_UNSUPPORTED if the PSM scheduler is not enabled or
+ * not started, otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96PsmSend( CellularHandle_t cellularHandle,
+                                      CellularSocketHandle_t socketHandle,
+                                      const uint8_t * pData,
+                                      uint32_t dataLength,
+                                      uint32_t deadlineMs,
+                                      CellularBG96PsmSendCallback_t sendCallback,
+                                      void * pCallbackContext );
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Record that the application is waking the modem from PSM.
+ *
+ * Called when the application asserts PSM_EINT or PWRKEY, to measure the wakeup
+ * latency to "RDY" and to the first connected socket. The PSM scheduler calls
+ * it before its wake callback. It is available if CELLULAR_BG96_POWER_STATS is enabled.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_UNSUPPORTED
+ * if the power statistics are not enabled, otherwise an error code indicating
+ * the cause of the error.
+ */
+CellularError_t Cellular_BG96PowerWakeRequested( CellularHandle_t cellularHandle );
+
+/**
+ * @brief Get the power state record.
+ *
+ * The record holds the time spent in each power state, the PSM entries and
+ * wakeups, and the wakeup latencies. A wakeup not requested with
+ * Cellular_BG96PowerWakeRequested, by the network or T3412, is measured from
+ * "RDY" to the first connected socket. It is available if
+ * CELLULAR_BG96_POWER_STATS is enabled.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[out] pPowerStats Out parameter to provide the power state record.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_UNSUPPORTED
+ * if the power statistics are not enabled, otherwise an error code indicating
+ * the cause of the error.
+ */
+CellularError_t Cellular_BG96GetPowerStats( CellularHandle_t cellularHandle,
+                                            CellularBG96PowerStats_t * pPowerStats );
+
+/**
+ * @brief Encode a duration to a PSM timer value of CellularPsmSettings_t.
+ *
+ * The unit and the value of the timer are selected to give the encodable
+ * duration closest to seconds in the direction of rounding. A timer is
+ * deactivated with CELLULAR_BG96_PSM_TIMER_DEACTIVATED.
+ *
+ * @param[in] psmTimer The PSM timer to encode.
+ * @param[in] seconds The requested duration in seconds.
+ * @param[in] rounding Rounding of a duration that can't be encoded exactly.
+ * @param[out] pTimerValue Out parameter to provide the encoded timer value.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_BAD_PARAMETER
+ * if the duration is above the range of the timer with CELLULAR_BG96_PSM_ROUND_UP,
+ * otherwise an error code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96PsmTimerEncode( CellularBG96PsmTimer_t psmTimer,
+                                             uint32_t seconds,
+                                             CellularBG96PsmRounding_t rounding,
+                                             uint32_t * pTimerValue );
+
+/**
+ * @brief Decode a PSM timer value of CellularPsmSettings_t to a duration.
+ *
+ * @param[in] psmTimer The PSM timer to decode.
+ * @param[in] timerValue The encoded timer value.
+ * @param[out] pSeconds Out parameter to provide the duration in seconds, or
+ * CELLULAR_BG96_PSM_TIMER_DEACTIVATED.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96PsmTimerDecode( CellularBG96PsmTimer_t psmTimer,
+                                             uint32_t timerValue,
+                                             uint32_t * pSeconds );
+
+/**
+ * @brief Enable PSM with the periodic TAU and the active time in seconds.
+ *
+ * The timers are encoded with Cellular_BG96PsmTimerEncode and set with
+ * Cellular_SetPsmSettings. The periodic RAU and the GPRS ready timer are left
+ * to the modem defaults. The network may assign other values.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] periodicTauSeconds The requested periodic TAU T3412 in seconds.
+ * @param[in] activeTimeSeconds The requested active time T3324 in seconds.
+ * @param[in] rounding Rounding of a duration that can't be encoded exactly.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96SetPsmTimers( CellularHandle_t cellularHandle,
+                                           uint32_t periodicTauSeconds,
+                                           uint32_t activeTimeSeconds,
+                                           CellularBG96PsmRounding_t rounding );
+
+/**
+ * @brief Get the periodic TAU and the active time in seconds.
+ *
+ * The timers are read with Cellular_GetPsmSettings and decoded with
+ * Cellular_BG96PsmTimerDecode.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[out] pPeriodicTauSeconds Out parameter to provide the periodic TAU T3412.
+ * @param[out] pActiveTimeSeconds Out parameter to provide the active time T3324.
+ * CELLULAR_BG96_PSM_TIMER_DEACTIVATED if PSM is disabled.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96GetPsmTimers( CellularHandle_t cellularHandle,
+                                           uint32_t * pPeriodicTauSeconds,
+                                           uint32_t * pActiveTimeSeconds );
+
+/**
+ * @brief Start the session restore.
+ *
+ * The PDN configs set with Cellular_SetPdnConfig, the PDNs activated with
+ * Cellular_ActivatePdn and the connected sockets are restored when the modem
+ * reports "RDY". The restore waits for the network registration, then sets the
+ * PDN configs and activates the PDNs one by one. The sockets of a PDN are
+ * connected to their recorded remote address as soon as the PDN is active, and
+ * connect while the next PDN is activated. The PSM scheduler is flushed when
+ * the session is restored. It is available if CELLULAR_BG96_SESSION_RESTORE
+ * is enabled.
+ *
+ * The echo, UART, URC and signal strength URC settings of Cellular_Init are
+ * sent again before the session is restored. The sockets that were connected
+ * or connecting before the reboot are held by the restore until they are
+ * reconnected or fail. Cellular_SocketSend and Cellular_SocketRecv return
+ * CELLULAR_SOCKET_NOT_CONNECTED on a held socket, Cellular_SocketConnect and
+ * Cellular_SocketClose return CELLULAR_NOT_ALLOWED. Other sockets can be used.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ * @param[in] restoreCallback Called at the end of each restore. Can be NULL.
+ * @param[in] pCallbackContext The context passed to restoreCallback.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_UNSUPPORTED
+ * if the session restore is not enabled, otherwise an error code indicating the
+ * cause of the error.
+ */
+CellularError_t Cellular_BG96SessionRestoreStart( CellularHandle_t cellularHandle,
+                                                  CellularBG96SessionRestoreCallback_t restoreCallback,
+                                                  void * pCallbackContext );
+
+/**
+ * @brief Stop the session restore.
+ *
+ * A restore in progress stops after its current AT command, without callback.
+ * The session is still recorded.
+ *
+ * @param[in] cellularHandle The opaque cellular context pointer created by Cellular_Init.
+ *
+ * @return CELLULAR_SUCCESS if the operation is successful, CELLULAR_UNSUPPORTED
+ * if the session restore is not enabled, otherwise an error code indicating the
+ * cause of the error.
+ */
+CellularError_t Cellular_BG96SessionRestoreStop( CellularHandle_t cellularHandle );
+
+/*-----------------------------------------------------------*/
+
 extern CellularAtParseTokenMap_t CellularUrcHandlerTable[];
 extern uint32_t CellularUrcHandlerTableSize;
 
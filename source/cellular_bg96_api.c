@@ -45,6 +45,10 @@
 #define CELLULAR_AT_CMD_TYPICAL_MAX_SIZE           ( 32U )
 #define CELLULAR_AT_CMD_QUERY_DNS_MAX_SIZE         ( 280U )
 
+#if ( CELLULAR_BG96_COMMAND_BUFFER_SIZE < CELLULAR_AT_CMD_QUERY_DNS_MAX_SIZE ) || ( CELLULAR_BG96_COMMAND_BUFFER_SIZE < CELLULAR_AT_CMD_MAX_SIZE )
+    #error "CELLULAR_BG96_COMMAND_BUFFER_SIZE is too small."
+#endif
+
 #define SIGNAL_QUALITY_POS_SYSMODE                 ( 1U )
 #define SIGNAL_QUALITY_POS_GSM_LTE_RSSI            ( 2U )
 #define SIGNAL_QUALITY_POS_LTE_RSRP                ( 3U )
@@ -61,6 +65,11 @@
 /* AT command timeout for Get IP Address by Domain Name. */
 #define DNS_QUERY_TIMEOUT_MS                       ( 60000UL )
 
+/* DNS refresh thread events. */
+#define DNS_REFRESH_EVT_PENDING                    ( 0x0001UL )
+#define DNS_REFRESH_EVT_STOP                       ( 0x0002UL )
+#define DNS_REFRESH_EVT_THREAD_STOPPED             ( 0x0004UL )
+
 /* Length of HPLMN including RAT. */
 #define CRSM_HPLMN_RAT_LENGTH                      ( 9U )
 
@@ -69,17 +78,7 @@
     #define strtok_r                  strtok_s
 #endif
 
-#define PRINTF_BINARY_PATTERN_INT4    "%c%c%c%c"
-#define PRINTF_BYTE_TO_BINARY_INT4( i )            \
-    ( ( ( ( i ) & 0x08UL ) != 0UL ) ? '1' : '0' ), \
-    ( ( ( ( i ) & 0x04UL ) != 0UL ) ? '1' : '0' ), \
-    ( ( ( ( i ) & 0x02UL ) != 0UL ) ? '1' : '0' ), \
-    ( ( ( ( i ) & 0x01UL ) != 0UL ) ? '1' : '0' )
-
-#define PRINTF_BINARY_PATTERN_INT8 \
-    PRINTF_BINARY_PATTERN_INT4 PRINTF_BINARY_PATTERN_INT4
-#define PRINTF_BYTE_TO_BINARY_INT8( i ) \
-    PRINTF_BYTE_TO_BINARY_INT4( ( i ) >> 4 ), PRINTF_BYTE_TO_BINARY_INT4( i )
+#define BINARY_PATTERN_INT8_LENGTH               ( 8U )
 
 #define QPSMS_POS_MODE                           ( 0U )
 #define QPSMS_POS_RAU                            ( 1U )
@@ -158,7 +157,6 @@ static CellularPktStatus_t _Cellular_RecvFuncGetSimCardStatus( CellularContext_t
                                                                const CellularATCommandResponse_t * pAtResp,
                                                                void * pData,
                                                                uint16_t dataLen );
-static CellularSimCardLockState_t _getSimLockState( char * pToken );
 static CellularPktStatus_t _Cellular_RecvFuncGetSimLockStatus( CellularContext_t * pContext,
                                                                const CellularATCommandResponse_t * pAtResp,
                                                                void * pData,
@@ -178,6 +176,17 @@ static CellularPktStatus_t _Cellular_RecvFuncGetPdnStatus( CellularContext_t * p
                                                            const CellularATCommandResponse_t * pAtResp,
                                                            void * pData,
                                                            uint16_t dataLen );
+#if ( CELLULAR_BG96_PDN_STATUS_CACHE == 1 )
+    static CellularPktStatus_t _Cellular_RecvFuncUpdatePdnStatus( CellularContext_t * pContext,
+                                                                  const CellularATCommandResponse_t * pAtResp,
+                                                                  void * pData,
+                                                                  uint16_t dataLen );
+    static CellularError_t updatePdnStatus( CellularContext_t * pContext,
+                                            cellularModuleContext_t * pModuleContext );
+    static uint8_t readPdnStatus( cellularModuleContext_t * pModuleContext,
+                                  CellularPdnStatus_t * pPdnStatusBuffers,
+                                  uint8_t numStatusBuffers );
+#endif
 static CellularError_t buildSocketConnect( CellularSocketHandle_t socketHandle,
                                            char * pCmdBuf );
 static CellularATError_t getDataFromResp( const CellularATCommandResponse_t * pAtResp,
@@ -219,18 +228,99 @@ static CellularError_t storeAccessModeAndAddress( CellularContext_t * pContext,
                                                   CellularSocketAccessMode_t dataAccessMode,
                                                   const CellularSocketAddress_t * pRemoteSocketAddress );
 static CellularError_t registerDnsEventCallback( cellularModuleContext_t * pModuleContext,
-                                                 CellularDnsResultEventCallback_t dnsEventCallback,
-                                                 char * pDnsUsrData );
+                                                 CellularDnsResultEventCallback_t dnsEventCallback );
+static cellularDnsQuery_t * dnsQueryAllocate( cellularModuleContext_t * pModuleContext,
+                                              uint8_t contextId,
+                                              const char * pcHostName,
+                                              CellularBG96DnsResultCallback_t dnsResultCallback,
+                                              void * pCallbackContext );
+static cellularDnsQuery_t * dnsQueryOldestWaiting( cellularModuleContext_t * pModuleContext );
+static void dnsQueryComplete( cellularDnsQuery_t * pDnsQuery,
+                              cellularDnsQueryResult_t dnsQueryResult );
+static uint8_t copyDnsAddresses( const cellularDnsAddressList_t * pAddressList,
+                                 CellularIPAddress_t * pAddresses,
+                                 uint8_t addressesLength );
+static void dnsQueryReportAsync( cellularModuleContext_t * pModuleContext,
+                                 const cellularDnsQuery_t * pDnsQuery,
+                                 CellularError_t dnsStatus );
+static void dnsQueryExpire( cellularModuleContext_t * pModuleContext );
+static void parseDnsQueryHeader( char * pDnsResult,
+                                 cellularDnsQuery_t * pDnsQuery );
+static bool isDnsAddressLine( const char * pDnsResult );
 static void _dnsResultCallback( cellularModuleContext_t * pModuleContext,
-                                char * pDnsResult,
-                                char * pDnsUsrData );
-static uint32_t appendBinaryPattern( char * cmdBuf,
-                                     uint32_t cmdLen,
-                                     uint32_t value,
-                                     bool endOfString );
+                                char * pDnsResult );
+static CellularError_t sendDnsQuery( CellularContext_t * pContext,
+                                     cellularModuleContext_t * pModuleContext,
+                                     uint8_t contextId,
+                                     const char * pcHostName,
+                                     CellularBG96DnsResultCallback_t dnsResultCallback,
+                                     void * pCallbackContext,
+                                     cellularDnsQuery_t ** ppDnsQuery,
+                                     uint32_t * pRequestId );
+static CellularError_t queryHostByName( CellularContext_t * pContext,
+                                        cellularModuleContext_t * pModuleContext,
+                                        uint8_t contextId,
+                                        const char * pcHostName,
+                                        cellularDnsAddressList_t * pAddressList,
+                                        cellularDnsQueryResult_t * pDnsQueryResult,
+                                        uint32_t * pDnsTtl );
+static CellularError_t resolveHostName( CellularContext_t * pContext,
+                                        uint8_t contextId,
+                                        const char * pcHostName,
+                                        cellularDnsAddressList_t * pAddressList );
+static CellularError_t sendBandMask( CellularContext_t * pContext,
+                                     cellularModuleContext_t * pModuleContext,
+                                     const CellularBG96BandMask_t * pBandMask );
+static CellularPktStatus_t _Cellular_RecvFuncGetCampedBand( CellularContext_t * pContext,
+                                                            const CellularATCommandResponse_t * pAtResp,
+                                                            void * pData,
+                                                            uint16_t dataLen );
+
+#if ( CELLULAR_BG96_DNS_CACHE_ENTRIES > 0U )
+    static cellularDnsCacheEntry_t * dnsCacheFind( cellularModuleContext_t * pModuleContext,
+                                                   uint8_t contextId,
+                                                   const char * pcHostName );
+    static cellularDnsQueryResult_t dnsCacheLookup( cellularModuleContext_t * pModuleContext,
+                                                    uint8_t contextId,
+                                                    const char * pcHostName,
+                                                    cellularDnsAddressList_t * pAddressList,
+                                                    bool * pRefreshAhead );
+    static bool dnsCacheHit( cellularDnsCacheEntry_t * pEntry );
+    static void dnsRefreshCallback( uint32_t requestId,
+                                    CellularError_t dnsStatus,
+                                    const CellularIPAddress_t * pAddresses,
+                                    uint8_t addressesNum,
+                                    void * pCallbackContext );
+    static void dnsRefreshFailed( cellularModuleContext_t * pModuleContext,
+                                  uint8_t contextId,
+                                  const char * pcHostName );
+    static void dnsRefreshThread( void * pUserData );
+    static void dnsRefreshAhead( CellularContext_t * pContext,
+                                 cellularModuleContext_t * pModuleContext );
+    static void dnsCacheStore( cellularModuleContext_t * pModuleContext,
+                               uint8_t contextId,
+                               const char * pcHostName,
+                               const cellularDnsAddressList_t * pAddressList,
+                               uint32_t ttlMs );
+    static void dnsCacheStoreResult( cellularModuleContext_t * pModuleContext,
+                                     uint8_t contextId,
+                                     const char * pcHostName,
+                                     cellularDnsQueryResult_t dnsQueryResult,
+                                     const cellularDnsAddressList_t * pAddressList,
+                                     uint32_t dnsTtl );
+#endif /* CELLULAR_BG96_DNS_CACHE_ENTRIES. */
+
+static void appendBinaryPattern( cellularAtBuilder_t * pCmdBuilder,
+                                 uint32_t value,
+                                 bool endOfString );
 static CellularPktStatus_t socketSendDataPrefix( void * pCallbackContext,
                                                  char * pLine,
                                                  uint32_t * pBytesRead );
+static void rearmDataReadyNotification( const CellularContext_t * pContext,
+                                        uint32_t socketId,
+                                        bool resetSuppressedCount );
+static bool socketRestoring( const CellularContext_t * pContext,
+                             CellularSocketHandle_t socketHandle );
 
 /*-----------------------------------------------------------*/
 
@@ -426,6 +516,7 @@ static CellularPktStatus_t _Cellular_RecvFuncGetSignalInfo( CellularContext_t *
 {
     char * pInputLine = NULL;
     CellularSignalInfo_t * pSignalInfo = ( CellularSignalInfo_t * ) pData;
+    cellularModuleContext_t * pModuleContext = NULL;
     bool parseStatus = true;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
     CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
@@ -477,6 +568,21 @@ static CellularPktStatus_t _Cellular_RecvFuncGetSignalInfo( CellularContext_t *
             pSignalInfo->bars = CELLULAR_INVALID_SIGNAL_BAR_VALUE;
             pktStatus = CELLULAR_PKT_STATUS_FAILURE;
         }
+        else if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+        {
+            /* Update the signal information snapshot. AT+QCSQ doesn't report BER. */
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pModuleContext->signalInfo = *pSignalInfo;
+            pModuleContext->signalInfo.ber = CELLULAR_INVALID_SIGNAL_VALUE;
+            pModuleContext->signalInfoTick = xTaskGetTickCount();
+            pModuleContext->signalLteTick = pModuleContext->signalInfoTick;
+            pModuleContext->signalInfoValid = true;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
     }
 
     return pktStatus;
@@ -490,7 +596,9 @@ static CellularError_t controlSignalStrengthIndication( CellularContext_t * pCon
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
     char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    cellularAtBuilder_t cmdBuilder;
     uint8_t enable_value = 0;
+    cellularModuleContext_t * pModuleContext = NULL;
     CellularAtReq_t atReqControlSignalStrengthIndication =
     {
         cmdBuf,
@@ -514,13 +622,37 @@ static CellularError_t controlSignalStrengthIndication( CellularContext_t * pCon
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        /* The return value of snprintf is not used.
-         * The max length of the string is fixed and checked offline. */
-        ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE, "AT+QINDCFG=\"csq\",%u", enable_value );
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* AT+QINDCFG="csq" has no interval or threshold parameter. The URC filter
+         * is applied in the URC handler and restarts when the URC is enabled. */
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        pModuleContext->csqUrcReported = false;
+        pModuleContext->csqUrcPending = false;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        _Cellular_AtBuilderInit( &cmdBuilder, cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "AT+QINDCFG=\"csq\"," );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, enable_value );
+        cellularStatus = _Cellular_AtBuilderStatus( &cmdBuilder );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
         pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqControlSignalStrengthIndication );
         cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
     }
 
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        pModuleContext->csqUrcEnabled = enable;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    }
+
     return cellularStatus;
 }
 
@@ -870,7 +1002,7 @@ static CellularPktStatus_t _Cellular_RecvFuncGetSimCardStatus( CellularContext_t
 
 /*-----------------------------------------------------------*/
 
-static CellularSimCardLockState_t _getSimLockState( char * pToken )
+CellularSimCardLockState_t _Cellular_ParseSimLockState( const char * pToken )
 {
     CellularSimCardLockState_t tempState = CELLULAR_SIM_CARD_LOCK_UNKNOWN;
 
@@ -988,7 +1120,7 @@ static CellularPktStatus_t _Cellular_RecvFuncGetSimLockStatus( CellularContext_t
         if( atCoreStatus == CELLULAR_AT_SUCCESS )
         {
             LogDebug( ( "SIM Lock State: %s", pToken ) );
-            *pSimLockState = _getSimLockState( pToken );
+            *pSimLockState = _Cellular_ParseSimLockState( pToken );
         }
 
         if( atCoreStatus != CELLULAR_AT_SUCCESS )
@@ -1244,11 +1376,163 @@ static CellularPktStatus_t _Cellular_RecvFuncGetPdnStatus( CellularContext_t * p
 
 /*-----------------------------------------------------------*/
 
+#if ( CELLULAR_BG96_PDN_STATUS_CACHE == 1 )
+
+/* Store the activated PDN contexts in the module context. The PDN status is
+ * up to date only if no PDN context changed during the query. */
+    static CellularPktStatus_t _Cellular_RecvFuncUpdatePdnStatus( CellularContext_t * pContext,
+                                                                  const CellularATCommandResponse_t * pAtResp,
+                                                                  void * pData,
+                                                                  uint16_t dataLen )
+    {
+        const uint32_t * pGeneration = ( const uint32_t * ) pData;
+        cellularModuleContext_t * pModuleContext = NULL;
+        CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+        CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+        const CellularATCommandLine_t * pCommnadItem = NULL;
+        CellularPdnStatus_t pdnStatus = { 0 };
+        uint32_t activatedMask = 0;
+        uint8_t contextId = 0;
+
+        if( pContext == NULL )
+        {
+            LogError( ( "UpdatePdnStatus: invalid context" ) );
+            pktStatus = CELLULAR_PKT_STATUS_FAILURE;
+        }
+        else if( ( pAtResp == NULL ) || ( pGeneration == NULL ) || ( dataLen != sizeof( uint32_t ) ) )
+        {
+            LogError( ( "UpdatePdnStatus: bad parameters" ) );
+            pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
+        }
+        else if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) != CELLULAR_SUCCESS )
+        {
+            pktStatus = CELLULAR_PKT_STATUS_FAILURE;
+        }
+        else
+        {
+            /* No line is received if no PDN context is activated. */
+            pCommnadItem = pAtResp->pItm;
+
+            while( ( pCommnadItem != NULL ) && ( pCommnadItem->pLine != NULL ) )
+            {
+                ( void ) memset( &pdnStatus, 0, sizeof( CellularPdnStatus_t ) );
+                atCoreStatus = getPdnStatusParseLine( pCommnadItem->pLine, &pdnStatus );
+                pktStatus = _Cellular_TranslateAtCoreStatus( atCoreStatus );
+
+                if( ( pktStatus != CELLULAR_PKT_STATUS_OK ) || ( _Cellular_IsValidPdn( pdnStatus.contextId ) != CELLULAR_SUCCESS ) )
+                {
+                    LogError( ( "UpdatePdnStatus: parse QIACT line failed" ) );
+                    pktStatus = CELLULAR_PKT_STATUS_FAILURE;
+                    break;
+                }
+
+                pdnStatus.ipAddress.ipAddress[ CELLULAR_IP_ADDRESS_MAX_SIZE ] = '\0';
+                activatedMask |= ( 1UL << ( pdnStatus.contextId - CELLULAR_PDN_CONTEXT_ID_MIN ) );
+                PlatformMutex_Lock( &pModuleContext->stateMutex );
+                pModuleContext->pdnStatus[ pdnStatus.contextId - CELLULAR_PDN_CONTEXT_ID_MIN ] = pdnStatus;
+                PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+                pCommnadItem = pCommnadItem->pNext;
+            }
+        }
+
+        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            for( contextId = CELLULAR_PDN_CONTEXT_ID_MIN; contextId <= CELLULAR_PDN_CONTEXT_ID_MAX; contextId++ )
+            {
+                if( ( activatedMask & ( 1UL << ( contextId - CELLULAR_PDN_CONTEXT_ID_MIN ) ) ) == 0U )
+                {
+                    ( void ) memset( &pModuleContext->pdnStatus[ contextId - CELLULAR_PDN_CONTEXT_ID_MIN ], 0,
+                                     sizeof( CellularPdnStatus_t ) );
+                }
+            }
+
+            /* A PDN event received during the query may be older than the response. */
+            pModuleContext->pdnStatusValid = ( *pGeneration == pModuleContext->pdnStatusGeneration ) ? true : false;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+
+        return pktStatus;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static CellularError_t updatePdnStatus( CellularContext_t * pContext,
+                                            cellularModuleContext_t * pModuleContext )
+    {
+        CellularError_t cellularStatus = CELLULAR_SUCCESS;
+        CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+        uint32_t pdnStatusGeneration = 0;
+        bool pdnStatusValid = false;
+        CellularAtReq_t atReqUpdatePdnStatus =
+        {
+            "AT+QIACT?",
+            CELLULAR_AT_WITH_PREFIX,
+            "+QIACT",
+            _Cellular_RecvFuncUpdatePdnStatus,
+            &pdnStatusGeneration,
+            sizeof( uint32_t ),
+        };
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        pdnStatusValid = pModuleContext->pdnStatusValid;
+        pdnStatusGeneration = pModuleContext->pdnStatusGeneration;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        if( pdnStatusValid == false )
+        {
+            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqUpdatePdnStatus );
+            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+        }
+
+        return cellularStatus;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Copy the activated PDN contexts in ascending context ID order. Returns the
+ * number of PDN status copied. */
+    static uint8_t readPdnStatus( cellularModuleContext_t * pModuleContext,
+                                  CellularPdnStatus_t * pPdnStatusBuffers,
+                                  uint8_t numStatusBuffers )
+    {
+        uint8_t numStatus = 0;
+        uint8_t i = 0;
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+        for( i = 0; ( i < CELLULAR_PDN_CONTEXT_ID_MAX ) && ( numStatus < numStatusBuffers ); i++ )
+        {
+            if( pModuleContext->pdnStatus[ i ].contextId != 0U )
+            {
+                pPdnStatusBuffers[ numStatus ] = pModuleContext->pdnStatus[ i ];
+                numStatus++;
+            }
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        /* The context ID of the first invalid PDN status is set to FF. */
+        if( numStatus < numStatusBuffers )
+        {
+            pPdnStatusBuffers[ numStatus ].contextId = INVALID_PDN_INDEX;
+        }
+
+        return numStatus;
+    }
+
+#endif /* CELLULAR_BG96_PDN_STATUS_CACHE. */
+
+/*-----------------------------------------------------------*/
+
 static CellularError_t buildSocketConnect( CellularSocketHandle_t socketHandle,
                                            char * pCmdBuf )
 {
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    char protocol[ 15 ];
+    cellularAtBuilder_t cmdBuilder;
+    const char * pProtocol = NULL;
 
     if( pCmdBuf == NULL )
     {
@@ -1260,27 +1544,30 @@ static CellularError_t buildSocketConnect( CellularSocketHandle_t socketHandle,
     {
         if( socketHandle->socketProtocol == CELLULAR_SOCKET_PROTOCOL_TCP )
         {
-            ( void ) strcpy( protocol, "TCP" );
+            pProtocol = "TCP";
         }
         else
         {
-            ( void ) strcpy( protocol, "UDP SERVICE" );
+            pProtocol = "UDP SERVICE";
         }
 
         /* Form the AT command. */
-
-        /* The return value of snprintf is not used.
-         * The max length of the string is fixed and checked offline. */
-        ( void ) snprintf( pCmdBuf, CELLULAR_AT_CMD_MAX_SIZE,
-                           "%s%d,%ld,\"%s\",\"%s\",%d,%d,%d",
-                           "AT+QIOPEN=",
-                           socketHandle->contextId,
-                           socketHandle->socketId,
-                           protocol,
-                           socketHandle->remoteSocketAddress.ipAddress.ipAddress,
-                           socketHandle->remoteSocketAddress.port,
-                           socketHandle->localPort,
-                           socketHandle->dataMode );
+        _Cellular_AtBuilderInit( &cmdBuilder, pCmdBuf, CELLULAR_AT_CMD_MAX_SIZE );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "AT+QIOPEN=" );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, socketHandle->contextId );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, socketHandle->socketId );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        _Cellular_AtBuilderAppendQuoted( &cmdBuilder, pProtocol );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        _Cellular_AtBuilderAppendQuoted( &cmdBuilder, socketHandle->remoteSocketAddress.ipAddress.ipAddress );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, socketHandle->remoteSocketAddress.port );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, socketHandle->localPort );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, ( uint32_t ) socketHandle->dataMode );
+        cellularStatus = _Cellular_AtBuilderStatus( &cmdBuilder );
     }
 
     return cellularStatus;
@@ -1439,11 +1726,13 @@ static CellularATError_t parseQpsmsMode( char * pToken,
 
 /*-----------------------------------------------------------*/
 
+/* The timers are bit strings of the 3GPP encoding, the format Cellular_SetPsmSettings
+ * writes with appendBinaryPattern. */
 static CellularATError_t parseQpsmsRau( char * pToken,
                                         CellularPsmSettings_t * pPsmSettings )
 {
     int32_t tempValue = 0;
-    CellularATError_t atCoreStatus = Cellular_ATStrtoi( pToken, 10, &tempValue );
+    CellularATError_t atCoreStatus = Cellular_ATStrtoi( pToken, 2, &tempValue );
 
     if( atCoreStatus == CELLULAR_AT_SUCCESS )
     {
@@ -1467,7 +1756,7 @@ static CellularATError_t parseQpsmsRdyTimer( char * pToken,
                                              CellularPsmSettings_t * pPsmSettings )
 {
     int32_t tempValue = 0;
-    CellularATError_t atCoreStatus = Cellular_ATStrtoi( pToken, 10, &tempValue );
+    CellularATError_t atCoreStatus = Cellular_ATStrtoi( pToken, 2, &tempValue );
 
     if( atCoreStatus == CELLULAR_AT_SUCCESS )
     {
@@ -1491,7 +1780,7 @@ static CellularATError_t parseQpsmsTau( char * pToken,
                                         CellularPsmSettings_t * pPsmSettings )
 {
     int32_t tempValue = 0;
-    CellularATError_t atCoreStatus = Cellular_ATStrtoi( pToken, 10, &tempValue );
+    CellularATError_t atCoreStatus = Cellular_ATStrtoi( pToken, 2, &tempValue );
 
     if( atCoreStatus == CELLULAR_AT_SUCCESS )
     {
@@ -1515,7 +1804,7 @@ static CellularATError_t parseQpsmsActiveTime( char * pToken,
                                                CellularPsmSettings_t * pPsmSettings )
 {
     int32_t tempValue = 0;
-    CellularATError_t atCoreStatus = Cellular_ATStrtoi( pToken, 10, &tempValue );
+    CellularATError_t atCoreStatus = Cellular_ATStrtoi( pToken, 2, &tempValue );
 
     if( atCoreStatus == CELLULAR_AT_SUCCESS )
     {
@@ -1939,8 +2228,7 @@ static CellularError_t storeAccessModeAndAddress( CellularContext_t * pContext,
 /*-----------------------------------------------------------*/
 
 static CellularError_t registerDnsEventCallback( cellularModuleContext_t * pModuleContext,
-                                                 CellularDnsResultEventCallback_t dnsEventCallback,
-                                                 char * pDnsUsrData )
+                                                 CellularDnsResultEventCallback_t dnsEventCallback )
 {
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
 
@@ -1951,7 +2239,6 @@ static CellularError_t registerDnsEventCallback( cellularModuleContext_t * pModu
     else
     {
         pModuleContext->dnsEventCallback = dnsEventCallback;
-        pModuleContext->pDnsUsrData = pDnsUsrData;
     }
 
     return cellularStatus;
@@ -1959,488 +2246,1018 @@ static CellularError_t registerDnsEventCallback( cellularModuleContext_t * pModu
 
 /*-----------------------------------------------------------*/
 
-static void _dnsResultCallback( cellularModuleContext_t * pModuleContext,
-                                char * pDnsResult,
-                                char * pDnsUsrData )
+/* The caller must hold stateMutex. */
+static cellularDnsQuery_t * dnsQueryAllocate( cellularModuleContext_t * pModuleContext,
+                                              uint8_t contextId,
+                                              const char * pcHostName,
+                                              CellularBG96DnsResultCallback_t dnsResultCallback,
+                                              void * pCallbackContext )
 {
-    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
-    char * pToken = NULL, * pDnsResultStr = pDnsResult;
-    int32_t dnsResultNumber = 0;
-    cellularDnsQueryResult_t dnsQueryResult = CELLULAR_DNS_QUERY_UNKNOWN;
+    cellularDnsQuery_t * pDnsQuery = NULL;
+    QueueHandle_t resultQueue = NULL;
+    uint32_t i = 0;
 
-    if( pModuleContext != NULL )
+    for( i = 0; i < CELLULAR_BG96_DNS_QUERY_SLOTS; i++ )
     {
-        if( pModuleContext->dnsResultNumber == ( uint8_t ) 0 )
+        if( pModuleContext->dnsQueries[ i ].state == CELLULAR_DNS_QUERY_STATE_FREE )
         {
-            atCoreStatus = Cellular_ATGetNextTok( &pDnsResultStr, &pToken );
+            pDnsQuery = &pModuleContext->dnsQueries[ i ];
+            break;
+        }
+    }
 
-            if( atCoreStatus == CELLULAR_AT_SUCCESS )
-            {
-                atCoreStatus = Cellular_ATGetNextTok( &pDnsResultStr, &pToken );
-            }
+    if( pDnsQuery != NULL )
+    {
+        /* A result may be left in the queue by a query that timed out. */
+        resultQueue = pDnsQuery->resultQueue;
+        ( void ) xQueueReset( resultQueue );
+        ( void ) memset( pDnsQuery, 0, sizeof( cellularDnsQuery_t ) );
+        pDnsQuery->resultQueue = resultQueue;
+        pDnsQuery->result = CELLULAR_DNS_QUERY_UNKNOWN;
 
-            if( atCoreStatus == CELLULAR_AT_SUCCESS )
-            {
-                atCoreStatus = Cellular_ATStrtoi( pToken, 10, &dnsResultNumber );
+        /* Sequence number 0 is the request ID of a cached result. */
+        pModuleContext->dnsQuerySequence++;
 
-                if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( dnsResultNumber >= 0 ) &&
-                    ( dnsResultNumber <= ( int32_t ) UINT8_MAX ) )
-                {
-                    pModuleContext->dnsResultNumber = ( uint8_t ) dnsResultNumber;
-                }
-                else
-                {
-                    LogDebug( ( "_dnsResultCallback convert string failed %s", pToken ) );
-                }
-            }
-        }
-        else if( ( pModuleContext->dnsIndex < pModuleContext->dnsResultNumber ) && ( pDnsResultStr != NULL ) )
+        if( pModuleContext->dnsQuerySequence == 0U )
         {
-            pModuleContext->dnsIndex = pModuleContext->dnsIndex + ( uint8_t ) 1;
+            pModuleContext->dnsQuerySequence++;
+        }
 
-            ( void ) strncpy( pDnsUsrData, pDnsResultStr, CELLULAR_IP_ADDRESS_MAX_SIZE );
-            ( void ) registerDnsEventCallback( pModuleContext, NULL, NULL );
-            dnsQueryResult = CELLULAR_DNS_QUERY_SUCCESS;
+        pDnsQuery->sequence = pModuleContext->dnsQuerySequence;
+        pDnsQuery->asyncQuery = ( dnsResultCallback != NULL ) ? true : false;
+        pDnsQuery->callback = dnsResultCallback;
+        pDnsQuery->pCallbackContext = pCallbackContext;
+        pDnsQuery->startTick = xTaskGetTickCount();
+        pDnsQuery->contextId = contextId;
 
-            if( xQueueSend( pModuleContext->pktDnsQueue, &dnsQueryResult, ( TickType_t ) 0 ) != pdPASS )
-            {
-                LogDebug( ( "_dnsResultCallback sends pktDnsQueue fail" ) );
-            }
-        }
-        else
+        if( strlen( pcHostName ) <= CELLULAR_BG96_DNS_CACHE_HOSTNAME_MAX_SIZE )
         {
-            LogDebug( ( "_dnsResultCallback spurious DNS response" ) );
+            ( void ) strncpy( pDnsQuery->hostName, pcHostName, CELLULAR_BG96_DNS_CACHE_HOSTNAME_MAX_SIZE );
         }
+
+        #if ( CELLULAR_BG96_DNS_CACHE_ENTRIES > 0U )
+            pDnsQuery->refreshQuery = ( dnsResultCallback == dnsRefreshCallback ) ? true : false;
+        #endif /* CELLULAR_BG96_DNS_CACHE_ENTRIES. */
+
+        pDnsQuery->state = CELLULAR_DNS_QUERY_STATE_WAITING;
     }
+
+    return pDnsQuery;
 }
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_SetRatPriority( CellularHandle_t cellularHandle,
-                                         const CellularRat_t * pRatPriorities,
-                                         uint8_t ratPrioritiesLength )
+/* The caller must hold stateMutex. */
+static cellularDnsQuery_t * dnsQueryOldestWaiting( cellularModuleContext_t * pModuleContext )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
-    uint8_t i = 0;
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
-    CellularAtReq_t atReqSetRatPriority =
-    {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0,
-    };
-
-    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+    cellularDnsQuery_t * pDnsQuery = NULL;
+    uint32_t i = 0;
 
-    if( cellularStatus != CELLULAR_SUCCESS )
-    {
-        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
-    }
-    else if( ( pRatPriorities == NULL ) || ( ratPrioritiesLength == 0U ) ||
-             ( ratPrioritiesLength > ( uint8_t ) CELLULAR_MAX_RAT_PRIORITY_COUNT ) )
-    {
-        cellularStatus = CELLULAR_BAD_PARAMETER;
-    }
-    else
+    for( i = 0; i < CELLULAR_BG96_DNS_QUERY_SLOTS; i++ )
     {
-        /** Using AT+QCFG="nwscanseq",<scanseq>,<effect> to set the RAT priorities while searching.
-         * <scanseq> can take value 01 for GSM, 02 for CAT M1 and 03 for CAT NB1.
-         * <effect> can take value 0 for take effect after reboot and 1 for take effect immediately.
-         *  If < effect > is omitted, RAT priority takes effect immediately.
-         *  e.g. AT+QCFG="nwscanseq",020301,1 for decreasing RAT Priorities CAT M1, CAT NB1, GSM to take effect immediately. */
-        ( void ) strcpy( cmdBuf, "AT+QCFG=\"nwscanseq\"," );
-
-        while( i < ratPrioritiesLength )
+        if( ( pModuleContext->dnsQueries[ i ].state == CELLULAR_DNS_QUERY_STATE_WAITING ) ||
+            ( pModuleContext->dnsQueries[ i ].state == CELLULAR_DNS_QUERY_STATE_ORPHANED ) )
         {
-            if( pRatPriorities[ i ] == CELLULAR_RAT_GSM )
-            {
-                ( void ) strcat( cmdBuf, "01" );
-            }
-            else if( pRatPriorities[ i ] == CELLULAR_RAT_CATM1 )
-            {
-                ( void ) strcat( cmdBuf, "02" );
-            }
-            else if( pRatPriorities[ i ] == CELLULAR_RAT_NBIOT )
-            {
-                ( void ) strcat( cmdBuf, "03" );
-            }
-            else
+            /* Wrap around safe comparison of the sequence numbers. */
+            if( ( pDnsQuery == NULL ) ||
+                ( ( pDnsQuery->sequence - pModuleContext->dnsQueries[ i ].sequence ) < ( UINT32_MAX / 2U ) ) )
             {
-                cellularStatus = CELLULAR_BAD_PARAMETER;
-                break;
+                pDnsQuery = &pModuleContext->dnsQueries[ i ];
             }
-
-            i++;
         }
     }
 
-    if( cellularStatus == CELLULAR_SUCCESS )
-    {
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqSetRatPriority );
-        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
-    }
-
-    return cellularStatus;
+    return pDnsQuery;
 }
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_GetRatPriority( CellularHandle_t cellularHandle,
-                                         CellularRat_t * pRatPriorities,
-                                         uint8_t ratPrioritiesLength,
-                                         uint8_t * pReceiveRatPrioritesLength )
+/* The caller must hold stateMutex. */
+static void dnsQueryComplete( cellularDnsQuery_t * pDnsQuery,
+                              cellularDnsQueryResult_t dnsQueryResult )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    uint32_t ratIndex = 0;
-
-    CellularAtReq_t atReqSetRatPriority =
-    {
-        "AT+QCFG=\"nwscanseq\"",
-        CELLULAR_AT_WITH_PREFIX,
-        "+QCFG",
-        _Cellular_RecvFuncGetRatPriority,
-        pRatPriorities,
-        ( uint16_t ) ratPrioritiesLength,
-    };
+    bool taskWaiting = ( pDnsQuery->state == CELLULAR_DNS_QUERY_STATE_WAITING ) ? true : false;
 
-    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+    pDnsQuery->result = dnsQueryResult;
+    pDnsQuery->state = CELLULAR_DNS_QUERY_STATE_DONE;
 
-    if( cellularStatus != CELLULAR_SUCCESS )
-    {
-        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
-    }
-    else if( ( pRatPriorities == NULL ) || ( ratPrioritiesLength == 0U ) ||
-             ( ratPrioritiesLength > ( uint8_t ) CELLULAR_MAX_RAT_PRIORITY_COUNT ) ||
-             ( pReceiveRatPrioritesLength == NULL ) )
+    /* An asynchronous query is reported by _dnsResultCallback. No task waits
+     * for an orphaned query. */
+    if( ( pDnsQuery->asyncQuery == false ) && ( taskWaiting == true ) )
     {
-        cellularStatus = CELLULAR_BAD_PARAMETER;
+        if( xQueueSend( pDnsQuery->resultQueue, &dnsQueryResult, ( TickType_t ) 0 ) != pdPASS )
+        {
+            LogDebug( ( "_dnsResultCallback sends resultQueue fail" ) );
+        }
     }
-    else
+}
+
+/*-----------------------------------------------------------*/
+
+static uint8_t copyDnsAddresses( const cellularDnsAddressList_t * pAddressList,
+                                 CellularIPAddress_t * pAddresses,
+                                 uint8_t addressesLength )
+{
+    uint8_t i = 0;
+
+    for( i = 0; ( i < pAddressList->addressCount ) && ( i < addressesLength ); i++ )
     {
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqSetRatPriority );
+        ( void ) memset( &pAddresses[ i ], 0, sizeof( CellularIPAddress_t ) );
+        ( void ) strncpy( pAddresses[ i ].ipAddress, pAddressList->addresses[ i ], CELLULAR_IP_ADDRESS_MAX_SIZE );
 
-        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        if( strchr( pAddressList->addresses[ i ], ':' ) != NULL )
         {
-            for( ratIndex = 0; ratIndex < ratPrioritiesLength; ratIndex++ )
-            {
-                if( pRatPriorities[ ratIndex ] == CELLULAR_RAT_INVALID )
-                {
-                    break;
-                }
-            }
-
-            *pReceiveRatPrioritesLength = ratIndex;
+            pAddresses[ i ].ipAddressType = CELLULAR_IP_ADDRESS_V6;
+        }
+        else
+        {
+            pAddresses[ i ].ipAddressType = CELLULAR_IP_ADDRESS_V4;
         }
-
-        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
     }
 
-    return cellularStatus;
+    return i;
 }
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_SetDns( CellularHandle_t cellularHandle,
-                                 uint8_t contextId,
-                                 const char * pDnsServerAddress )
+/* Called without stateMutex. pDnsQuery is a copy of the freed slot. */
+static void dnsQueryReportAsync( cellularModuleContext_t * pModuleContext,
+                                 const cellularDnsQuery_t * pDnsQuery,
+                                 CellularError_t dnsStatus )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
-    CellularAtReq_t atReqSetDns =
-    {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0,
-    };
+    CellularIPAddress_t addresses[ CELLULAR_BG96_DNS_MAX_ADDRESSES ];
+    uint8_t addressesNum = 0;
 
-    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+    #if ( CELLULAR_BG96_DNS_CACHE_ENTRIES > 0U )
+        if( pDnsQuery->hostName[ 0 ] == '\0' )
+        {
+            /* The host name is too long to be cached. */
+        }
+        else if( ( pDnsQuery->refreshQuery == true ) && ( pDnsQuery->result != CELLULAR_DNS_QUERY_SUCCESS ) )
+        {
+            /* A failed refresh keeps the cached addresses until they expire. */
+            dnsRefreshFailed( pModuleContext, pDnsQuery->contextId, pDnsQuery->hostName );
+        }
+        else
+        {
+            dnsCacheStoreResult( pModuleContext, pDnsQuery->contextId, pDnsQuery->hostName,
+                                 pDnsQuery->result, &pDnsQuery->addressList, pDnsQuery->ttl );
+        }
+    #else
+        ( void ) pModuleContext;
+    #endif /* CELLULAR_BG96_DNS_CACHE_ENTRIES. */
 
-    if( cellularStatus != CELLULAR_SUCCESS )
-    {
-        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
-    }
-    else if( pDnsServerAddress == NULL )
+    if( pDnsQuery->callback != NULL )
     {
-        LogError( ( "Cellular_SetDns: Invalid parameter" ) );
-        cellularStatus = CELLULAR_BAD_PARAMETER;
+        if( dnsStatus == CELLULAR_SUCCESS )
+        {
+            addressesNum = copyDnsAddresses( &pDnsQuery->addressList, addresses, ( uint8_t ) CELLULAR_BG96_DNS_MAX_ADDRESSES );
+            pDnsQuery->callback( pDnsQuery->sequence, dnsStatus, addresses, addressesNum, pDnsQuery->pCallbackContext );
+        }
+        else
+        {
+            pDnsQuery->callback( pDnsQuery->sequence, dnsStatus, NULL, 0, pDnsQuery->pCallbackContext );
+        }
     }
-    else
+}
+
+/*-----------------------------------------------------------*/
+
+/* Asynchronous queries have no waiting task to detect the timeout. They are
+ * expired when the next DNS query or result is handled. The slot is orphaned
+ * so that the late results still match their query. An orphaned slot is freed
+ * if no result is received within another DNS query timeout, otherwise a lost
+ * URC line would shift the results of all the following queries. */
+static void dnsQueryExpire( cellularModuleContext_t * pModuleContext )
+{
+    cellularDnsQuery_t expiredQuery;
+    bool queryExpired = true;
+    uint32_t i = 0;
+
+    PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+    for( i = 0; i < CELLULAR_BG96_DNS_QUERY_SLOTS; i++ )
     {
-        cellularStatus = _Cellular_IsValidPdn( contextId );
+        if( ( pModuleContext->dnsQueries[ i ].state == CELLULAR_DNS_QUERY_STATE_ORPHANED ) &&
+            ( ( xTaskGetTickCount() - pModuleContext->dnsQueries[ i ].startTick ) >= pdMS_TO_TICKS( DNS_QUERY_TIMEOUT_MS ) ) )
+        {
+            LogDebug( ( "dnsQueryExpire: request %u result lost", ( unsigned int ) pModuleContext->dnsQueries[ i ].sequence ) );
+            pModuleContext->dnsQueries[ i ].state = CELLULAR_DNS_QUERY_STATE_FREE;
+        }
     }
 
-    if( cellularStatus == CELLULAR_SUCCESS )
+    PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+    while( queryExpired == true )
     {
-        /* Form the AT command. */
+        queryExpired = false;
 
-        /* The return value of snprintf is not used.
-         * The max length of the string is fixed and checked offline. */
-        ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_MAX_SIZE, "%s%d,\"%s\"", "AT+QIDNSCFG=", contextId, pDnsServerAddress );
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqSetDns );
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        for( i = 0; i < CELLULAR_BG96_DNS_QUERY_SLOTS; i++ )
         {
-            LogError( ( "Cellular_SetDns: couldn't set the DNS, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            if( ( pModuleContext->dnsQueries[ i ].state == CELLULAR_DNS_QUERY_STATE_WAITING ) &&
+                ( pModuleContext->dnsQueries[ i ].asyncQuery == true ) &&
+                ( ( xTaskGetTickCount() - pModuleContext->dnsQueries[ i ].startTick ) >= pdMS_TO_TICKS( DNS_QUERY_TIMEOUT_MS ) ) )
+            {
+                expiredQuery = pModuleContext->dnsQueries[ i ];
+                expiredQuery.result = CELLULAR_DNS_QUERY_UNKNOWN;
+                pModuleContext->dnsQueries[ i ].state = CELLULAR_DNS_QUERY_STATE_ORPHANED;
+                pModuleContext->dnsQueries[ i ].startTick = xTaskGetTickCount();
+                pModuleContext->dnsQueries[ i ].callback = NULL;
+                queryExpired = true;
+                break;
+            }
         }
-    }
 
-    return cellularStatus;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        if( queryExpired == true )
+        {
+            LogDebug( ( "dnsQueryExpire: request %u timeout", ( unsigned int ) expiredQuery.sequence ) );
+            dnsQueryReportAsync( pModuleContext, &expiredQuery, CELLULAR_TIMEOUT );
+        }
+    }
 }
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_GetPsmSettings( CellularHandle_t cellularHandle,
-                                         CellularPsmSettings_t * pPsmSettings )
+/* Parse +QIURC: "dnsgip",<err>,<IP_count>,<DNS_ttl>. */
+static void parseDnsQueryHeader( char * pDnsResult,
+                                 cellularDnsQuery_t * pDnsQuery )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    CellularAtReq_t atReqGetPsm =
-    {
-        "AT+QPSMS?",
-        CELLULAR_AT_WITH_PREFIX,
-        "+QPSMS",
-        _Cellular_RecvFuncGetPsmSettings,
-        pPsmSettings,
-        sizeof( CellularPsmSettings_t ),
-    };
+    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+    char * pToken = NULL, * pDnsResultStr = pDnsResult;
+    int32_t dnsResultNumber = 0, dnsError = 0, dnsTtl = 0;
+    cellularDnsQueryResult_t dnsQueryResult = CELLULAR_DNS_QUERY_UNKNOWN;
 
-    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+    atCoreStatus = Cellular_ATGetNextTok( &pDnsResultStr, &pToken );
 
-    if( cellularStatus != CELLULAR_SUCCESS )
+    if( atCoreStatus == CELLULAR_AT_SUCCESS )
     {
-        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+        atCoreStatus = Cellular_ATStrtoi( pToken, 10, &dnsError );
     }
-    else if( pPsmSettings == NULL )
+
+    if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( dnsError != 0 ) )
     {
-        cellularStatus = CELLULAR_BAD_PARAMETER;
+        /* The modem reports the error without IP count. */
+        LogDebug( ( "_dnsResultCallback DNS query failed %d", ( int ) dnsError ) );
+        dnsQueryResult = CELLULAR_DNS_QUERY_FAILED;
     }
-    else
+
+    if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( dnsQueryResult == CELLULAR_DNS_QUERY_UNKNOWN ) )
     {
-        /* initialize the data. */
-        ( void ) memset( pPsmSettings, 0, sizeof( CellularPsmSettings_t ) );
-        pPsmSettings->mode = 0xFF;
+        atCoreStatus = Cellular_ATGetNextTok( &pDnsResultStr, &pToken );
+    }
 
-        /* we should always query the PSMsettings from the network. */
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetPsm );
+    if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( dnsQueryResult == CELLULAR_DNS_QUERY_UNKNOWN ) )
+    {
+        atCoreStatus = Cellular_ATStrtoi( pToken, 10, &dnsResultNumber );
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( dnsResultNumber > 0 ) &&
+            ( dnsResultNumber <= ( int32_t ) UINT8_MAX ) )
         {
-            LogError( ( "Cellular_GetPsmSettings: couldn't retrieve PSM settings" ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            pDnsQuery->resultNumber = ( uint8_t ) dnsResultNumber;
         }
-    }
-
-    return cellularStatus;
-}
-
-/*-----------------------------------------------------------*/
-
-static uint32_t appendBinaryPattern( char * cmdBuf,
-                                     uint32_t cmdLen,
-                                     uint32_t value,
-                                     bool endOfString )
-{
-    uint32_t retLen = 0;
-
-    if( cmdBuf != NULL )
-    {
-        if( value != 0U )
+        else if( atCoreStatus == CELLULAR_AT_SUCCESS )
         {
-            /* The return value of snprintf is not used.
-             * The max length of the string is fixed and checked offline. */
-            ( void ) snprintf( cmdBuf, cmdLen, "\"" PRINTF_BINARY_PATTERN_INT8 "\"%c",
-                               PRINTF_BYTE_TO_BINARY_INT8( value ), endOfString ? '\0' : ',' );
+            /* No address will be reported. */
+            dnsQueryResult = CELLULAR_DNS_QUERY_FAILED;
         }
         else
         {
-            /* The return value of snprintf is not used.
-             * The max length of the string is fixed and checked offline. */
-            ( void ) snprintf( cmdBuf, cmdLen, "%c", endOfString ? '\0' : ',' );
+            LogDebug( ( "_dnsResultCallback convert string failed %s", pToken ) );
         }
-
-        retLen = strlen( cmdBuf );
     }
 
-    return retLen;
-}
-
-/*-----------------------------------------------------------*/
-
-static CellularPktStatus_t socketSendDataPrefix( void * pCallbackContext,
-                                                 char * pLine,
-                                                 uint32_t * pBytesRead )
-{
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-
-    if( ( pLine == NULL ) || ( pBytesRead == NULL ) )
+    /* The TTL is optional. The result is not cached without TTL. */
+    if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( dnsQueryResult == CELLULAR_DNS_QUERY_UNKNOWN ) &&
+        ( pDnsResultStr != NULL ) )
     {
-        LogError( ( "socketSendDataPrefix: pLine is invalid or pBytesRead is invalid" ) );
-        pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
+        if( ( Cellular_ATGetNextTok( &pDnsResultStr, &pToken ) == CELLULAR_AT_SUCCESS ) &&
+            ( Cellular_ATStrtoi( pToken, 10, &dnsTtl ) == CELLULAR_AT_SUCCESS ) )
+        {
+            if( dnsTtl > 0 )
+            {
+                pDnsQuery->ttl = ( uint32_t ) dnsTtl;
+            }
+        }
     }
-    else if( pCallbackContext != NULL )
+
+    if( atCoreStatus != CELLULAR_AT_SUCCESS )
     {
-        LogError( ( "socketSendDataPrefix: pCallbackContext is not NULL" ) );
-        pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
+        /* The address lines that may follow can't be counted. The header is
+         * garbled, so the failure is not cached. */
+        LogDebug( ( "_dnsResultCallback parse DNS result header failed" ) );
+        dnsQueryComplete( pDnsQuery, CELLULAR_DNS_QUERY_UNKNOWN );
     }
-    else if( *pBytesRead != 2U )
+    else if( dnsQueryResult == CELLULAR_DNS_QUERY_FAILED )
     {
-        LogDebug( ( "socketSendDataPrefix: pBytesRead %u %s is not 1", *pBytesRead, pLine ) );
+        dnsQueryComplete( pDnsQuery, dnsQueryResult );
     }
     else
     {
-        /* After the data prefix, there should not be any data in stream.
-         * Cellular commmon processes AT command in lines. Add a '\0' after '>'. */
-        if( strcmp( pLine, "> " ) == 0 )
-        {
-            pLine[ 1 ] = '\n';
-        }
+        /* Empty else MISRA 15.7 */
     }
-
-    return pktStatus;
 }
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_SetPsmSettings( CellularHandle_t cellularHandle,
-                                         const CellularPsmSettings_t * pPsmSettings )
+/* An address line holds an IPv4 or an IPv6 address. A header line has commas
+ * or no separator at all. */
+static bool isDnsAddressLine( const char * pDnsResult )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
-    uint32_t cmdBufLen = 0;
-    CellularAtReq_t atReqSetPsm =
+    bool addressLine = false;
+    bool separatorFound = false;
+    uint32_t i = 0;
+
+    if( pDnsResult != NULL )
     {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0
-    };
+        addressLine = true;
 
-    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+        for( i = 0; pDnsResult[ i ] != '\0'; i++ )
+        {
+            if( ( pDnsResult[ i ] == '.' ) || ( pDnsResult[ i ] == ':' ) )
+            {
+                separatorFound = true;
+            }
+            else if( ( ( pDnsResult[ i ] < '0' ) || ( pDnsResult[ i ] > '9' ) ) &&
+                     ( ( pDnsResult[ i ] < 'a' ) || ( pDnsResult[ i ] > 'f' ) ) &&
+                     ( ( pDnsResult[ i ] < 'A' ) || ( pDnsResult[ i ] > 'F' ) ) )
+            {
+                addressLine = false;
+            }
+            else
+            {
+                /* Empty else MISRA 15.7 */
+            }
+        }
 
-    if( cellularStatus != CELLULAR_SUCCESS )
-    {
-        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+        if( ( separatorFound == false ) || ( i > CELLULAR_IP_ADDRESS_MAX_SIZE ) )
+        {
+            addressLine = false;
+        }
     }
-    else if( pPsmSettings == NULL )
+
+    return addressLine;
+}
+
+/*-----------------------------------------------------------*/
+
+static void _dnsResultCallback( cellularModuleContext_t * pModuleContext,
+                                char * pDnsResult )
+{
+    cellularDnsQuery_t * pDnsQuery = NULL;
+    cellularDnsQuery_t completedQuery;
+    bool asyncCompleted = false;
+    bool queryOrphaned = false;
+    bool addressLine = false;
+    bool lineConsumed = false;
+
+    if( pModuleContext != NULL )
     {
-        cellularStatus = CELLULAR_BAD_PARAMETER;
+        dnsQueryExpire( pModuleContext );
+        addressLine = isDnsAddressLine( pDnsResult );
     }
-    else
+
+    /* A header line which ends the addresses of a query early is parsed again
+     * for the next query. */
+    while( ( pModuleContext != NULL ) && ( lineConsumed == false ) )
     {
-        /* Form the AT command. */
+        lineConsumed = true;
+        asyncCompleted = false;
+        queryOrphaned = false;
 
-        /* The return value of snprintf is not used.
-         * The max length of the string is fixed and checked offline. */
-        ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_MAX_SIZE, "AT+QPSMS=%d,", pPsmSettings->mode );
-        cmdBufLen = strlen( cmdBuf );
-        cmdBufLen = cmdBufLen + appendBinaryPattern( &cmdBuf[ cmdBufLen ], ( CELLULAR_AT_CMD_MAX_SIZE - cmdBufLen ),
-                                                     pPsmSettings->periodicRauValue, false );
-        cmdBufLen = cmdBufLen + appendBinaryPattern( &cmdBuf[ cmdBufLen ], ( CELLULAR_AT_CMD_MAX_SIZE - cmdBufLen ),
-                                                     pPsmSettings->gprsReadyTimer, false );
-        cmdBufLen = cmdBufLen + appendBinaryPattern( &cmdBuf[ cmdBufLen ], ( CELLULAR_AT_CMD_MAX_SIZE - cmdBufLen ),
-                                                     pPsmSettings->periodicTauValue, false );
-        cmdBufLen = cmdBufLen + appendBinaryPattern( &cmdBuf[ cmdBufLen ], ( CELLULAR_AT_CMD_MAX_SIZE - cmdBufLen ),
-                                                     pPsmSettings->activeTimeValue, true );
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
 
-        LogDebug( ( "PSM setting: %s ", cmdBuf ) );
+        /* The modem reports the DNS results in the order of the queries. */
+        pDnsQuery = dnsQueryOldestWaiting( pModuleContext );
 
-        if( cmdBufLen < CELLULAR_AT_CMD_MAX_SIZE )
+        if( pDnsQuery != NULL )
         {
-            /* we should always query the PSMsettings from the network. */
-            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqSetPsm );
+            queryOrphaned = ( pDnsQuery->state == CELLULAR_DNS_QUERY_STATE_ORPHANED ) ? true : false;
+        }
 
-            if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        if( pDnsQuery == NULL )
+        {
+            LogDebug( ( "_dnsResultCallback spurious DNS response" ) );
+        }
+        else if( pDnsQuery->resultNumber == ( uint8_t ) 0 )
+        {
+            if( addressLine == false )
             {
-                LogError( ( "Cellular_SetPsmSettings: couldn't set PSM settings" ) );
-                cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+                pModuleContext->dnsHeaderLost = false;
+                parseDnsQueryHeader( pDnsResult, pDnsQuery );
+            }
+            else if( pModuleContext->dnsHeaderLost == false )
+            {
+                /* The header of the oldest query is lost. Its addresses are
+                 * discarded until the header of the next query. */
+                LogDebug( ( "_dnsResultCallback DNS address without header" ) );
+                dnsQueryComplete( pDnsQuery, CELLULAR_DNS_QUERY_UNKNOWN );
+                pModuleContext->dnsHeaderLost = true;
+            }
+            else
+            {
+                LogDebug( ( "_dnsResultCallback DNS address discarded" ) );
+            }
+        }
+        else if( addressLine == false )
+        {
+            /* An address line is lost. This line is the header of the next query. */
+            LogDebug( ( "_dnsResultCallback DNS address missing" ) );
+            dnsQueryComplete( pDnsQuery, CELLULAR_DNS_QUERY_UNKNOWN );
+            lineConsumed = false;
+        }
+        else if( pDnsQuery->resultIndex < pDnsQuery->resultNumber )
+        {
+            if( pDnsQuery->addressList.addressCount < CELLULAR_BG96_DNS_MAX_ADDRESSES )
+            {
+                ( void ) strncpy( pDnsQuery->addressList.addresses[ pDnsQuery->addressList.addressCount ],
+                                  pDnsResult, CELLULAR_IP_ADDRESS_MAX_SIZE );
+                pDnsQuery->addressList.addressCount++;
+            }
+
+            pDnsQuery->resultIndex = pDnsQuery->resultIndex + ( uint8_t ) 1;
+
+            /* Consume all the addresses before the next query is matched. */
+            if( pDnsQuery->resultIndex == pDnsQuery->resultNumber )
+            {
+                dnsQueryComplete( pDnsQuery, CELLULAR_DNS_QUERY_SUCCESS );
             }
         }
         else
         {
-            cellularStatus = CELLULAR_NO_MEMORY;
+            LogDebug( ( "_dnsResultCallback spurious DNS response" ) );
         }
-    }
 
-    return cellularStatus;
+        /* Free the slot of a completed asynchronous query before the callback.
+         * The late result of an orphaned query is discarded. It is not cached,
+         * as it can't be told from the result of another query if a URC line
+         * was lost. */
+        if( ( pDnsQuery != NULL ) && ( pDnsQuery->state == CELLULAR_DNS_QUERY_STATE_DONE ) )
+        {
+            if( queryOrphaned == true )
+            {
+                pDnsQuery->state = CELLULAR_DNS_QUERY_STATE_FREE;
+            }
+            else if( pDnsQuery->asyncQuery == true )
+            {
+                completedQuery = *pDnsQuery;
+                pDnsQuery->state = CELLULAR_DNS_QUERY_STATE_FREE;
+                asyncCompleted = true;
+            }
+            else
+            {
+                /* The waiting task frees the slot of a blocking query. */
+            }
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        if( asyncCompleted == true )
+        {
+            dnsQueryReportAsync( pModuleContext, &completedQuery,
+                                 ( completedQuery.result == CELLULAR_DNS_QUERY_SUCCESS ) ? CELLULAR_SUCCESS : CELLULAR_UNKNOWN );
+        }
+    }
 }
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_DeactivatePdn( CellularHandle_t cellularHandle,
-                                        uint8_t contextId )
-{
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
-    CellularAtReq_t atReqDeactPdn =
+#if ( CELLULAR_BG96_DNS_CACHE_ENTRIES > 0U )
+
+/* The caller must hold stateMutex. */
+    static cellularDnsCacheEntry_t * dnsCacheFind( cellularModuleContext_t * pModuleContext,
+                                                   uint8_t contextId,
+                                                   const char * pcHostName )
     {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0,
-    };
+        cellularDnsCacheEntry_t * pEntry = NULL;
+        uint32_t i = 0;
 
-    cellularStatus = _Cellular_IsValidPdn( contextId );
+        for( i = 0; i < CELLULAR_BG96_DNS_CACHE_ENTRIES; i++ )
+        {
+            if( ( pModuleContext->dnsCache[ i ].contextId == contextId ) &&
+                ( strcmp( pModuleContext->dnsCache[ i ].hostName, pcHostName ) == 0 ) )
+            {
+                pEntry = &pModuleContext->dnsCache[ i ];
+                break;
+            }
+        }
 
-    if( cellularStatus == CELLULAR_SUCCESS )
-    {
-        /* Make sure the library is open. */
-        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+        return pEntry;
     }
 
-    if( cellularStatus == CELLULAR_SUCCESS )
+/*-----------------------------------------------------------*/
+
+/* Count the hit of a positive entry. Returns true if the entry is hot and about
+ * to expire. The entry is then queued to the refresh thread. The caller must
+ * hold stateMutex. */
+    static bool dnsCacheHit( cellularDnsCacheEntry_t * pEntry )
     {
-        /* Form the AT command. */
+        bool refreshAhead = false;
+        TickType_t currentTick = xTaskGetTickCount();
 
-        /* The return value of snprintf is not used.
-         * The max length of the string is fixed and checked offline. */
-        ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE, "%s%d", "AT+QIDEACT=", contextId );
-        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqDeactPdn, PDN_DEACTIVATION_PACKET_REQ_TIMEOUT_MS );
+        if( ( currentTick - pEntry->hitWindowTick ) >= pdMS_TO_TICKS( CELLULAR_BG96_DNS_REFRESH_AHEAD_WINDOW_MS ) )
+        {
+            pEntry->hitWindowTick = currentTick;
+            pEntry->hitCount = 0;
+        }
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        if( pEntry->hitCount < UINT16_MAX )
         {
-            LogError( ( "Cellular_DeactivatePdn: can't deactivate PDN, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            pEntry->hitCount++;
         }
-    }
 
-    return cellularStatus;
-}
+        #if ( CELLULAR_BG96_DNS_REFRESH_AHEAD_HITS > 0U )
+            if( ( pEntry->hitCount >= CELLULAR_BG96_DNS_REFRESH_AHEAD_HITS ) &&
+                ( pEntry->refreshPending == false ) &&
+                ( ( pEntry->ttlTicks - ( currentTick - pEntry->insertTick ) ) <= pdMS_TO_TICKS( CELLULAR_BG96_DNS_REFRESH_AHEAD_MS ) ) )
+            {
+                pEntry->refreshPending = true;
+                pEntry->refreshQueued = true;
+                refreshAhead = true;
+            }
+        #endif /* CELLULAR_BG96_DNS_REFRESH_AHEAD_HITS. */
+
+        return refreshAhead;
+    }
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_ActivatePdn( CellularHandle_t cellularHandle,
-                                      uint8_t contextId )
+    static cellularDnsQueryResult_t dnsCacheLookup( cellularModuleContext_t * pModuleContext,
+                                                    uint8_t contextId,
+                                                    const char * pcHostName,
+                                                    cellularDnsAddressList_t * pAddressList,
+                                                    bool * pRefreshAhead )
+    {
+        cellularDnsQueryResult_t dnsQueryResult = CELLULAR_DNS_QUERY_UNKNOWN;
+        cellularDnsCacheEntry_t * pEntry = NULL;
+
+        *pRefreshAhead = false;
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+        pEntry = dnsCacheFind( pModuleContext, contextId, pcHostName );
+
+        if( pEntry == NULL )
+        {
+            /* Cache miss. */
+        }
+        else if( ( xTaskGetTickCount() - pEntry->insertTick ) >= pEntry->ttlTicks )
+        {
+            /* The entry is expired. */
+            ( void ) memset( pEntry, 0, sizeof( cellularDnsCacheEntry_t ) );
+        }
+        else
+        {
+            pModuleContext->dnsCacheUseCount++;
+            pEntry->lastUsed = pModuleContext->dnsCacheUseCount;
+            dnsQueryResult = pEntry->result;
+
+            if( dnsQueryResult == CELLULAR_DNS_QUERY_SUCCESS )
+            {
+                *pAddressList = pEntry->addressList;
+                *pRefreshAhead = dnsCacheHit( pEntry );
+            }
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        return dnsQueryResult;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* A NULL pAddressList stores a negative entry. */
+    static void dnsCacheStore( cellularModuleContext_t * pModuleContext,
+                               uint8_t contextId,
+                               const char * pcHostName,
+                               const cellularDnsAddressList_t * pAddressList,
+                               uint32_t ttlMs )
+    {
+        cellularDnsCacheEntry_t * pEntry = NULL;
+        uint16_t hitCount = 0;
+        TickType_t hitWindowTick = xTaskGetTickCount();
+        uint32_t i = 0;
+
+        if( ( ttlMs > 0U ) && ( strlen( pcHostName ) <= CELLULAR_BG96_DNS_CACHE_HOSTNAME_MAX_SIZE ) )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            pEntry = dnsCacheFind( pModuleContext, contextId, pcHostName );
+
+            /* A refreshed host name stays hot. */
+            if( pEntry != NULL )
+            {
+                hitCount = pEntry->hitCount;
+                hitWindowTick = pEntry->hitWindowTick;
+            }
+
+            /* Replace a free entry or the least recently used entry. */
+            for( i = 0; ( pEntry == NULL ) && ( i < CELLULAR_BG96_DNS_CACHE_ENTRIES ); i++ )
+            {
+                if( pModuleContext->dnsCache[ i ].contextId == 0U )
+                {
+                    pEntry = &pModuleContext->dnsCache[ i ];
+                }
+            }
+
+            if( pEntry == NULL )
+            {
+                pEntry = &pModuleContext->dnsCache[ 0 ];
+
+                for( i = 1; i < CELLULAR_BG96_DNS_CACHE_ENTRIES; i++ )
+                {
+                    /* Wrap around safe comparison of the LRU stamps. */
+                    if( ( pEntry->lastUsed - pModuleContext->dnsCache[ i ].lastUsed ) < ( UINT32_MAX / 2U ) )
+                    {
+                        pEntry = &pModuleContext->dnsCache[ i ];
+                    }
+                }
+            }
+
+            ( void ) memset( pEntry, 0, sizeof( cellularDnsCacheEntry_t ) );
+            pEntry->contextId = contextId;
+            ( void ) strncpy( pEntry->hostName, pcHostName, CELLULAR_BG96_DNS_CACHE_HOSTNAME_MAX_SIZE );
+
+            if( pAddressList != NULL )
+            {
+                pEntry->addressList = *pAddressList;
+                pEntry->result = CELLULAR_DNS_QUERY_SUCCESS;
+            }
+            else
+            {
+                pEntry->result = CELLULAR_DNS_QUERY_FAILED;
+            }
+
+            pEntry->insertTick = xTaskGetTickCount();
+            pEntry->ttlTicks = pdMS_TO_TICKS( ttlMs );
+            pModuleContext->dnsCacheUseCount++;
+            pEntry->lastUsed = pModuleContext->dnsCacheUseCount;
+            pEntry->hitCount = hitCount;
+            pEntry->hitWindowTick = hitWindowTick;
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void dnsCacheStoreResult( cellularModuleContext_t * pModuleContext,
+                                     uint8_t contextId,
+                                     const char * pcHostName,
+                                     cellularDnsQueryResult_t dnsQueryResult,
+                                     const cellularDnsAddressList_t * pAddressList,
+                                     uint32_t dnsTtl )
+    {
+        uint32_t ttlSeconds = dnsTtl;
+
+        if( dnsQueryResult == CELLULAR_DNS_QUERY_SUCCESS )
+        {
+            if( ttlSeconds > CELLULAR_BG96_DNS_CACHE_MAX_TTL_S )
+            {
+                ttlSeconds = CELLULAR_BG96_DNS_CACHE_MAX_TTL_S;
+            }
+
+            dnsCacheStore( pModuleContext, contextId, pcHostName, pAddressList, ttlSeconds * 1000U );
+        }
+        else if( dnsQueryResult == CELLULAR_DNS_QUERY_FAILED )
+        {
+            /* Only failures reported by the modem are cached. */
+            dnsCacheStore( pModuleContext, contextId, pcHostName, NULL, CELLULAR_BG96_DNS_CACHE_NEGATIVE_TTL_MS );
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
+    }
+
+/*-----------------------------------------------------------*/
+
+/* The result of a refresh is handled by dnsQueryReportAsync. */
+    static void dnsRefreshCallback( uint32_t requestId,
+                                    CellularError_t dnsStatus,
+                                    const CellularIPAddress_t * pAddresses,
+                                    uint8_t addressesNum,
+                                    void * pCallbackContext )
+    {
+        ( void ) pAddresses;
+        ( void ) addressesNum;
+        ( void ) pCallbackContext;
+
+        LogDebug( ( "dnsRefreshCallback: request %u status %d", ( unsigned int ) requestId, dnsStatus ) );
+    }
+
+/*-----------------------------------------------------------*/
+
+/* The refresh is sent again on the next cache hit. */
+    static void dnsRefreshFailed( cellularModuleContext_t * pModuleContext,
+                                  uint8_t contextId,
+                                  const char * pcHostName )
+    {
+        cellularDnsCacheEntry_t * pEntry = NULL;
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        pEntry = dnsCacheFind( pModuleContext, contextId, pcHostName );
+
+        if( pEntry != NULL )
+        {
+            pEntry->refreshPending = false;
+            pEntry->refreshQueued = false;
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Send the refresh of the queued entries. AT+QIDNSGIP is sent by this thread so
+ * that the caller of a cache hit doesn't wait for the modem. */
+    static void dnsRefreshThread( void * pUserData )
+    {
+        cellularModuleContext_t * pModuleContext = ( cellularModuleContext_t * ) pUserData;
+        PlatformEventGroup_EventBits uxBits = 0;
+        CellularContext_t * pContext = NULL;
+        CellularError_t cellularStatus = CELLULAR_SUCCESS;
+        cellularDnsQuery_t * pDnsQuery = NULL;
+        uint32_t requestId = 0;
+        uint8_t contextId = 0;
+        char hostName[ CELLULAR_BG96_DNS_CACHE_HOSTNAME_MAX_SIZE + 1U ];
+        bool refreshQueued = false;
+        uint32_t i = 0;
+
+        for( ; ; )
+        {
+            uxBits = PlatformEventGroup_WaitBits( pModuleContext->dnsRefreshEvent, DNS_REFRESH_EVT_PENDING | DNS_REFRESH_EVT_STOP,
+                                                  pdTRUE, pdFALSE, portMAX_DELAY );
+
+            if( ( uxBits & DNS_REFRESH_EVT_STOP ) != 0U )
+            {
+                break;
+            }
+
+            do
+            {
+                refreshQueued = false;
+                PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+                for( i = 0; i < CELLULAR_BG96_DNS_CACHE_ENTRIES; i++ )
+                {
+                    if( pModuleContext->dnsCache[ i ].refreshQueued == true )
+                    {
+                        pModuleContext->dnsCache[ i ].refreshQueued = false;
+                        contextId = pModuleContext->dnsCache[ i ].contextId;
+                        ( void ) strncpy( hostName, pModuleContext->dnsCache[ i ].hostName, sizeof( hostName ) );
+                        pContext = ( CellularContext_t * ) pModuleContext->dnsRefreshCellularHandle;
+                        refreshQueued = true;
+                        break;
+                    }
+                }
+
+                PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+                if( refreshQueued == true )
+                {
+                    cellularStatus = sendDnsQuery( pContext, pModuleContext, contextId, hostName,
+                                                   dnsRefreshCallback, NULL, &pDnsQuery, &requestId );
+
+                    if( cellularStatus != CELLULAR_SUCCESS )
+                    {
+                        LogDebug( ( "dnsRefreshThread: %s refresh fail %d", hostName, cellularStatus ) );
+                        dnsRefreshFailed( pModuleContext, contextId, hostName );
+                    }
+                }
+            } while( refreshQueued == true );
+        }
+
+        ( void ) PlatformEventGroup_SetBits( pModuleContext->dnsRefreshEvent, DNS_REFRESH_EVT_THREAD_STOPPED );
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Wake up the refresh thread, starting it on the first refresh. The cached
+ * addresses are used until the result of the refresh is received. */
+    static void dnsRefreshAhead( CellularContext_t * pContext,
+                                 cellularModuleContext_t * pModuleContext )
+    {
+        bool startThread = false;
+        bool threadStarted = true;
+        uint32_t i = 0;
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        pModuleContext->dnsRefreshCellularHandle = ( CellularHandle_t ) pContext;
+        startThread = ( pModuleContext->dnsRefreshThreadStarted == false );
+        pModuleContext->dnsRefreshThreadStarted = true;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        if( startThread == true )
+        {
+            pModuleContext->dnsRefreshEvent = PlatformEventGroup_Create();
+
+            if( pModuleContext->dnsRefreshEvent == NULL )
+            {
+                threadStarted = false;
+            }
+            else if( Platform_CreateDetachedThread( dnsRefreshThread, pModuleContext, CELLULAR_BG96_DNS_REFRESH_THREAD_PRIORITY,
+                                                    CELLULAR_BG96_DNS_REFRESH_THREAD_STACK_SIZE ) == false )
+            {
+                PlatformEventGroup_Delete( pModuleContext->dnsRefreshEvent );
+                pModuleContext->dnsRefreshEvent = NULL;
+                threadStarted = false;
+            }
+            else
+            {
+                /* Empty else MISRA 15.7 */
+            }
+        }
+
+        if( threadStarted == true )
+        {
+            ( void ) PlatformEventGroup_SetBits( pModuleContext->dnsRefreshEvent, DNS_REFRESH_EVT_PENDING );
+        }
+        else
+        {
+            /* Retry on the next cache hit. */
+            LogWarn( ( "dnsRefreshAhead: the refresh thread can't be started" ) );
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pModuleContext->dnsRefreshThreadStarted = false;
+
+            for( i = 0; i < CELLULAR_BG96_DNS_CACHE_ENTRIES; i++ )
+            {
+                if( pModuleContext->dnsCache[ i ].refreshQueued == true )
+                {
+                    pModuleContext->dnsCache[ i ].refreshQueued = false;
+                    pModuleContext->dnsCache[ i ].refreshPending = false;
+                }
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    }
+
+#endif /* CELLULAR_BG96_DNS_CACHE_ENTRIES. */
+
+/*-----------------------------------------------------------*/
+
+/* The DNS results of a PDN context are not valid after it is deactivated. A
+ * contextId of 0 flushes the entries of all PDN contexts. */
+void _Cellular_DnsCacheFlush( cellularModuleContext_t * pModuleContext,
+                              uint8_t contextId )
+{
+    #if ( CELLULAR_BG96_DNS_CACHE_ENTRIES > 0U )
+        uint32_t i = 0;
+
+        if( pModuleContext != NULL )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            for( i = 0; i < CELLULAR_BG96_DNS_CACHE_ENTRIES; i++ )
+            {
+                if( ( contextId == 0U ) || ( pModuleContext->dnsCache[ i ].contextId == contextId ) )
+                {
+                    ( void ) memset( &pModuleContext->dnsCache[ i ], 0, sizeof( cellularDnsCacheEntry_t ) );
+                }
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pModuleContext;
+        ( void ) contextId;
+    #endif /* CELLULAR_BG96_DNS_CACHE_ENTRIES. */
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_DnsRefreshCleanup( cellularModuleContext_t * pModuleContext )
+{
+    #if ( CELLULAR_BG96_DNS_CACHE_ENTRIES > 0U )
+        bool threadStarted = false;
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        threadStarted = ( pModuleContext->dnsRefreshEvent != NULL );
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        if( threadStarted == true )
+        {
+            ( void ) PlatformEventGroup_SetBits( pModuleContext->dnsRefreshEvent, DNS_REFRESH_EVT_STOP );
+            ( void ) PlatformEventGroup_WaitBits( pModuleContext->dnsRefreshEvent, DNS_REFRESH_EVT_THREAD_STOPPED,
+                                                  pdTRUE, pdFALSE, portMAX_DELAY );
+
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pModuleContext->dnsRefreshThreadStarted = false;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+            PlatformEventGroup_Delete( pModuleContext->dnsRefreshEvent );
+            pModuleContext->dnsRefreshEvent = NULL;
+        }
+    #else
+        ( void ) pModuleContext;
+    #endif /* CELLULAR_BG96_DNS_CACHE_ENTRIES. */
+}
+
+/*-----------------------------------------------------------*/
+
+/* The modem drops the DNS queries when it restarts. Their results will never
+ * be received. */
+void _Cellular_DnsQueryAbort( cellularModuleContext_t * pModuleContext )
+{
+    cellularDnsQuery_t abortedQuery;
+    bool queryAborted = true;
+    uint32_t i = 0;
+
+    while( ( pModuleContext != NULL ) && ( queryAborted == true ) )
+    {
+        queryAborted = false;
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+        pModuleContext->dnsHeaderLost = false;
+
+        for( i = 0; i < CELLULAR_BG96_DNS_QUERY_SLOTS; i++ )
+        {
+            if( pModuleContext->dnsQueries[ i ].state == CELLULAR_DNS_QUERY_STATE_ORPHANED )
+            {
+                pModuleContext->dnsQueries[ i ].state = CELLULAR_DNS_QUERY_STATE_FREE;
+            }
+            else if( pModuleContext->dnsQueries[ i ].state == CELLULAR_DNS_QUERY_STATE_WAITING )
+            {
+                /* The waiting task frees the slot of a blocking query. */
+                dnsQueryComplete( &pModuleContext->dnsQueries[ i ], CELLULAR_DNS_QUERY_UNKNOWN );
+
+                if( pModuleContext->dnsQueries[ i ].asyncQuery == true )
+                {
+                    abortedQuery = pModuleContext->dnsQueries[ i ];
+                    pModuleContext->dnsQueries[ i ].state = CELLULAR_DNS_QUERY_STATE_FREE;
+                    queryAborted = true;
+                    break;
+                }
+            }
+            else
+            {
+                /* Empty else MISRA 15.7 */
+            }
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        if( queryAborted == true )
+        {
+            dnsQueryReportAsync( pModuleContext, &abortedQuery, CELLULAR_UNKNOWN );
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* The IP address of an activated PDN context is only known from AT+QIACT?. The
+ * modem may also activate the default bearer context when it attaches. */
+void _Cellular_PdnStatusInvalidate( cellularModuleContext_t * pModuleContext )
+{
+    if( pModuleContext != NULL )
+    {
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        pModuleContext->pdnStatusValid = false;
+        pModuleContext->pdnStatusGeneration++;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_PdnStatusDeactivated( cellularModuleContext_t * pModuleContext,
+                                     uint8_t contextId )
+{
+    if( ( pModuleContext != NULL ) && ( _Cellular_IsValidPdn( contextId ) == CELLULAR_SUCCESS ) )
+    {
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        ( void ) memset( &pModuleContext->pdnStatus[ contextId - CELLULAR_PDN_CONTEXT_ID_MIN ], 0,
+                         sizeof( CellularPdnStatus_t ) );
+        pModuleContext->pdnStatusGeneration++;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t sendDnsQuery( CellularContext_t * pContext,
+                                     cellularModuleContext_t * pModuleContext,
+                                     uint8_t contextId,
+                                     const char * pcHostName,
+                                     CellularBG96DnsResultCallback_t dnsResultCallback,
+                                     void * pCallbackContext,
+                                     cellularDnsQuery_t ** ppDnsQuery,
+                                     uint32_t * pRequestId )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
-
-    CellularAtReq_t atReqActPdn =
+    cellularDnsQuery_t * pDnsQuery = NULL;
+    char * cmdBuf = NULL;
+    cellularAtBuilder_t cmdBuilder;
+    CellularAtReq_t atReqQueryDns =
     {
-        cmdBuf,
+        NULL,
         CELLULAR_AT_NO_RESULT,
         NULL,
         NULL,
@@ -2448,28 +3265,1792 @@ CellularError_t Cellular_ActivatePdn( CellularHandle_t cellularHandle,
         0,
     };
 
-    cellularStatus = _Cellular_IsValidPdn( contextId );
+    dnsQueryExpire( pModuleContext );
+
+    /* The command buffer is held from the allocation of the query to the AT
+     * response, which keeps the sequence numbers in the order of the AT commands.
+     * contextMutex is not used here. The pktio thread takes it for direct push
+     * data and would not get to the response. */
+    cmdBuf = _Cellular_CommandBufferAcquire( pModuleContext );
+    atReqQueryDns.pAtCmd = cmdBuf;
+
+    PlatformMutex_Lock( &pModuleContext->stateMutex );
+    pDnsQuery = dnsQueryAllocate( pModuleContext, contextId, pcHostName, dnsResultCallback, pCallbackContext );
+
+    /* An asynchronous query may be completed before the AT command returns. */
+    if( pDnsQuery != NULL )
+    {
+        *pRequestId = pDnsQuery->sequence;
+    }
+
+    PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+    if( pDnsQuery == NULL )
+    {
+        LogWarn( ( "Cellular_GetHostByName: no free DNS query slot" ) );
+        cellularStatus = CELLULAR_NO_MEMORY;
+    }
+    else
+    {
+        cellularStatus = registerDnsEventCallback( pModuleContext, _dnsResultCallback );
+    }
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        /* Make sure the library is open. */
-        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+        _Cellular_AtBuilderInit( &cmdBuilder, cmdBuf, CELLULAR_AT_CMD_QUERY_DNS_MAX_SIZE );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "AT+QIDNSGIP=" );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, contextId );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        _Cellular_AtBuilderAppendQuoted( &cmdBuilder, pcHostName );
+        cellularStatus = _Cellular_AtBuilderStatus( &cmdBuilder );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            _Cellular_RequestLaneAcquire( pModuleContext, CELLULAR_BG96_REQUEST_NORMAL );
+            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqQueryDns );
+            _Cellular_RequestLaneRelease( pModuleContext );
+
+            if( pktStatus != CELLULAR_PKT_STATUS_OK )
+            {
+                LogError( ( "Cellular_GetHostByName: couldn't resolve host name" ) );
+                cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            }
+        }
+
+        if( cellularStatus != CELLULAR_SUCCESS )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pDnsQuery->state = CELLULAR_DNS_QUERY_STATE_FREE;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    }
+
+    _Cellular_CommandBufferRelease( pModuleContext );
+
+    *ppDnsQuery = pDnsQuery;
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t queryHostByName( CellularContext_t * pContext,
+                                        cellularModuleContext_t * pModuleContext,
+                                        uint8_t contextId,
+                                        const char * pcHostName,
+                                        cellularDnsAddressList_t * pAddressList,
+                                        cellularDnsQueryResult_t * pDnsQueryResult,
+                                        uint32_t * pDnsTtl )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularDnsQuery_t * pDnsQuery = NULL;
+    cellularDnsQueryResult_t dnsQueryResult = CELLULAR_DNS_QUERY_UNKNOWN;
+    uint32_t requestId = 0;
+
+    /* Send the AT command and wait the URC result. */
+    cellularStatus = sendDnsQuery( pContext, pModuleContext, contextId, pcHostName,
+                                   NULL, NULL, &pDnsQuery, &requestId );
+
+    /* URC handler calls the callback to unblock this function. */
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        if( xQueueReceive( pDnsQuery->resultQueue, &dnsQueryResult,
+                           pdMS_TO_TICKS( DNS_QUERY_TIMEOUT_MS ) ) != pdTRUE )
+        {
+            cellularStatus = CELLULAR_TIMEOUT;
+        }
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+        /* The result may be received after the queue timeout. */
+        if( pDnsQuery->state == CELLULAR_DNS_QUERY_STATE_DONE )
+        {
+            *pDnsQueryResult = pDnsQuery->result;
+            *pDnsTtl = pDnsQuery->ttl;
+
+            if( pDnsQuery->result == CELLULAR_DNS_QUERY_SUCCESS )
+            {
+                *pAddressList = pDnsQuery->addressList;
+                cellularStatus = CELLULAR_SUCCESS;
+            }
+            else
+            {
+                cellularStatus = CELLULAR_UNKNOWN;
+            }
+
+            pDnsQuery->state = CELLULAR_DNS_QUERY_STATE_FREE;
+        }
+        else
+        {
+            /* The slot is freed by the URC handler once the results are received. */
+            pDnsQuery->state = CELLULAR_DNS_QUERY_STATE_ORPHANED;
+            pDnsQuery->startTick = xTaskGetTickCount();
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_SetRatPriority( CellularHandle_t cellularHandle,
+                                         const CellularRat_t * pRatPriorities,
+                                         uint8_t ratPrioritiesLength )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    cellularModuleContext_t * pModuleContext = NULL;
+    uint8_t i = 0;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char * cmdBuf = NULL;
+    CellularAtReq_t atReqSetRatPriority =
+    {
+        NULL,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( ( pRatPriorities == NULL ) || ( ratPrioritiesLength == 0U ) ||
+             ( ratPrioritiesLength > ( uint8_t ) CELLULAR_MAX_RAT_PRIORITY_COUNT ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cmdBuf = _Cellular_CommandBufferAcquire( pModuleContext );
+        atReqSetRatPriority.pAtCmd = cmdBuf;
+
+        /** Using AT+QCFG="nwscanseq",<scanseq>,<effect> to set the RAT priorities while searching.
+         * <scanseq> can take value 01 for GSM, 02 for CAT M1 and 03 for CAT NB1.
+         * <effect> can take value 0 for take effect after reboot and 1 for take effect immediately.
+         *  If < effect > is omitted, RAT priority takes effect immediately.
+         *  e.g. AT+QCFG="nwscanseq",020301,1 for decreasing RAT Priorities CAT M1, CAT NB1, GSM to take effect immediately. */
+        ( void ) strcpy( cmdBuf, "AT+QCFG=\"nwscanseq\"," );
+
+        while( i < ratPrioritiesLength )
+        {
+            if( pRatPriorities[ i ] == CELLULAR_RAT_GSM )
+            {
+                ( void ) strcat( cmdBuf, "01" );
+            }
+            else if( pRatPriorities[ i ] == CELLULAR_RAT_CATM1 )
+            {
+                ( void ) strcat( cmdBuf, "02" );
+            }
+            else if( pRatPriorities[ i ] == CELLULAR_RAT_NBIOT )
+            {
+                ( void ) strcat( cmdBuf, "03" );
+            }
+            else
+            {
+                cellularStatus = CELLULAR_BAD_PARAMETER;
+                break;
+            }
+
+            i++;
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqSetRatPriority );
+            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+        }
+
+        _Cellular_CommandBufferRelease( pModuleContext );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_GetRatPriority( CellularHandle_t cellularHandle,
+                                         CellularRat_t * pRatPriorities,
+                                         uint8_t ratPrioritiesLength,
+                                         uint8_t * pReceiveRatPrioritesLength )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    uint32_t ratIndex = 0;
+
+    CellularAtReq_t atReqSetRatPriority =
+    {
+        "AT+QCFG=\"nwscanseq\"",
+        CELLULAR_AT_WITH_PREFIX,
+        "+QCFG",
+        _Cellular_RecvFuncGetRatPriority,
+        pRatPriorities,
+        ( uint16_t ) ratPrioritiesLength,
+    };
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( ( pRatPriorities == NULL ) || ( ratPrioritiesLength == 0U ) ||
+             ( ratPrioritiesLength > ( uint8_t ) CELLULAR_MAX_RAT_PRIORITY_COUNT ) ||
+             ( pReceiveRatPrioritesLength == NULL ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqSetRatPriority );
+
+        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        {
+            for( ratIndex = 0; ratIndex < ratPrioritiesLength; ratIndex++ )
+            {
+                if( pRatPriorities[ ratIndex ] == CELLULAR_RAT_INVALID )
+                {
+                    break;
+                }
+            }
+
+            *pReceiveRatPrioritesLength = ratIndex;
+        }
+
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_SetDns( CellularHandle_t cellularHandle,
+                                 uint8_t contextId,
+                                 const char * pDnsServerAddress )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char * cmdBuf = NULL;
+    cellularAtBuilder_t cmdBuilder;
+    CellularAtReq_t atReqSetDns =
+    {
+        NULL,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pDnsServerAddress == NULL )
+    {
+        LogError( ( "Cellular_SetDns: Invalid parameter" ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_IsValidPdn( contextId );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cmdBuf = _Cellular_CommandBufferAcquire( pModuleContext );
+        atReqSetDns.pAtCmd = cmdBuf;
+
+        /* Form the AT command. */
+        _Cellular_AtBuilderInit( &cmdBuilder, cmdBuf, CELLULAR_AT_CMD_MAX_SIZE );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "AT+QIDNSCFG=" );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, contextId );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        _Cellular_AtBuilderAppendQuoted( &cmdBuilder, pDnsServerAddress );
+        cellularStatus = _Cellular_AtBuilderStatus( &cmdBuilder );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqSetDns );
+
+            if( pktStatus != CELLULAR_PKT_STATUS_OK )
+            {
+                LogError( ( "Cellular_SetDns: couldn't set the DNS, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
+                cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            }
+        }
+
+        _Cellular_CommandBufferRelease( pModuleContext );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_GetPsmSettings( CellularHandle_t cellularHandle,
+                                         CellularPsmSettings_t * pPsmSettings )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    CellularAtReq_t atReqGetPsm =
+    {
+        "AT+QPSMS?",
+        CELLULAR_AT_WITH_PREFIX,
+        "+QPSMS",
+        _Cellular_RecvFuncGetPsmSettings,
+        pPsmSettings,
+        sizeof( CellularPsmSettings_t ),
+    };
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pPsmSettings == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        /* initialize the data. */
+        ( void ) memset( pPsmSettings, 0, sizeof( CellularPsmSettings_t ) );
+        pPsmSettings->mode = 0xFF;
+
+        /* we should always query the PSMsettings from the network. */
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetPsm );
+
+        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        {
+            LogError( ( "Cellular_GetPsmSettings: couldn't retrieve PSM settings" ) );
+            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void appendBinaryPattern( cellularAtBuilder_t * pCmdBuilder,
+                                 uint32_t value,
+                                 bool endOfString )
+{
+    char binaryPattern[ BINARY_PATTERN_INT8_LENGTH + 1U ] = { '\0' };
+    uint32_t i = 0;
+
+    if( value != 0U )
+    {
+        for( i = 0U; i < BINARY_PATTERN_INT8_LENGTH; i++ )
+        {
+            binaryPattern[ i ] = ( ( value & ( 0x80UL >> i ) ) != 0UL ) ? '1' : '0';
+        }
+
+        _Cellular_AtBuilderAppendQuoted( pCmdBuilder, binaryPattern );
+    }
+
+    if( endOfString == false )
+    {
+        _Cellular_AtBuilderAppendLiteral( pCmdBuilder, "," );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularPktStatus_t socketSendDataPrefix( void * pCallbackContext,
+                                                 char * pLine,
+                                                 uint32_t * pBytesRead )
+{
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+
+    if( ( pLine == NULL ) || ( pBytesRead == NULL ) )
+    {
+        LogError( ( "socketSendDataPrefix: pLine is invalid or pBytesRead is invalid" ) );
+        pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
+    }
+    else if( pCallbackContext != NULL )
+    {
+        LogError( ( "socketSendDataPrefix: pCallbackContext is not NULL" ) );
+        pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
+    }
+    else if( *pBytesRead != 2U )
+    {
+        LogDebug( ( "socketSendDataPrefix: pBytesRead %u %s is not 1", *pBytesRead, pLine ) );
+    }
+    else
+    {
+        /* After the data prefix, there should not be any data in stream.
+         * Cellular commmon processes AT command in lines. Add a '\0' after '>'. */
+        if( strcmp( pLine, "> " ) == 0 )
+        {
+            pLine[ 1 ] = '\n';
+        }
+    }
+
+    return pktStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static void rearmDataReadyNotification( const CellularContext_t * pContext,
+                                        uint32_t socketId,
+                                        bool resetSuppressedCount )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    if( ( socketId < CELLULAR_NUM_SOCKET_MAX ) &&
+        ( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS ) )
+    {
+        /* The next data ready URC of this socket will be reported to the upper layer. */
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        pModuleContext->dataReadyPending[ socketId ] = false;
+
+        if( resetSuppressedCount == true )
+        {
+            pModuleContext->dataReadySuppressedCount[ socketId ] = 0;
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* The session restore holds the sockets it reconnects after a reboot. */
+static bool socketRestoring( const CellularContext_t * pContext,
+                             CellularSocketHandle_t socketHandle )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+    bool restoring = false;
+
+    if( ( socketHandle != NULL ) &&
+        ( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS ) )
+    {
+        restoring = _Cellular_SessionSocketRestoring( pModuleContext, socketHandle->socketId );
+    }
+
+    return restoring;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_SetPsmSettings( CellularHandle_t cellularHandle,
+                                         const CellularPsmSettings_t * pPsmSettings )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char * cmdBuf = NULL;
+    cellularAtBuilder_t cmdBuilder;
+    CellularAtReq_t atReqSetPsm =
+    {
+        NULL,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0
+    };
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pPsmSettings == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cmdBuf = _Cellular_CommandBufferAcquire( pModuleContext );
+        atReqSetPsm.pAtCmd = cmdBuf;
+
+        /* Form the AT command. */
+        _Cellular_AtBuilderInit( &cmdBuilder, cmdBuf, CELLULAR_AT_CMD_MAX_SIZE );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "AT+QPSMS=" );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, pPsmSettings->mode );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        appendBinaryPattern( &cmdBuilder, pPsmSettings->periodicRauValue, false );
+        appendBinaryPattern( &cmdBuilder, pPsmSettings->gprsReadyTimer, false );
+        appendBinaryPattern( &cmdBuilder, pPsmSettings->periodicTauValue, false );
+        appendBinaryPattern( &cmdBuilder, pPsmSettings->activeTimeValue, true );
+        cellularStatus = _Cellular_AtBuilderStatus( &cmdBuilder );
+
+        LogDebug( ( "PSM setting: %s ", cmdBuf ) );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* we should always query the PSMsettings from the network. */
+            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqSetPsm );
+
+            if( pktStatus != CELLULAR_PKT_STATUS_OK )
+            {
+                LogError( ( "Cellular_SetPsmSettings: couldn't set PSM settings" ) );
+                cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            }
+        }
+
+        _Cellular_CommandBufferRelease( pModuleContext );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_DeactivatePdn( CellularHandle_t cellularHandle,
+                                        uint8_t contextId )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    cellularModuleContext_t * pModuleContext = NULL;
+    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    cellularAtBuilder_t cmdBuilder;
+    CellularAtReq_t atReqDeactPdn =
+    {
+        cmdBuf,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+
+    cellularStatus = _Cellular_IsValidPdn( contextId );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Make sure the library is open. */
+        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Form the AT command. */
+        _Cellular_AtBuilderInit( &cmdBuilder, cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "AT+QIDEACT=" );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, contextId );
+        cellularStatus = _Cellular_AtBuilderStatus( &cmdBuilder );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqDeactPdn, PDN_DEACTIVATION_PACKET_REQ_TIMEOUT_MS );
+
+        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        {
+            LogError( ( "Cellular_DeactivatePdn: can't deactivate PDN, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
+            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+        }
+        else if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+        {
+            _Cellular_DnsCacheFlush( pModuleContext, contextId );
+            _Cellular_PdnStatusDeactivated( pModuleContext, contextId );
+            _Cellular_SessionPdnActive( pModuleContext, contextId, false );
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_ActivatePdn( CellularHandle_t cellularHandle,
+                                      uint8_t contextId )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    cellularAtBuilder_t cmdBuilder;
+    cellularModuleContext_t * pModuleContext = NULL;
+    TickType_t startTick = 0;
+
+    CellularAtReq_t atReqActPdn =
+    {
+        cmdBuf,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+
+    cellularStatus = _Cellular_IsValidPdn( contextId );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Make sure the library is open. */
+        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Form the AT command. */
+        _Cellular_AtBuilderInit( &cmdBuilder, cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "AT+QIACT=" );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, contextId );
+        cellularStatus = _Cellular_AtBuilderStatus( &cmdBuilder );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        startTick = xTaskGetTickCount();
+        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqActPdn, PDN_ACTIVATION_PACKET_REQ_TIMEOUT_MS );
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+        _Cellular_BootTimingCommand( pModuleContext, cmdBuf, startTick, 1U, cellularStatus );
+
+        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        {
+            LogError( ( "Cellular_ActivatePdn: can't activate PDN, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
+        }
+        else
+        {
+            _Cellular_BootTimingPhase( pModuleContext, CELLULAR_BG96_BOOT_PHASE_PDN_ACTIVATED );
+            _Cellular_PdnStatusInvalidate( pModuleContext );
+            _Cellular_SessionPdnActive( pModuleContext, contextId, true );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_SetPdnConfig( CellularHandle_t cellularHandle,
+                                       uint8_t contextId,
+                                       const CellularPdnConfig_t * pPdnConfig )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char * cmdBuf = NULL;
+    cellularAtBuilder_t cmdBuilder;
+    CellularAtReq_t atReqSetPdn =
+    {
+        NULL,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+
+    if( pPdnConfig == NULL )
+    {
+        LogError( ( "Cellular_ATCommandRaw: Input parameter is NULL" ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_IsValidPdn( contextId );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Make sure the library is open. */
+        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cmdBuf = _Cellular_CommandBufferAcquire( pModuleContext );
+        atReqSetPdn.pAtCmd = cmdBuf;
+
+        /* Form the AT command. */
+        _Cellular_AtBuilderInit( &cmdBuilder, cmdBuf, CELLULAR_AT_CMD_MAX_SIZE );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "AT+QICSGP=" );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, contextId );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, ( uint32_t ) pPdnConfig->pdnContextType );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        _Cellular_AtBuilderAppendQuoted( &cmdBuilder, pPdnConfig->apnName );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        _Cellular_AtBuilderAppendQuoted( &cmdBuilder, pPdnConfig->username );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        _Cellular_AtBuilderAppendQuoted( &cmdBuilder, pPdnConfig->password );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, ( uint32_t ) pPdnConfig->pdnAuthType );
+        cellularStatus = _Cellular_AtBuilderStatus( &cmdBuilder );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqSetPdn );
+
+            if( pktStatus != CELLULAR_PKT_STATUS_OK )
+            {
+                LogError( ( "Cellular_SetPdnConfig: can't set PDN, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
+                cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            }
+            else
+            {
+                _Cellular_SessionPdnConfigured( pModuleContext, contextId, pPdnConfig );
+            }
+        }
+
+        _Cellular_CommandBufferRelease( pModuleContext );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_GetSignalInfo( CellularHandle_t cellularHandle,
+                                        CellularSignalInfo_t * pSignalInfo )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    CellularRat_t rat = CELLULAR_RAT_INVALID;
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularAtReq_t atReqQuerySignalInfo =
+    {
+        "AT+QCSQ",
+        CELLULAR_AT_WITH_PREFIX,
+        "+QCSQ",
+        _Cellular_RecvFuncGetSignalInfo,
+        pSignalInfo,
+        sizeof( CellularSignalInfo_t ),
+    };
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pSignalInfo == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetCurrentRat( pContext, &rat );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqQuerySignalInfo );
+
+        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        {
+            /* If the convert failed, the API will return CELLULAR_INVALID_SIGNAL_BAR_VALUE in bars field. */
+            ( void ) _Cellular_ComputeSignalBars( rat, pSignalInfo );
+
+            if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+            {
+                PlatformMutex_Lock( &pModuleContext->stateMutex );
+                pModuleContext->signalRat = rat;
+                PlatformMutex_Unlock( &pModuleContext->stateMutex );
+            }
+        }
+
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96GetSignalInfoCached( CellularHandle_t cellularHandle,
+                                                  CellularSignalInfo_t * pSignalInfo,
+                                                  uint32_t maxAgeMs )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularRat_t rat = CELLULAR_RAT_INVALID;
+    TickType_t snapshotTick = 0;
+    bool snapshotUsed = false;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pSignalInfo == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( maxAgeMs > 0U ) )
+    {
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+        /* The URCs don't refresh the LTE fields. They are only valid on LTE. */
+        if( pModuleContext->signalRat == CELLULAR_RAT_GSM )
+        {
+            snapshotTick = pModuleContext->signalInfoTick;
+        }
+        else
+        {
+            snapshotTick = pModuleContext->signalLteTick;
+        }
+
+        if( ( pModuleContext->signalInfoValid == true ) &&
+            ( ( xTaskGetTickCount() - snapshotTick ) <= pdMS_TO_TICKS( maxAgeMs ) ) )
+        {
+            *pSignalInfo = pModuleContext->signalInfo;
+            rat = pModuleContext->signalRat;
+            snapshotUsed = true;
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        if( snapshotUsed == true )
+        {
+            /* If the convert failed, the API will return CELLULAR_INVALID_SIGNAL_BAR_VALUE in bars field. */
+            ( void ) _Cellular_ComputeSignalBars( rat, pSignalInfo );
+        }
+        else
+        {
+            cellularStatus = Cellular_GetSignalInfo( cellularHandle, pSignalInfo );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_SocketRecv( CellularHandle_t cellularHandle,
+                                     CellularSocketHandle_t socketHandle,
+                                     uint8_t * pBuffer,
+                                     uint32_t bufferLength,
+                                     uint32_t * pReceivedDataLength )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    cellularModuleContext_t * pLaneContext = NULL;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    cellularAtBuilder_t cmdBuilder;
+    uint32_t recvTimeout = DATA_READ_TIMEOUT_MS;
+    uint32_t recvLen = bufferLength;
+    _socketDataRecv_t dataRecv =
+    {
+        .pReceivedDataLength = pReceivedDataLength,
+        .pData               = pBuffer,
+        .dataLength          = bufferLength
+    };
+    CellularAtReq_t atReqSocketRecv =
+    {
+        .pAtCmd       = cmdBuf,
+        .atCmdType    = CELLULAR_AT_MULTI_DATA_WO_PREFIX,
+        .pAtRspPrefix = "+QIRD",
+        .respCallback = _Cellular_RecvFuncData,
+        .pData        = ( void * ) &dataRecv,
+        .dataLen      = sizeof( dataRecv )
+    };
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogError( ( "_Cellular_CheckLibraryStatus failed." ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        LogError( ( "Cellular_SocketRecv: Invalid socket handle." ) );
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( socketHandle->socketId >= CELLULAR_NUM_SOCKET_MAX )
+    {
+        LogError( ( "Cellular_SocketRecv: Invalid socket index." ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( ( pBuffer == NULL ) || ( pReceivedDataLength == NULL ) || ( bufferLength == 0U ) )
+    {
+        LogError( ( "Cellular_SocketRecv: Bad input Param." ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( socketRestoring( pContext, socketHandle ) == true )
+    {
+        LogInfo( ( "Cellular_SocketRecv: socket %u is being restored.", ( unsigned int ) socketHandle->socketId ) );
+        cellularStatus = CELLULAR_SOCKET_NOT_CONNECTED;
+    }
+    else if( socketHandle->socketState != SOCKETSTATE_CONNECTED )
+    {
+        /* Check the socket connection state. */
+        LogInfo( ( "Cellular_SocketRecv: socket state %d is not connected.", socketHandle->socketState ) );
+
+        if( ( socketHandle->socketState == SOCKETSTATE_ALLOCATED ) || ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) )
+        {
+            cellularStatus = CELLULAR_SOCKET_NOT_CONNECTED;
+        }
+        else
+        {
+            cellularStatus = CELLULAR_SOCKET_CLOSED;
+        }
+    }
+    else
+    {
+        if( socketHandle->dataMode == CELLULAR_ACCESSMODE_BUFFER )
+        {
+            /* Update recvLen to maximum module length. */
+            if( CELLULAR_MAX_RECV_DATA_LEN <= bufferLength )
+            {
+                recvLen = ( uint32_t ) CELLULAR_MAX_RECV_DATA_LEN;
+            }
+
+            /* Update receive timeout to default timeout if not set with setsocketopt. */
+            if( socketHandle->recvTimeoutMs != 0U )
+            {
+                recvTimeout = socketHandle->recvTimeoutMs;
+            }
+
+            /* Re-arm the data ready notification before reading. Data arriving after
+             * this point is reported again to the upper layer. */
+            rearmDataReadyNotification( pContext, socketHandle->socketId, false );
+
+            /* Form the AT command. */
+            _Cellular_AtBuilderInit( &cmdBuilder, cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE );
+            _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "AT+QIRD=" );
+            _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, socketHandle->socketId );
+            _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+            _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, recvLen );
+            cellularStatus = _Cellular_AtBuilderStatus( &cmdBuilder );
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                /* Socket data has its own DLCI when the UART is multiplexed. */
+                cellularStatus = _Cellular_CmuxSocketRecv( cmdBuf, pBuffer, recvLen, pReceivedDataLength, recvTimeout );
+            }
+
+            if( cellularStatus == CELLULAR_UNSUPPORTED )
+            {
+                /* The module context is left NULL on failure. The lane accepts NULL. */
+                ( void ) _Cellular_GetModuleContext( pContext, ( void ** ) &pLaneContext );
+                _Cellular_RequestLaneAcquire( pLaneContext, _Cellular_SocketRequestClass( pLaneContext, socketHandle->socketId ) );
+                pktStatus = _Cellular_TimeoutAtcmdDataRecvRequestWithCallback( pContext,
+                                                                               atReqSocketRecv, recvTimeout, socketRecvDataPrefix, NULL );
+                _Cellular_RequestLaneRelease( pLaneContext );
+                cellularStatus = CELLULAR_SUCCESS;
+
+                if( pktStatus != CELLULAR_PKT_STATUS_OK )
+                {
+                    /* Reset data handling parameters. */
+                    LogError( ( "_Cellular_RecvData: Data Receive fail, pktStatus: %d", pktStatus ) );
+                    cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+                }
+            }
+        }
+
+        #if ( CELLULAR_BG96_SUPPPORT_DIRECT_PUSH_SOCKET == 1 )
+            else if( socketHandle->dataMode == CELLULAR_ACCESSMODE_DIRECT_PUSH )
+            {
+                /* Socket data is returned in URC with direct push mode and store in
+                 * in the buffer of module context. Copy the data from the buffer and
+                 * decrease the data length of the buffer. */
+                cellularModuleContext_t * pModuleContext = NULL;
+                uint8_t * pSocketDataPtr;
+                uint32_t socketDataLength;
+
+                cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+
+                if( cellularStatus != CELLULAR_SUCCESS )
+                {
+                    pktStatus = CELLULAR_PKT_STATUS_INVALID_HANDLE;
+                }
+                else
+                {
+                    PlatformMutex_Lock( &pModuleContext->contextMutex );
+
+                    pSocketDataPtr = ( uint8_t * ) &pModuleContext->pSocketBuffer[ socketHandle->socketId ];
+                    socketDataLength = pModuleContext->pSocketDataSize[ socketHandle->socketId ];
+
+                    if( bufferLength > socketDataLength )
+                    {
+                        *pReceivedDataLength = socketDataLength;
+                    }
+                    else
+                    {
+                        *pReceivedDataLength = bufferLength;
+                    }
+
+                    /* Copy the data to the socket buffer. */
+                    memcpy( pBuffer, pSocketDataPtr, *pReceivedDataLength );
+
+                    /* Garbage collection. Decrease the size of data in socket buffer
+                     * and move the data to start of socket buffer. */
+                    pModuleContext->pSocketDataSize[ socketHandle->socketId ] -= *pReceivedDataLength;
+                    memmove( pSocketDataPtr, &pSocketDataPtr[ *pReceivedDataLength ], ( socketDataLength - *pReceivedDataLength ) );
+
+                    PlatformMutex_Unlock( &pModuleContext->contextMutex );
+                }
+            }
+        #endif /* CELLULAR_BG96_SUPPPORT_DIRECT_PUSH_SOCKET. */
+        else
+        {
+            LogError( ( "storeAccessModeAndAddress, Access mode not supported %d.",
+                        socketHandle->dataMode ) );
+            cellularStatus = CELLULAR_UNSUPPORTED;
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_SocketSend( CellularHandle_t cellularHandle,
+                                     CellularSocketHandle_t socketHandle,
+                                     const uint8_t * pData,
+                                     uint32_t dataLength,
+                                     uint32_t * pSentDataLength )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    cellularModuleContext_t * pLaneContext = NULL;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    uint32_t sendTimeout = DATA_SEND_TIMEOUT_MS;
+    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    cellularAtBuilder_t cmdBuilder;
+    CellularAtReq_t atReqSocketSend =
+    {
+        cmdBuf,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+    CellularAtDataReq_t atDataReqSocketSend =
+    {
+        pData,
+        dataLength,
+        pSentDataLength,
+        NULL,
+        0
+    };
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogError( ( "_Cellular_CheckLibraryStatus failed." ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        LogError( ( "Cellular_SocketSend: Invalid socket handle." ) );
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( ( pData == NULL ) || ( pSentDataLength == NULL ) || ( dataLength == 0U ) )
+    {
+        LogError( ( "Cellular_SocketSend: Invalid parameter." ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( socketRestoring( pContext, socketHandle ) == true )
+    {
+        LogInfo( ( "Cellular_SocketSend: socket %u is being restored.", ( unsigned int ) socketHandle->socketId ) );
+        cellularStatus = CELLULAR_SOCKET_NOT_CONNECTED;
+    }
+    else if( socketHandle->socketState != SOCKETSTATE_CONNECTED )
+    {
+        /* Check the socket connection state. */
+        LogInfo( ( "Cellular_SocketSend: socket state %d is not connected.", socketHandle->socketState ) );
+
+        if( ( socketHandle->socketState == SOCKETSTATE_ALLOCATED ) || ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) )
+        {
+            cellularStatus = CELLULAR_SOCKET_NOT_CONNECTED;
+        }
+        else
+        {
+            cellularStatus = CELLULAR_SOCKET_CLOSED;
+        }
+    }
+    else
+    {
+        /* Send data length check. */
+        if( dataLength > ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN )
+        {
+            atDataReqSocketSend.dataLen = ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN;
+        }
+
+        /* Check send timeout. If not set by setsockopt, use default value. */
+        if( socketHandle->sendTimeoutMs != 0U )
+        {
+            sendTimeout = socketHandle->sendTimeoutMs;
+        }
+
+        /* Form the AT command. */
+        _Cellular_AtBuilderInit( &cmdBuilder, cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "AT+QISEND=" );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, socketHandle->socketId );
+        _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "," );
+        _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, atDataReqSocketSend.dataLen );
+        cellularStatus = _Cellular_AtBuilderStatus( &cmdBuilder );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Socket data has its own DLCI when the UART is multiplexed. */
+        cellularStatus = _Cellular_CmuxSocketSend( cmdBuf, pData, atDataReqSocketSend.dataLen,
+                                                   pSentDataLength, sendTimeout );
+    }
+
+    if( cellularStatus == CELLULAR_UNSUPPORTED )
+    {
+        /* Data larger than CELLULAR_MAX_SEND_DATA_LEN is sent in several calls.
+         * Waiting requests of higher classes are served between them. */
+        ( void ) _Cellular_GetModuleContext( pContext, ( void ** ) &pLaneContext );
+        _Cellular_RequestLaneAcquire( pLaneContext, _Cellular_SocketRequestClass( pLaneContext, socketHandle->socketId ) );
+        pktStatus = _Cellular_AtcmdDataSend( pContext, atReqSocketSend, atDataReqSocketSend,
+                                             socketSendDataPrefix, NULL,
+                                             PACKET_REQ_TIMEOUT_MS, sendTimeout, 0U );
+        _Cellular_RequestLaneRelease( pLaneContext );
+        cellularStatus = CELLULAR_SUCCESS;
+
+        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        {
+            LogError( ( "Cellular_SocketSend: Data send fail, PktRet: %d", pktStatus ) );
+            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_SocketClose( CellularHandle_t cellularHandle,
+                                      CellularSocketHandle_t socketHandle )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    cellularModuleContext_t * pLaneContext = NULL;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
+    cellularAtBuilder_t cmdBuilder;
+    CellularAtReq_t atReqSockClose =
+    {
+        cmdBuf,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+
+    /* Make sure the library is open. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( socketRestoring( pContext, socketHandle ) == true )
+    {
+        LogWarn( ( "Cellular_SocketClose: socket %u is being restored.", ( unsigned int ) socketHandle->socketId ) );
+        cellularStatus = CELLULAR_NOT_ALLOWED;
+    }
+    else
+    {
+        ( void ) _Cellular_GetModuleContext( pContext, ( void ** ) &pLaneContext );
+
+        if( socketHandle->socketState == SOCKETSTATE_CONNECTING )
+        {
+            LogWarn( ( "Cellular_SocketClose: Socket state is SOCKETSTATE_CONNECTING." ) );
+        }
+
+        if( ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) ||
+            ( socketHandle->socketState == SOCKETSTATE_CONNECTED ) ||
+            ( socketHandle->socketState == SOCKETSTATE_DISCONNECTED ) )
+        {
+            /* Form the AT command. */
+            _Cellular_AtBuilderInit( &cmdBuilder, cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE );
+            _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "AT+QICLOSE=" );
+            _Cellular_AtBuilderAppendUnsigned( &cmdBuilder, socketHandle->socketId );
+
+            /* The socket data is removed below even if the command is not sent. */
+            if( _Cellular_AtBuilderStatus( &cmdBuilder ) == CELLULAR_SUCCESS )
+            {
+                _Cellular_RequestLaneAcquire( pLaneContext, CELLULAR_BG96_REQUEST_HIGH );
+                pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqSockClose,
+                                                                       SOCKET_DISCONNECT_PACKET_REQ_TIMEOUT_MS );
+                _Cellular_RequestLaneRelease( pLaneContext );
+
+                if( pktStatus != CELLULAR_PKT_STATUS_OK )
+                {
+                    LogError( ( "Cellular_SocketClose: Socket close failed, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
+                }
+            }
+        }
+
+        #if ( CELLULAR_BG96_REQUEST_PRIORITY == 1 )
+            /* The next socket with this index starts in the bulk class. */
+            if( ( pLaneContext != NULL ) && ( socketHandle->socketId < CELLULAR_NUM_SOCKET_MAX ) )
+            {
+                PlatformMutex_Lock( &pLaneContext->stateMutex );
+                pLaneContext->socketRequestClass[ socketHandle->socketId ] = CELLULAR_BG96_REQUEST_BULK;
+                PlatformMutex_Unlock( &pLaneContext->stateMutex );
+            }
+        #endif
+
+        /* Ignore the result from the info, and force to remove the socket. */
+        cellularStatus = _Cellular_RemoveSocketData( pContext, socketHandle );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_SocketConnect( CellularHandle_t cellularHandle,
+                                        CellularSocketHandle_t socketHandle,
+                                        CellularSocketAccessMode_t dataAccessMode,
+                                        const CellularSocketAddress_t * pRemoteSocketAddress )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+
+    if( socketRestoring( ( CellularContext_t * ) cellularHandle, socketHandle ) == true )
+    {
+        LogError( ( "Cellular_SocketConnect: socket %u is being restored.", ( unsigned int ) socketHandle->socketId ) );
+        cellularStatus = CELLULAR_NOT_ALLOWED;
+    }
+    else
+    {
+        cellularStatus = _Cellular_SocketConnect( cellularHandle, socketHandle, dataAccessMode, pRemoteSocketAddress );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* The session restore connects the sockets it holds with this function. */
+CellularError_t _Cellular_SocketConnect( CellularHandle_t cellularHandle,
+                                         CellularSocketHandle_t socketHandle,
+                                         CellularSocketAccessMode_t dataAccessMode,
+                                         const CellularSocketAddress_t * pRemoteSocketAddress )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    cellularModuleContext_t * pModuleContext = NULL;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    char * cmdBuf = NULL;
+    CellularAtReq_t atReqSocketConnect =
+    {
+        NULL,
+        CELLULAR_AT_NO_RESULT,
+        NULL,
+        NULL,
+        NULL,
+        0,
+    };
+
+    /* Make sure the library is open. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogError( ( "Cellular_SocketConnect: _Cellular_CheckLibraryStatus failed." ) );
+    }
+    else if( pRemoteSocketAddress == NULL )
+    {
+        LogError( ( "Cellular_SocketConnect: Invalid socket address." ) );
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( socketHandle == NULL )
+    {
+        LogError( ( "Cellular_SocketConnect: Invalid socket handle." ) );
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( ( socketHandle->socketState == SOCKETSTATE_CONNECTED ) || ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) )
+    {
+        LogError( ( "Cellular_SocketConnect: Not allowed in state %d.", socketHandle->socketState ) );
+        cellularStatus = CELLULAR_NOT_ALLOWED;
+    }
+    else
+    {
+        cellularStatus = storeAccessModeAndAddress( pContext, socketHandle, dataAccessMode, pRemoteSocketAddress );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cmdBuf = _Cellular_CommandBufferAcquire( pModuleContext );
+        atReqSocketConnect.pAtCmd = cmdBuf;
+
+        /* Builds the Socket connect command. */
+        cellularStatus = buildSocketConnect( socketHandle, cmdBuf );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Set the socket state to connecting state. If cellular modem returns error,
+             * revert the state to allocated state. */
+            socketHandle->socketState = SOCKETSTATE_CONNECTING;
+            rearmDataReadyNotification( pContext, socketHandle->socketId, true );
+
+            _Cellular_RequestLaneAcquire( pModuleContext, CELLULAR_BG96_REQUEST_NORMAL );
+            pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqSocketConnect,
+                                                                   SOCKET_CONNECT_PACKET_REQ_TIMEOUT_MS );
+            _Cellular_RequestLaneRelease( pModuleContext );
+
+            if( pktStatus != CELLULAR_PKT_STATUS_OK )
+            {
+                LogError( ( "Cellular_SocketConnect: Socket connect failed, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
+                cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+
+                /* Revert the state to allocated state. */
+                socketHandle->socketState = SOCKETSTATE_ALLOCATED;
+            }
+        }
+
+        _Cellular_CommandBufferRelease( pModuleContext );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_GetPdnStatus( CellularHandle_t cellularHandle,
+                                       CellularPdnStatus_t * pPdnStatusBuffers,
+                                       uint8_t numStatusBuffers,
+                                       uint8_t * pNumStatus )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    const CellularPdnStatus_t * pTempPdnStatusBuffer = pPdnStatusBuffers;
+    uint8_t numBuffers = 0;
+    bool cacheUsed = false;
+
+    #if ( CELLULAR_BG96_PDN_STATUS_CACHE == 1 )
+        cellularModuleContext_t * pModuleContext = NULL;
+    #endif
+    CellularAtReq_t atReqGetPdnStatus =
+    {
+        "AT+QIACT?",
+        CELLULAR_AT_WITH_PREFIX,
+        "+QIACT",
+        _Cellular_RecvFuncGetPdnStatus,
+        pPdnStatusBuffers,
+        numStatusBuffers,
+    };
+
+    if( ( pTempPdnStatusBuffer == NULL ) || ( pNumStatus == NULL ) || ( numStatusBuffers < 1u ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+        LogWarn( ( "_Cellular_GetPdnStatus: Bad input Parameter " ) );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* Make sure the library is open. */
+        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+    }
+
+    #if ( CELLULAR_BG96_PDN_STATUS_CACHE == 1 )
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* The PDN status is maintained by the PDN events once it is queried. */
+            cellularStatus = updatePdnStatus( pContext, pModuleContext );
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                *pNumStatus = readPdnStatus( pModuleContext, pPdnStatusBuffers, numStatusBuffers );
+                cacheUsed = true;
+            }
+        }
+    #endif /* CELLULAR_BG96_PDN_STATUS_CACHE. */
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheUsed == false ) )
+    {
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetPdnStatus );
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Populate the Valid number of statuses. */
+            *pNumStatus = 0;
+            numBuffers = numStatusBuffers;
+
+            while( numBuffers != 0U )
+            {
+                /* Check if the PDN state is valid. The context ID of the first
+                 * invalid PDN status is set to FF. */
+                if( ( pTempPdnStatusBuffer->contextId <= CELLULAR_PDN_CONTEXT_ID_MAX ) &&
+                    ( pTempPdnStatusBuffer->contextId != INVALID_PDN_INDEX ) )
+                {
+                    ( *pNumStatus ) += 1U;
+                }
+                else
+                {
+                    break;
+                }
+
+                numBuffers--;
+                pTempPdnStatusBuffer++;
+            }
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_GetIPAddress( CellularHandle_t cellularHandle,
+                                       uint8_t contextId,
+                                       char * pBuffer,
+                                       uint32_t bufferLength )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    bool cacheUsed = false;
+
+    #if ( CELLULAR_BG96_PDN_STATUS_CACHE == 1 )
+        CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+        cellularModuleContext_t * pModuleContext = NULL;
+        const CellularPdnStatus_t * pPdnStatus = NULL;
+
+        /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+        if( cellularStatus != CELLULAR_SUCCESS )
+        {
+            LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+        }
+        else if( ( pBuffer == NULL ) || ( bufferLength == 0U ) )
+        {
+            cellularStatus = CELLULAR_BAD_PARAMETER;
+        }
+        else if( _Cellular_IsValidPdn( contextId ) != CELLULAR_SUCCESS )
+        {
+            cellularStatus = CELLULAR_BAD_PARAMETER;
+        }
+        else
+        {
+            cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* The IP address of an activated PDN context is read with AT+QIACT?. */
+            cellularStatus = updatePdnStatus( pContext, pModuleContext );
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pPdnStatus = &pModuleContext->pdnStatus[ contextId - CELLULAR_PDN_CONTEXT_ID_MIN ];
+
+            if( pPdnStatus->contextId == 0U )
+            {
+                /* Leave the PDN context which is not activated to AT+CGPADDR. */
+            }
+            else if( strlen( pPdnStatus->ipAddress.ipAddress ) >= bufferLength )
+            {
+                cellularStatus = CELLULAR_BAD_PARAMETER;
+            }
+            else
+            {
+                ( void ) strncpy( pBuffer, pPdnStatus->ipAddress.ipAddress, bufferLength );
+                cacheUsed = true;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #endif /* CELLULAR_BG96_PDN_STATUS_CACHE. */
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheUsed == false ) )
+    {
+        cellularStatus = Cellular_CommonGetIPAddress( cellularHandle, contextId, pBuffer, bufferLength );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_GetSimCardStatus( CellularHandle_t cellularHandle,
+                                           CellularSimCardStatus_t * pSimCardStatus )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    cellularModuleContext_t * pModuleContext = NULL;
+    bool cacheUsed = false;
+    uint32_t simCardGeneration = 0;
+    CellularAtReq_t atReqGetSimCardStatus =
+    {
+        "AT+QSIMSTAT?",
+        CELLULAR_AT_WITH_PREFIX,
+        "+QSIMSTAT",
+        _Cellular_RecvFuncGetSimCardStatus,
+        &pSimCardStatus->simCardState,
+        sizeof( CellularSimCardState_t ),
+    };
+    CellularAtReq_t atReqGetSimLockStatus =
+    {
+        "AT+CPIN?",
+        CELLULAR_AT_WITH_PREFIX,
+        "+CPIN",
+        _Cellular_RecvFuncGetSimLockStatus,
+        &pSimCardStatus->simCardLockState,
+        sizeof( CellularSimCardLockState_t ),
+    };
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pSimCardStatus == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    #if ( CELLULAR_BG96_SIM_STATUS_CACHE == 1 )
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* The SIM card status is maintained by QSIMSTAT and CPIN URCs once it is queried. */
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            if( ( pModuleContext->simCardStateValid == true ) && ( pModuleContext->simCardLockStateValid == true ) )
+            {
+                *pSimCardStatus = pModuleContext->simCardStatus;
+                cacheUsed = true;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #endif /* CELLULAR_BG96_SIM_STATUS_CACHE. */
+
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheUsed == false ) )
+    {
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        simCardGeneration = pModuleContext->simCardGeneration;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        /* Initialize the sim state and the sim lock state. */
+        pSimCardStatus->simCardState = CELLULAR_SIM_CARD_UNKNOWN;
+        pSimCardStatus->simCardLockState = CELLULAR_SIM_CARD_LOCK_UNKNOWN;
+
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetSimCardStatus );
+
+        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        {
+            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetSimLockStatus );
+        }
+
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Don't store the status if a URC changed it during the query. */
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            if( simCardGeneration == pModuleContext->simCardGeneration )
+            {
+                pModuleContext->simCardStatus = *pSimCardStatus;
+                pModuleContext->simCardStateValid = true;
+                pModuleContext->simCardLockStateValid = true;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_GetSimStatus, Sim Insert State[%d], Lock State[%d]",
+                    pSimCardStatus->simCardState, pSimCardStatus->simCardLockState ) );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96GetSimCardInfo( CellularHandle_t cellularHandle,
+                                             CellularSimCardInfo_t * pSimCardInfo,
+                                             bool forceRefresh )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
+    cellularModuleContext_t * pModuleContext = NULL;
+    bool cacheUsed = false;
+    uint32_t simCardGeneration = 0;
+
+    CellularAtReq_t atReqGetIccid =
+    {
+        "AT+QCCID",
+        CELLULAR_AT_WITH_PREFIX,
+        "+QCCID",
+        _Cellular_RecvFuncGetIccid,
+        pSimCardInfo->iccid,
+        CELLULAR_ICCID_MAX_SIZE + 1U,
+    };
+    CellularAtReq_t atReqGetImsi =
+    {
+        "AT+CIMI",
+        CELLULAR_AT_WO_PREFIX,
+        NULL,
+        _Cellular_RecvFuncGetImsi,
+        pSimCardInfo->imsi,
+        CELLULAR_IMSI_MAX_SIZE + 1U,
+    };
+    CellularAtReq_t atReqGetHplmn =
+    {
+        "AT+CRSM=176,28514,0,0,0",
+        CELLULAR_AT_WITH_PREFIX,
+        "+CRSM",
+        _Cellular_RecvFuncGetHplmn,
+        &pSimCardInfo->plmn,
+        sizeof( CellularPlmnInfo_t ),
+    };
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pSimCardInfo == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        /* The SIM card identity can only change with the SIM card. */
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+        if( ( forceRefresh == false ) && ( pModuleContext->simCardInfoValid == true ) )
+        {
+            *pSimCardInfo = pModuleContext->simCardInfo;
+            cacheUsed = true;
+        }
+
+        simCardGeneration = pModuleContext->simCardGeneration;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
     }
 
-    if( cellularStatus == CELLULAR_SUCCESS )
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( cacheUsed == false ) )
     {
-        /* Form the AT command. */
+        ( void ) memset( pSimCardInfo, 0, sizeof( CellularSimCardInfo_t ) );
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetImsi );
 
-        /* The return value of snprintf is not used.
-         * The max length of the string is fixed and checked offline. */
-        ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE, "%s%d", "AT+QIACT=", contextId );
-        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqActPdn, PDN_ACTIVATION_PACKET_REQ_TIMEOUT_MS );
+        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        {
+            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetHplmn );
+        }
+
+        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        {
+            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetIccid );
+        }
 
         if( pktStatus != CELLULAR_PKT_STATUS_OK )
         {
-            LogError( ( "Cellular_ActivatePdn: can't activate PDN, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
             cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
         }
+        else
+        {
+            LogDebug( ( "SimInfo updated: IMSI:%s, Hplmn:%s%s, ICCID:%s",
+                        pSimCardInfo->imsi, pSimCardInfo->plmn.mcc, pSimCardInfo->plmn.mnc,
+                        pSimCardInfo->iccid ) );
+
+            /* Don't store the identity if the SIM card changed during the query. */
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            if( simCardGeneration == pModuleContext->simCardGeneration )
+            {
+                pModuleContext->simCardInfo = *pSimCardInfo;
+                pModuleContext->simCardInfoValid = true;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
     }
 
     return cellularStatus;
@@ -2477,61 +5058,41 @@ CellularError_t Cellular_ActivatePdn( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_SetPdnConfig( CellularHandle_t cellularHandle,
-                                       uint8_t contextId,
-                                       const CellularPdnConfig_t * pPdnConfig )
+CellularError_t Cellular_GetSimCardInfo( CellularHandle_t cellularHandle,
+                                         CellularSimCardInfo_t * pSimCardInfo )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
-    CellularAtReq_t atReqSetPdn =
-    {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0,
-    };
+    bool forceRefresh = true;
 
-    if( pPdnConfig == NULL )
-    {
-        LogError( ( "Cellular_ATCommandRaw: Input parameter is NULL" ) );
-        cellularStatus = CELLULAR_BAD_PARAMETER;
-    }
+    /* The identity is cached only if a swapped SIM card is reported by URC. */
+    #if ( CELLULAR_BG96_SIM_STATUS_CACHE == 1 )
+        forceRefresh = false;
+    #endif
 
-    if( cellularStatus == CELLULAR_SUCCESS )
-    {
-        cellularStatus = _Cellular_IsValidPdn( contextId );
-    }
+    return Cellular_BG96GetSimCardInfo( cellularHandle, pSimCardInfo, forceRefresh );
+}
 
-    if( cellularStatus == CELLULAR_SUCCESS )
-    {
-        /* Make sure the library is open. */
-        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
-    }
+/*-----------------------------------------------------------*/
 
-    if( cellularStatus == CELLULAR_SUCCESS )
-    {
-        /* Form the AT command. */
+CellularError_t Cellular_RegisterUrcSignalStrengthChangedCallback( CellularHandle_t cellularHandle,
+                                                                   CellularUrcSignalStrengthChangedCallback_t signalStrengthChangedCallback,
+                                                                   void * pCallbackContext )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
 
-        /* The return value of snprintf is not used.
-         * The max length of the string is fixed and checked offline. */
-        ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_MAX_SIZE, "%s%d,%d,\"%s\",\"%s\",\"%s\",%d",
-                           "AT+QICSGP=",
-                           contextId,
-                           pPdnConfig->pdnContextType,
-                           pPdnConfig->apnName,
-                           pPdnConfig->username,
-                           pPdnConfig->password,
-                           pPdnConfig->pdnAuthType );
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqSetPdn );
+    /* pContext is checked in the common library. */
+    cellularStatus = Cellular_CommonRegisterUrcSignalStrengthChangedCallback(
+        cellularHandle, signalStrengthChangedCallback, pCallbackContext );
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        if( signalStrengthChangedCallback != NULL )
         {
-            LogError( ( "Cellular_SetPdnConfig: can't set PDN, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            cellularStatus = controlSignalStrengthIndication( pContext, true );
+        }
+        else
+        {
+            cellularStatus = controlSignalStrengthIndication( pContext, false );
         }
     }
 
@@ -2540,49 +5101,28 @@ CellularError_t Cellular_SetPdnConfig( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_GetSignalInfo( CellularHandle_t cellularHandle,
-                                        CellularSignalInfo_t * pSignalInfo )
+CellularError_t Cellular_BG96SetSignalStrengthUrcFilter( CellularHandle_t cellularHandle,
+                                                         uint32_t minIntervalMs,
+                                                         uint16_t hysteresisDb )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    CellularRat_t rat = CELLULAR_RAT_INVALID;
-    CellularAtReq_t atReqQuerySignalInfo =
-    {
-        "AT+QCSQ",
-        CELLULAR_AT_WITH_PREFIX,
-        "+QCSQ",
-        _Cellular_RecvFuncGetSignalInfo,
-        pSignalInfo,
-        sizeof( CellularSignalInfo_t ),
-    };
+    cellularModuleContext_t * pModuleContext = NULL;
 
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
-    if( cellularStatus != CELLULAR_SUCCESS )
-    {
-        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
-    }
-    else if( pSignalInfo == NULL )
-    {
-        cellularStatus = CELLULAR_BAD_PARAMETER;
-    }
-    else
+    if( cellularStatus == CELLULAR_SUCCESS )
     {
-        cellularStatus = _Cellular_GetCurrentRat( pContext, &rat );
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
     }
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqQuerySignalInfo );
-
-        if( pktStatus == CELLULAR_PKT_STATUS_OK )
-        {
-            /* If the convert failed, the API will return CELLULAR_INVALID_SIGNAL_BAR_VALUE in bars field. */
-            ( void ) _Cellular_ComputeSignalBars( rat, pSignalInfo );
-        }
-
-        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        pModuleContext->csqUrcMinIntervalMs = minIntervalMs;
+        pModuleContext->csqUrcHysteresisDb = hysteresisDb;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
     }
 
     return cellularStatus;
@@ -2590,152 +5130,100 @@ CellularError_t Cellular_GetSignalInfo( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_SocketRecv( CellularHandle_t cellularHandle,
-                                     CellularSocketHandle_t socketHandle,
-                                     uint8_t * pBuffer,
-                                     uint32_t bufferLength,
-                                     uint32_t * pReceivedDataLength )
+/* Resolve the host name from the DNS cache or with AT+QIDNSGIP. */
+static CellularError_t resolveHostName( CellularContext_t * pContext,
+                                        uint8_t contextId,
+                                        const char * pcHostName,
+                                        cellularDnsAddressList_t * pAddressList )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
-    uint32_t recvTimeout = DATA_READ_TIMEOUT_MS;
-    uint32_t recvLen = bufferLength;
-    _socketDataRecv_t dataRecv =
-    {
-        .pReceivedDataLength = pReceivedDataLength,
-        .pData               = pBuffer,
-        .dataLength          = bufferLength
-    };
-    CellularAtReq_t atReqSocketRecv =
-    {
-        .pAtCmd       = cmdBuf,
-        .atCmdType    = CELLULAR_AT_MULTI_DATA_WO_PREFIX,
-        .pAtRspPrefix = "+QIRD",
-        .respCallback = _Cellular_RecvFuncData,
-        .pData        = ( void * ) &dataRecv,
-        .dataLen      = sizeof( dataRecv )
-    };
+    cellularDnsQueryResult_t dnsQueryResult = CELLULAR_DNS_QUERY_UNKNOWN;
+    cellularModuleContext_t * pModuleContext = NULL;
+    uint32_t dnsTtl = 0;
+
+    #if ( CELLULAR_BG96_DNS_CACHE_ENTRIES > 0U )
+        bool refreshAhead = false;
+    #endif /* CELLULAR_BG96_DNS_CACHE_ENTRIES. */
 
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
     if( cellularStatus != CELLULAR_SUCCESS )
     {
-        LogError( ( "_Cellular_CheckLibraryStatus failed." ) );
-    }
-    else if( socketHandle == NULL )
-    {
-        LogError( ( "Cellular_SocketRecv: Invalid socket handle." ) );
-        cellularStatus = CELLULAR_INVALID_HANDLE;
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( socketHandle->socketId >= CELLULAR_NUM_SOCKET_MAX )
+    else if( ( pcHostName == NULL ) || ( pAddressList == NULL ) )
     {
-        LogError( ( "Cellular_SocketRecv: Invalid socket index." ) );
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
-    else if( ( pBuffer == NULL ) || ( pReceivedDataLength == NULL ) || ( bufferLength == 0U ) )
+    else
     {
-        LogError( ( "Cellular_SocketRecv: Bad input Param." ) );
-        cellularStatus = CELLULAR_BAD_PARAMETER;
+        cellularStatus = _Cellular_IsValidPdn( contextId );
     }
-    else if( socketHandle->socketState != SOCKETSTATE_CONNECTED )
-    {
-        /* Check the socket connection state. */
-        LogInfo( ( "Cellular_SocketRecv: socket state %d is not connected.", socketHandle->socketState ) );
 
-        if( ( socketHandle->socketState == SOCKETSTATE_ALLOCATED ) || ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) )
-        {
-            cellularStatus = CELLULAR_SOCKET_NOT_CONNECTED;
-        }
-        else
-        {
-            cellularStatus = CELLULAR_SOCKET_CLOSED;
-        }
-    }
-    else
+    if( cellularStatus == CELLULAR_SUCCESS )
     {
-        if( socketHandle->dataMode == CELLULAR_ACCESSMODE_BUFFER )
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    #if ( CELLULAR_BG96_DNS_CACHE_ENTRIES > 0U )
+        if( cellularStatus == CELLULAR_SUCCESS )
         {
-            /* Update recvLen to maximum module length. */
-            if( CELLULAR_MAX_RECV_DATA_LEN <= bufferLength )
+            dnsQueryResult = dnsCacheLookup( pModuleContext, contextId, pcHostName, pAddressList, &refreshAhead );
+
+            if( dnsQueryResult == CELLULAR_DNS_QUERY_FAILED )
             {
-                recvLen = ( uint32_t ) CELLULAR_MAX_RECV_DATA_LEN;
+                LogDebug( ( "resolveHostName: %s failed, cached", pcHostName ) );
+                cellularStatus = CELLULAR_UNKNOWN;
             }
-
-            /* Update receive timeout to default timeout if not set with setsocketopt. */
-            if( socketHandle->recvTimeoutMs != 0U )
+            else if( refreshAhead == true )
             {
-                recvTimeout = socketHandle->recvTimeoutMs;
+                dnsRefreshAhead( pContext, pModuleContext );
             }
-
-            /* Form the AT command. */
-
-            /* The return value of snprintf is not used.
-             * The max length of the string is fixed and checked offline. */
-            ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE,
-                               "%s%ld,%ld", "AT+QIRD=", socketHandle->socketId, recvLen );
-            pktStatus = _Cellular_TimeoutAtcmdDataRecvRequestWithCallback( pContext,
-                                                                           atReqSocketRecv, recvTimeout, socketRecvDataPrefix, NULL );
-
-            if( pktStatus != CELLULAR_PKT_STATUS_OK )
+            else
             {
-                /* Reset data handling parameters. */
-                LogError( ( "_Cellular_RecvData: Data Receive fail, pktStatus: %d", pktStatus ) );
-                cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+                /* Empty else MISRA 15.7 */
             }
         }
+    #endif /* CELLULAR_BG96_DNS_CACHE_ENTRIES. */
 
-        #if ( CELLULAR_BG96_SUPPPORT_DIRECT_PUSH_SOCKET == 1 )
-            else if( socketHandle->dataMode == CELLULAR_ACCESSMODE_DIRECT_PUSH )
-            {
-                /* Socket data is returned in URC with direct push mode and store in
-                 * in the buffer of module context. Copy the data from the buffer and
-                 * decrease the data length of the buffer. */
-                cellularModuleContext_t * pModuleContext = NULL;
-                uint8_t * pSocketDataPtr;
-                uint32_t socketDataLength;
-
-                cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
-
-                if( cellularStatus != CELLULAR_SUCCESS )
-                {
-                    pktStatus = CELLULAR_PKT_STATUS_INVALID_HANDLE;
-                }
-                else
-                {
-                    PlatformMutex_Lock( &pModuleContext->contextMutex );
-
-                    pSocketDataPtr = ( uint8_t * ) &pModuleContext->pSocketBuffer[ socketHandle->socketId ];
-                    socketDataLength = pModuleContext->pSocketDataSize[ socketHandle->socketId ];
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( dnsQueryResult == CELLULAR_DNS_QUERY_UNKNOWN ) )
+    {
+        cellularStatus = queryHostByName( pContext, pModuleContext, contextId, pcHostName,
+                                          pAddressList, &dnsQueryResult, &dnsTtl );
 
-                    if( bufferLength > socketDataLength )
-                    {
-                        *pReceivedDataLength = socketDataLength;
-                    }
-                    else
-                    {
-                        *pReceivedDataLength = bufferLength;
-                    }
+        #if ( CELLULAR_BG96_DNS_CACHE_ENTRIES > 0U )
+            dnsCacheStoreResult( pModuleContext, contextId, pcHostName, dnsQueryResult, pAddressList, dnsTtl );
+        #endif /* CELLULAR_BG96_DNS_CACHE_ENTRIES. */
+    }
 
-                    /* Copy the data to the socket buffer. */
-                    memcpy( pBuffer, pSocketDataPtr, *pReceivedDataLength );
+    return cellularStatus;
+}
 
-                    /* Garbage collection. Decrease the size of data in socket buffer
-                     * and move the data to start of socket buffer. */
-                    pModuleContext->pSocketDataSize[ socketHandle->socketId ] -= *pReceivedDataLength;
-                    memmove( pSocketDataPtr, &pSocketDataPtr[ *pReceivedDataLength ], ( socketDataLength - *pReceivedDataLength ) );
+/*-----------------------------------------------------------*/
 
-                    PlatformMutex_Unlock( &pModuleContext->contextMutex );
-                }
-            }
-        #endif /* CELLULAR_BG96_SUPPPORT_DIRECT_PUSH_SOCKET. */
-        else
-        {
-            LogError( ( "storeAccessModeAndAddress, Access mode not supported %d.",
-                        socketHandle->dataMode ) );
-            cellularStatus = CELLULAR_UNSUPPORTED;
-        }
+CellularError_t Cellular_GetHostByName( CellularHandle_t cellularHandle,
+                                        uint8_t contextId,
+                                        const char * pcHostName,
+                                        char * pResolvedAddress )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularDnsAddressList_t addressList = { 0 };
+
+    if( pResolvedAddress == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        /* pContext and pcHostName are checked in resolveHostName function. */
+        cellularStatus = resolveHostName( pContext, contextId, pcHostName, &addressList );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        ( void ) strncpy( pResolvedAddress, addressList.addresses[ 0 ], CELLULAR_IP_ADDRESS_MAX_SIZE );
     }
 
     return cellularStatus;
@@ -2743,95 +5231,113 @@ CellularError_t Cellular_SocketRecv( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_SocketSend( CellularHandle_t cellularHandle,
-                                     CellularSocketHandle_t socketHandle,
-                                     const uint8_t * pData,
-                                     uint32_t dataLength,
-                                     uint32_t * pSentDataLength )
+CellularError_t Cellular_BG96GetHostByNameAll( CellularHandle_t cellularHandle,
+                                               uint8_t contextId,
+                                               const char * pcHostName,
+                                               CellularIPAddress_t * pResolvedAddresses,
+                                               uint8_t addressesLength,
+                                               uint8_t * pAddressesNum )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    uint32_t sendTimeout = DATA_SEND_TIMEOUT_MS;
-    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
-    CellularAtReq_t atReqSocketSend =
+    cellularDnsAddressList_t addressList = { 0 };
+
+    if( ( pResolvedAddresses == NULL ) || ( addressesLength == 0U ) || ( pAddressesNum == NULL ) )
     {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0,
-    };
-    CellularAtDataReq_t atDataReqSocketSend =
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
     {
-        pData,
-        dataLength,
-        pSentDataLength,
-        NULL,
-        0
-    };
+        /* pContext and pcHostName are checked in resolveHostName function. */
+        cellularStatus = resolveHostName( pContext, contextId, pcHostName, &addressList );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        *pAddressesNum = copyDnsAddresses( &addressList, pResolvedAddresses, addressesLength );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96GetHostByNameAsync( CellularHandle_t cellularHandle,
+                                                 uint8_t contextId,
+                                                 const char * pcHostName,
+                                                 CellularBG96DnsResultCallback_t dnsResultCallback,
+                                                 void * pCallbackContext,
+                                                 uint32_t * pRequestId )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularDnsQueryResult_t dnsQueryResult = CELLULAR_DNS_QUERY_UNKNOWN;
+    cellularModuleContext_t * pModuleContext = NULL;
+    cellularDnsQuery_t * pDnsQuery = NULL;
+
+    #if ( CELLULAR_BG96_DNS_CACHE_ENTRIES > 0U )
+        cellularDnsAddressList_t addressList = { 0 };
+        CellularIPAddress_t addresses[ CELLULAR_BG96_DNS_MAX_ADDRESSES ];
+        uint8_t addressesNum = 0;
+        bool refreshAhead = false;
+    #endif /* CELLULAR_BG96_DNS_CACHE_ENTRIES. */
 
     /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
     if( cellularStatus != CELLULAR_SUCCESS )
     {
-        LogError( ( "_Cellular_CheckLibraryStatus failed." ) );
-    }
-    else if( socketHandle == NULL )
-    {
-        LogError( ( "Cellular_SocketSend: Invalid socket handle." ) );
-        cellularStatus = CELLULAR_INVALID_HANDLE;
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( ( pData == NULL ) || ( pSentDataLength == NULL ) || ( dataLength == 0U ) )
+    else if( ( pcHostName == NULL ) || ( dnsResultCallback == NULL ) || ( pRequestId == NULL ) )
     {
-        LogError( ( "Cellular_SocketSend: Invalid parameter." ) );
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
-    else if( socketHandle->socketState != SOCKETSTATE_CONNECTED )
+    else
     {
-        /* Check the socket connection state. */
-        LogInfo( ( "Cellular_SocketSend: socket state %d is not connected.", socketHandle->socketState ) );
-
-        if( ( socketHandle->socketState == SOCKETSTATE_ALLOCATED ) || ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) )
-        {
-            cellularStatus = CELLULAR_SOCKET_NOT_CONNECTED;
-        }
-        else
-        {
-            cellularStatus = CELLULAR_SOCKET_CLOSED;
-        }
+        *pRequestId = 0;
+        cellularStatus = _Cellular_IsValidPdn( contextId );
     }
-    else
+
+    if( cellularStatus == CELLULAR_SUCCESS )
     {
-        /* Send data length check. */
-        if( dataLength > ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN )
-        {
-            atDataReqSocketSend.dataLen = ( uint32_t ) CELLULAR_MAX_SEND_DATA_LEN;
-        }
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
 
-        /* Check send timeout. If not set by setsockopt, use default value. */
-        if( socketHandle->sendTimeoutMs != 0U )
+    #if ( CELLULAR_BG96_DNS_CACHE_ENTRIES > 0U )
+        if( cellularStatus == CELLULAR_SUCCESS )
         {
-            sendTimeout = socketHandle->sendTimeoutMs;
-        }
+            dnsQueryResult = dnsCacheLookup( pModuleContext, contextId, pcHostName, &addressList, &refreshAhead );
 
-        /* Form the AT command. */
+            if( dnsQueryResult == CELLULAR_DNS_QUERY_SUCCESS )
+            {
+                addressesNum = copyDnsAddresses( &addressList, addresses, ( uint8_t ) CELLULAR_BG96_DNS_MAX_ADDRESSES );
+                dnsResultCallback( 0, CELLULAR_SUCCESS, addresses, addressesNum, pCallbackContext );
 
-        /* The return value of snprintf is not used.
-         * The max length of the string is fixed and checked offline. */
-        ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE, "%s%ld,%ld",
-                           "AT+QISEND=", socketHandle->socketId, atDataReqSocketSend.dataLen );
+                if( refreshAhead == true )
+                {
+                    dnsRefreshAhead( pContext, pModuleContext );
+                }
+            }
+            else if( dnsQueryResult == CELLULAR_DNS_QUERY_FAILED )
+            {
+                dnsResultCallback( 0, CELLULAR_UNKNOWN, NULL, 0, pCallbackContext );
+            }
+            else
+            {
+                /* Empty else MISRA 15.7 */
+            }
+        }
+    #endif /* CELLULAR_BG96_DNS_CACHE_ENTRIES. */
 
-        pktStatus = _Cellular_AtcmdDataSend( pContext, atReqSocketSend, atDataReqSocketSend,
-                                             socketSendDataPrefix, NULL,
-                                             PACKET_REQ_TIMEOUT_MS, sendTimeout, 0U );
+    if( ( cellularStatus == CELLULAR_SUCCESS ) && ( dnsQueryResult == CELLULAR_DNS_QUERY_UNKNOWN ) )
+    {
+        cellularStatus = sendDnsQuery( pContext, pModuleContext, contextId, pcHostName,
+                                       dnsResultCallback, pCallbackContext, &pDnsQuery, pRequestId );
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        if( cellularStatus != CELLULAR_SUCCESS )
         {
-            LogError( ( "Cellular_SocketSend: Data send fail, PktRet: %d", pktStatus ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            *pRequestId = 0;
         }
     }
 
@@ -2840,61 +5346,50 @@ CellularError_t Cellular_SocketSend( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_SocketClose( CellularHandle_t cellularHandle,
-                                      CellularSocketHandle_t socketHandle )
+CellularError_t Cellular_BG96CancelHostByName( CellularHandle_t cellularHandle,
+                                               uint32_t requestId )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_TYPICAL_MAX_SIZE ] = { '\0' };
-    CellularAtReq_t atReqSockClose =
-    {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0,
-    };
+    cellularModuleContext_t * pModuleContext = NULL;
+    uint32_t i = 0;
 
-    /* Make sure the library is open. */
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
     if( cellularStatus != CELLULAR_SUCCESS )
     {
         LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( socketHandle == NULL )
+    else if( requestId == 0U )
     {
-        cellularStatus = CELLULAR_INVALID_HANDLE;
+        cellularStatus = CELLULAR_BAD_PARAMETER;
     }
     else
     {
-        if( socketHandle->socketState == SOCKETSTATE_CONNECTING )
-        {
-            LogWarn( ( "Cellular_SocketClose: Socket state is SOCKETSTATE_CONNECTING." ) );
-        }
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
 
-        if( ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) ||
-            ( socketHandle->socketState == SOCKETSTATE_CONNECTED ) ||
-            ( socketHandle->socketState == SOCKETSTATE_DISCONNECTED ) )
-        {
-            /* Form the AT command. */
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
 
-            /* The return value of snprintf is not used.
-             * The max length of the string is fixed and checked offline. */
-            ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_TYPICAL_MAX_SIZE, "%s%ld", "AT+QICLOSE=", socketHandle->socketId );
-            pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqSockClose,
-                                                                   SOCKET_DISCONNECT_PACKET_REQ_TIMEOUT_MS );
+        /* The slot stays in use to consume the results of the query. */
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
 
-            if( pktStatus != CELLULAR_PKT_STATUS_OK )
+        for( i = 0; i < CELLULAR_BG96_DNS_QUERY_SLOTS; i++ )
+        {
+            if( ( pModuleContext->dnsQueries[ i ].state == CELLULAR_DNS_QUERY_STATE_WAITING ) &&
+                ( pModuleContext->dnsQueries[ i ].asyncQuery == true ) &&
+                ( pModuleContext->dnsQueries[ i ].sequence == requestId ) )
             {
-                LogError( ( "Cellular_SocketClose: Socket close failed, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
+                pModuleContext->dnsQueries[ i ].callback = NULL;
+                cellularStatus = CELLULAR_SUCCESS;
+                break;
             }
         }
 
-        /* Ignore the result from the info, and force to remove the socket. */
-        cellularStatus = _Cellular_RemoveSocketData( pContext, socketHandle );
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
     }
 
     return cellularStatus;
@@ -2902,16 +5397,55 @@ CellularError_t Cellular_SocketClose( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_SocketConnect( CellularHandle_t cellularHandle,
-                                        CellularSocketHandle_t socketHandle,
-                                        CellularSocketAccessMode_t dataAccessMode,
-                                        const CellularSocketAddress_t * pRemoteSocketAddress )
+CellularError_t Cellular_BG96GetDataReadySuppressedCount( CellularHandle_t cellularHandle,
+                                                           CellularSocketHandle_t socketHandle,
+                                                           uint32_t * pSuppressedCount )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( ( socketHandle->socketId >= CELLULAR_NUM_SOCKET_MAX ) || ( pSuppressedCount == NULL ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        *pSuppressedCount = pModuleContext->dataReadySuppressedCount[ socketHandle->socketId ];
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+static CellularError_t sendBandMask( CellularContext_t * pContext,
+                                     cellularModuleContext_t * pModuleContext,
+                                     const CellularBG96BandMask_t * pBandMask )
+{
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_MAX_SIZE ] = { '\0' };
-    CellularAtReq_t atReqSocketConnect =
+    cellularAtBuilder_t cmdBuilder;
+    char * cmdBuf = _Cellular_CommandBufferAcquire( pModuleContext );
+    CellularAtReq_t atReqSetBand =
     {
         cmdBuf,
         CELLULAR_AT_NO_RESULT,
@@ -2921,55 +5455,89 @@ CellularError_t Cellular_SocketConnect( CellularHandle_t cellularHandle,
         0,
     };
 
-    /* Make sure the library is open. */
+    _Cellular_AtBuilderInit( &cmdBuilder, cmdBuf, CELLULAR_AT_CMD_MAX_SIZE );
+    _Cellular_AtBuilderAppendLiteral( &cmdBuilder, "AT+QCFG=\"band\"," );
+    _Cellular_FormatBandMask( &cmdBuilder, pBandMask );
+    cellularStatus = _Cellular_AtBuilderStatus( &cmdBuilder );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqSetBand );
+        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+    }
+
+    _Cellular_CommandBufferRelease( pModuleContext );
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96SetBandMask( CellularHandle_t cellularHandle,
+                                          const CellularBG96BandMask_t * pBandMask )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
     if( cellularStatus != CELLULAR_SUCCESS )
     {
-        LogError( ( "Cellular_SocketConnect: _Cellular_CheckLibraryStatus failed." ) );
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( pRemoteSocketAddress == NULL )
+    else if( pBandMask == NULL )
     {
-        LogError( ( "Cellular_SocketConnect: Invalid socket address." ) );
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
-    else if( socketHandle == NULL )
-    {
-        LogError( ( "Cellular_SocketConnect: Invalid socket handle." ) );
-        cellularStatus = CELLULAR_INVALID_HANDLE;
-    }
-    else if( ( socketHandle->socketState == SOCKETSTATE_CONNECTED ) || ( socketHandle->socketState == SOCKETSTATE_CONNECTING ) )
-    {
-        LogError( ( "Cellular_SocketConnect: Not allowed in state %d.", socketHandle->socketState ) );
-        cellularStatus = CELLULAR_NOT_ALLOWED;
-    }
     else
     {
-        cellularStatus = storeAccessModeAndAddress( pContext, socketHandle, dataAccessMode, pRemoteSocketAddress );
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
     }
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        /* Builds the Socket connect command. */
-        cellularStatus = buildSocketConnect( socketHandle, cmdBuf );
+        cellularStatus = sendBandMask( pContext, pModuleContext, pBandMask );
     }
 
     if( cellularStatus == CELLULAR_SUCCESS )
     {
-        /* Set the socket state to connecting state. If cellular modem returns error,
-         * revert the state to allocated state. */
-        socketHandle->socketState = SOCKETSTATE_CONNECTING;
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        pModuleContext->bandMask = *pBandMask;
+        pModuleContext->bandScanNarrowed = false;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    }
+
+    return cellularStatus;
+}
 
-        pktStatus = _Cellular_TimeoutAtcmdRequestWithCallback( pContext, atReqSocketConnect,
-                                                               SOCKET_CONNECT_PACKET_REQ_TIMEOUT_MS );
+/*-----------------------------------------------------------*/
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
-        {
-            LogError( ( "Cellular_SocketConnect: Socket connect failed, cmdBuf:%s, PktRet: %d", cmdBuf, pktStatus ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+/* Write the configured band masks if the scan is narrowed to the scan plan bands. */
+CellularError_t _Cellular_WidenBandScan( CellularContext_t * pContext,
+                                         cellularModuleContext_t * pModuleContext )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    bool bandScanNarrowed = false;
+    CellularBG96BandMask_t bandMask = { 0 };
 
-            /* Revert the state to allocated state. */
-            socketHandle->socketState = SOCKETSTATE_ALLOCATED;
+    /* Cellular_BG96SetBandMask may change the masks during the AT command. */
+    PlatformMutex_Lock( &pModuleContext->stateMutex );
+    bandScanNarrowed = pModuleContext->bandScanNarrowed;
+    bandMask = pModuleContext->bandMask;
+    PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+    if( bandScanNarrowed == true )
+    {
+        cellularStatus = sendBandMask( pContext, pModuleContext, &bandMask );
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            LogInfo( ( "_Cellular_WidenBandScan: scan all the configured bands" ) );
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pModuleContext->bandScanNarrowed = false;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
         }
     }
 
@@ -2978,97 +5546,154 @@ CellularError_t Cellular_SocketConnect( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_GetPdnStatus( CellularHandle_t cellularHandle,
-                                       CellularPdnStatus_t * pPdnStatusBuffers,
-                                       uint8_t numStatusBuffers,
-                                       uint8_t * pNumStatus )
+CellularError_t Cellular_BG96WidenBandScan( CellularHandle_t cellularHandle )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = _Cellular_WidenBandScan( pContext, pModuleContext );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Parse +QNWINFO: <Act>,<oper>,<band>,<channel>. */
+static CellularPktStatus_t _Cellular_RecvFuncGetCampedBand( CellularContext_t * pContext,
+                                                            const CellularATCommandResponse_t * pAtResp,
+                                                            void * pData,
+                                                            uint16_t dataLen )
 {
-    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    char * pInputLine = NULL;
+    char * pAct = NULL;
+    char * pToken = NULL;
+    int32_t bandNumber = 0;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    const CellularPdnStatus_t * pTempPdnStatusBuffer = pPdnStatusBuffers;
-    uint8_t numBuffers = 0;
-    CellularAtReq_t atReqGetPdnStatus =
-    {
-        "AT+QIACT?",
-        CELLULAR_AT_WITH_PREFIX,
-        "+QIACT",
-        _Cellular_RecvFuncGetPdnStatus,
-        pPdnStatusBuffers,
-        numStatusBuffers,
-    };
+    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+    CellularBG96BandMask_t * pCampedBandMask = NULL;
 
-    if( ( pTempPdnStatusBuffer == NULL ) || ( pNumStatus == NULL ) || ( numStatusBuffers < 1u ) )
+    if( pContext == NULL )
     {
-        cellularStatus = CELLULAR_BAD_PARAMETER;
-        LogWarn( ( "_Cellular_GetPdnStatus: Bad input Parameter " ) );
+        LogError( ( "GetCampedBand: Invalid context" ) );
+        pktStatus = CELLULAR_PKT_STATUS_FAILURE;
     }
-
-    if( cellularStatus == CELLULAR_SUCCESS )
+    else if( ( pAtResp == NULL ) || ( pAtResp->pItm == NULL ) ||
+             ( pAtResp->pItm->pLine == NULL ) || ( pData == NULL ) || ( dataLen != sizeof( CellularBG96BandMask_t ) ) )
     {
-        /* Make sure the library is open. */
-        cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+        LogError( ( "GetCampedBand: Invalid param" ) );
+        pktStatus = CELLULAR_PKT_STATUS_BAD_PARAM;
     }
-
-    if( cellularStatus == CELLULAR_SUCCESS )
+    else
     {
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetPdnStatus );
-        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
-    }
+        pInputLine = pAtResp->pItm->pLine;
+        pCampedBandMask = ( CellularBG96BandMask_t * ) pData;
+        atCoreStatus = Cellular_ATRemovePrefix( &pInputLine );
 
-    if( cellularStatus == CELLULAR_SUCCESS )
-    {
-        /* Populate the Valid number of statuses. */
-        *pNumStatus = 0;
-        numBuffers = numStatusBuffers;
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATRemoveAllDoubleQuote( pInputLine );
+        }
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATGetNextTok( &pInputLine, &pAct );
+        }
+
+        /* Skip the operator. */
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATGetNextTok( &pInputLine, &pToken );
+        }
+
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
+        {
+            atCoreStatus = Cellular_ATGetNextTok( &pInputLine, &pToken );
+        }
 
-        while( numBuffers != 0U )
+        if( atCoreStatus == CELLULAR_AT_SUCCESS )
         {
-            /* Check if the PDN state is valid. The context ID of the first
-             * invalid PDN status is set to FF. */
-            if( ( pTempPdnStatusBuffer->contextId <= CELLULAR_PDN_CONTEXT_ID_MAX ) &&
-                ( pTempPdnStatusBuffer->contextId != INVALID_PDN_INDEX ) )
+            if( strncmp( pToken, "LTE BAND ", strlen( "LTE BAND " ) ) == 0 )
+            {
+                atCoreStatus = Cellular_ATStrtoi( &pToken[ strlen( "LTE BAND " ) ], 10, &bandNumber );
+
+                if( atCoreStatus != CELLULAR_AT_SUCCESS )
+                {
+                    /* The band is not a number. */
+                }
+                else if( ( bandNumber < 1 ) || ( bandNumber > 64 ) )
+                {
+                    atCoreStatus = CELLULAR_AT_ERROR;
+                }
+                else if( strstr( pAct, "NB" ) != NULL )
+                {
+                    pCampedBandMask->nbiotBandMask = CELLULAR_BG96_LTE_BAND( bandNumber );
+                }
+                else
+                {
+                    pCampedBandMask->catm1BandMask = CELLULAR_BG96_LTE_BAND( bandNumber );
+                }
+            }
+            else if( strcmp( pToken, "GSM 900" ) == 0 )
+            {
+                pCampedBandMask->gsmBandMask = CELLULAR_BG96_GSM_BAND_900;
+            }
+            else if( strcmp( pToken, "GSM 1800" ) == 0 )
             {
-                ( *pNumStatus ) += 1U;
+                pCampedBandMask->gsmBandMask = CELLULAR_BG96_GSM_BAND_1800;
+            }
+            else if( strcmp( pToken, "GSM 850" ) == 0 )
+            {
+                pCampedBandMask->gsmBandMask = CELLULAR_BG96_GSM_BAND_850;
+            }
+            else if( strcmp( pToken, "GSM 1900" ) == 0 )
+            {
+                pCampedBandMask->gsmBandMask = CELLULAR_BG96_GSM_BAND_1900;
             }
             else
             {
-                break;
+                atCoreStatus = CELLULAR_AT_ERROR;
             }
+        }
 
-            numBuffers--;
-            pTempPdnStatusBuffer++;
+        if( atCoreStatus != CELLULAR_AT_SUCCESS )
+        {
+            /* "+QNWINFO: No Service" if the modem has no serving cell. */
+            LogDebug( ( "GetCampedBand: no serving cell band" ) );
+            pktStatus = _Cellular_TranslateAtCoreStatus( atCoreStatus );
         }
     }
 
-    return cellularStatus;
+    return pktStatus;
 }
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_GetSimCardStatus( CellularHandle_t cellularHandle,
-                                           CellularSimCardStatus_t * pSimCardStatus )
+CellularError_t Cellular_BG96GetCampedBand( CellularHandle_t cellularHandle,
+                                            CellularBG96BandMask_t * pCampedBandMask )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    CellularAtReq_t atReqGetSimCardStatus =
-    {
-        "AT+QSIMSTAT?",
-        CELLULAR_AT_WITH_PREFIX,
-        "+QSIMSTAT",
-        _Cellular_RecvFuncGetSimCardStatus,
-        &pSimCardStatus->simCardState,
-        sizeof( CellularSimCardState_t ),
-    };
-    CellularAtReq_t atReqGetSimLockStatus =
+    CellularAtReq_t atReqGetCampedBand =
     {
-        "AT+CPIN?",
+        "AT+QNWINFO",
         CELLULAR_AT_WITH_PREFIX,
-        "+CPIN",
-        _Cellular_RecvFuncGetSimLockStatus,
-        &pSimCardStatus->simCardLockState,
-        sizeof( CellularSimCardLockState_t ),
+        "+QNWINFO",
+        _Cellular_RecvFuncGetCampedBand,
+        NULL,
+        sizeof( CellularBG96BandMask_t ),
     };
 
     /* pContext is checked in _Cellular_CheckLibraryStatus function. */
@@ -3078,26 +5703,20 @@ CellularError_t Cellular_GetSimCardStatus( CellularHandle_t cellularHandle,
     {
         LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( pSimCardStatus == NULL )
+    else if( pCampedBandMask == NULL )
     {
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
     else
     {
-        /* Initialize the sim state and the sim lock state. */
-        pSimCardStatus->simCardState = CELLULAR_SIM_CARD_UNKNOWN;
-        pSimCardStatus->simCardLockState = CELLULAR_SIM_CARD_LOCK_UNKNOWN;
-
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetSimCardStatus );
+        ( void ) memset( pCampedBandMask, 0, sizeof( CellularBG96BandMask_t ) );
+        atReqGetCampedBand.pData = pCampedBandMask;
+        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetCampedBand );
 
-        if( pktStatus == CELLULAR_PKT_STATUS_OK )
+        if( pktStatus != CELLULAR_PKT_STATUS_OK )
         {
-            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetSimLockStatus );
+            cellularStatus = CELLULAR_UNKNOWN;
         }
-
-        cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
-        LogDebug( ( "_Cellular_GetSimStatus, Sim Insert State[%d], Lock State[%d]",
-                    pSimCardStatus->simCardState, pSimCardStatus->simCardLockState ) );
     }
 
     return cellularStatus;
@@ -3105,40 +5724,12 @@ CellularError_t Cellular_GetSimCardStatus( CellularHandle_t cellularHandle,
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_GetSimCardInfo( CellularHandle_t cellularHandle,
-                                         CellularSimCardInfo_t * pSimCardInfo )
+CellularError_t Cellular_BG96GetBootTiming( CellularHandle_t cellularHandle,
+                                            CellularBG96BootTiming_t * pBootTiming )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-
-    CellularAtReq_t atReqGetIccid =
-    {
-        "AT+QCCID",
-        CELLULAR_AT_WITH_PREFIX,
-        "+QCCID",
-        _Cellular_RecvFuncGetIccid,
-        pSimCardInfo->iccid,
-        CELLULAR_ICCID_MAX_SIZE + 1U,
-    };
-    CellularAtReq_t atReqGetImsi =
-    {
-        "AT+CIMI",
-        CELLULAR_AT_WO_PREFIX,
-        NULL,
-        _Cellular_RecvFuncGetImsi,
-        pSimCardInfo->imsi,
-        CELLULAR_IMSI_MAX_SIZE + 1U,
-    };
-    CellularAtReq_t atReqGetHplmn =
-    {
-        "AT+CRSM=176,28514,0,0,0",
-        CELLULAR_AT_WITH_PREFIX,
-        "+CRSM",
-        _Cellular_RecvFuncGetHplmn,
-        &pSimCardInfo->plmn,
-        sizeof( CellularPlmnInfo_t ),
-    };
+    cellularModuleContext_t * pModuleContext = NULL;
 
     /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
@@ -3147,90 +5738,89 @@ CellularError_t Cellular_GetSimCardInfo( CellularHandle_t cellularHandle,
     {
         LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( pSimCardInfo == NULL )
+    else if( pBootTiming == NULL )
     {
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
     else
     {
-        ( void ) memset( pSimCardInfo, 0, sizeof( CellularSimCardInfo_t ) );
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetImsi );
-
-        if( pktStatus == CELLULAR_PKT_STATUS_OK )
-        {
-            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetHplmn );
-        }
-
-        if( pktStatus == CELLULAR_PKT_STATUS_OK )
-        {
-            pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqGetIccid );
-        }
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
 
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
+    #if ( CELLULAR_BG96_BOOT_TIMING == 1 )
+        if( cellularStatus == CELLULAR_SUCCESS )
         {
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            *pBootTiming = pModuleContext->bootTiming;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
         }
-        else
+    #else
+        if( cellularStatus == CELLULAR_SUCCESS )
         {
-            LogDebug( ( "SimInfo updated: IMSI:%s, Hplmn:%s%s, ICCID:%s",
-                        pSimCardInfo->imsi, pSimCardInfo->plmn.mcc, pSimCardInfo->plmn.mnc,
-                        pSimCardInfo->iccid ) );
+            cellularStatus = CELLULAR_UNSUPPORTED;
         }
-    }
+    #endif /* CELLULAR_BG96_BOOT_TIMING. */
 
     return cellularStatus;
 }
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_RegisterUrcSignalStrengthChangedCallback( CellularHandle_t cellularHandle,
-                                                                   CellularUrcSignalStrengthChangedCallback_t signalStrengthChangedCallback,
-                                                                   void * pCallbackContext )
+CellularError_t Cellular_BG96SetSocketRequestClass( CellularHandle_t cellularHandle,
+                                                    CellularSocketHandle_t socketHandle,
+                                                    CellularBG96RequestClass_t requestClass )
 {
-    CellularError_t cellularStatus = CELLULAR_SUCCESS;
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
 
-    /* pContext is checked in the common library. */
-    cellularStatus = Cellular_CommonRegisterUrcSignalStrengthChangedCallback(
-        cellularHandle, signalStrengthChangedCallback, pCallbackContext );
+    /* pContext is checked in _Cellular_CheckLibraryStatus function. */
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
 
-    if( cellularStatus == CELLULAR_SUCCESS )
+    if( cellularStatus != CELLULAR_SUCCESS )
     {
-        if( signalStrengthChangedCallback != NULL )
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( ( socketHandle->socketId >= CELLULAR_NUM_SOCKET_MAX ) ||
+             ( requestClass >= CELLULAR_BG96_REQUEST_CLASS_MAX ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    #if ( CELLULAR_BG96_REQUEST_PRIORITY == 1 )
+        if( cellularStatus == CELLULAR_SUCCESS )
         {
-            cellularStatus = controlSignalStrengthIndication( pContext, true );
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pModuleContext->socketRequestClass[ socketHandle->socketId ] = requestClass;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
         }
-        else
+    #else
+        if( cellularStatus == CELLULAR_SUCCESS )
         {
-            cellularStatus = controlSignalStrengthIndication( pContext, false );
+            cellularStatus = CELLULAR_UNSUPPORTED;
         }
-    }
+    #endif /* CELLULAR_BG96_REQUEST_PRIORITY. */
 
     return cellularStatus;
 }
 
 /*-----------------------------------------------------------*/
 
-CellularError_t Cellular_GetHostByName( CellularHandle_t cellularHandle,
-                                        uint8_t contextId,
-                                        const char * pcHostName,
-                                        char * pResolvedAddress )
+CellularError_t Cellular_BG96GetRequestStats( CellularHandle_t cellularHandle,
+                                              CellularBG96RequestClass_t requestClass,
+                                              CellularBG96RequestStats_t * pRequestStats )
 {
     CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
-    CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
-    char cmdBuf[ CELLULAR_AT_CMD_QUERY_DNS_MAX_SIZE ];
-    cellularDnsQueryResult_t dnsQueryResult = CELLULAR_DNS_QUERY_UNKNOWN;
     cellularModuleContext_t * pModuleContext = NULL;
-    CellularAtReq_t atReqQueryDns =
-    {
-        cmdBuf,
-        CELLULAR_AT_NO_RESULT,
-        NULL,
-        NULL,
-        NULL,
-        0,
-    };
 
     /* pContext is checked in _Cellular_CheckLibraryStatus function. */
     cellularStatus = _Cellular_CheckLibraryStatus( pContext );
@@ -3239,65 +5829,28 @@ CellularError_t Cellular_GetHostByName( CellularHandle_t cellularHandle,
     {
         LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
     }
-    else if( ( pcHostName == NULL ) || ( pResolvedAddress == NULL ) )
+    else if( ( pRequestStats == NULL ) || ( requestClass >= CELLULAR_BG96_REQUEST_CLASS_MAX ) )
     {
         cellularStatus = CELLULAR_BAD_PARAMETER;
     }
     else
-    {
-        cellularStatus = _Cellular_IsValidPdn( contextId );
-    }
-
-    if( cellularStatus == CELLULAR_SUCCESS )
     {
         cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
     }
 
-    if( cellularStatus == CELLULAR_SUCCESS )
-    {
-        PlatformMutex_Lock( &pModuleContext->contextMutex );
-        pModuleContext->dnsResultNumber = 0;
-        pModuleContext->dnsIndex = 0;
-        ( void ) xQueueReset( pModuleContext->pktDnsQueue );
-        cellularStatus = registerDnsEventCallback( pModuleContext, _dnsResultCallback, pResolvedAddress );
-    }
-
-    /* Send the AT command and wait the URC result. */
-    if( cellularStatus == CELLULAR_SUCCESS )
-    {
-        /* The return value of snprintf is not used.
-         * The max length of the string is fixed and checked offline. */
-        ( void ) snprintf( cmdBuf, CELLULAR_AT_CMD_QUERY_DNS_MAX_SIZE,
-                           "AT+QIDNSGIP=%u,\"%s\"", contextId, pcHostName );
-        pktStatus = _Cellular_AtcmdRequestWithCallback( pContext, atReqQueryDns );
-
-        if( pktStatus != CELLULAR_PKT_STATUS_OK )
-        {
-            LogError( ( "Cellular_GetHostByName: couldn't resolve host name" ) );
-            cellularStatus = _Cellular_TranslatePktStatus( pktStatus );
-            PlatformMutex_Unlock( &pModuleContext->contextMutex );
-        }
-    }
-
-    /* URC handler calls the callback to unblock this function. */
-    if( cellularStatus == CELLULAR_SUCCESS )
-    {
-        if( xQueueReceive( pModuleContext->pktDnsQueue, &dnsQueryResult,
-                           pdMS_TO_TICKS( DNS_QUERY_TIMEOUT_MS ) ) == pdTRUE )
+    #if ( CELLULAR_BG96_REQUEST_PRIORITY == 1 )
+        if( cellularStatus == CELLULAR_SUCCESS )
         {
-            if( dnsQueryResult != CELLULAR_DNS_QUERY_SUCCESS )
-            {
-                cellularStatus = CELLULAR_UNKNOWN;
-            }
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            *pRequestStats = pModuleContext->requestStats[ requestClass ];
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
         }
-        else
+    #else
+        if( cellularStatus == CELLULAR_SUCCESS )
         {
-            ( void ) registerDnsEventCallback( pModuleContext, NULL, NULL );
-            cellularStatus = CELLULAR_TIMEOUT;
+            cellularStatus = CELLULAR_UNSUPPORTED;
         }
-
-        PlatformMutex_Unlock( &pModuleContext->contextMutex );
-    }
+    #endif /* CELLULAR_BG96_REQUEST_PRIORITY. */
 
     return cellularStatus;
 }
@@ -0,0 +1,209 @@
+/*
+ * FreeRTOS-Cellular-Interface v1.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ */
+
+/* The config header is always included first. */
+#include "cellular_config.h"
+#include "cellular_config_defaults.h"
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+#include "cellular_platform.h"
+#include "cellular_types.h"
+#include "cellular_common.h"
+#include "cellular_bg96.h"
+
+/*-----------------------------------------------------------*/
+
+/* Decimal digits of UINT32_MAX. */
+#define AT_BUILDER_UINT32_DIGITS    ( 10U )
+
+/* Hexadecimal digits of UINT64_MAX. */
+#define AT_BUILDER_UINT64_XDIGITS    ( 16U )
+
+/*-----------------------------------------------------------*/
+
+static void appendChars( cellularAtBuilder_t * pBuilder,
+                         const char * pChars,
+                         uint32_t charCount );
+
+/*-----------------------------------------------------------*/
+
+/* Nothing is appended once the builder has failed. The buffer stays terminated. */
+static void appendChars( cellularAtBuilder_t * pBuilder,
+                         const char * pChars,
+                         uint32_t charCount )
+{
+    if( pBuilder->status == CELLULAR_SUCCESS )
+    {
+        if( charCount >= ( pBuilder->bufSize - pBuilder->length ) )
+        {
+            pBuilder->status = CELLULAR_NO_MEMORY;
+        }
+        else
+        {
+            ( void ) memcpy( &pBuilder->pBuf[ pBuilder->length ], pChars, charCount );
+            pBuilder->length = pBuilder->length + charCount;
+            pBuilder->pBuf[ pBuilder->length ] = '\0';
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_AtBuilderInit( cellularAtBuilder_t * pBuilder,
+                              char * pBuf,
+                              uint32_t bufSize )
+{
+    pBuilder->pBuf = pBuf;
+    pBuilder->bufSize = bufSize;
+    pBuilder->length = 0;
+
+    if( ( pBuf == NULL ) || ( bufSize == 0U ) )
+    {
+        pBuilder->status = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        pBuilder->status = CELLULAR_SUCCESS;
+        pBuf[ 0 ] = '\0';
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_AtBuilderAppendLiteral( cellularAtBuilder_t * pBuilder,
+                                       const char * pLiteral )
+{
+    appendChars( pBuilder, pLiteral, ( uint32_t ) strlen( pLiteral ) );
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_AtBuilderAppendUnsigned( cellularAtBuilder_t * pBuilder,
+                                        uint32_t value )
+{
+    char digits[ AT_BUILDER_UINT32_DIGITS ];
+    uint32_t index = AT_BUILDER_UINT32_DIGITS;
+    uint32_t remaining = value;
+
+    /* Fill the digits from the end. At least one digit for 0. */
+    do
+    {
+        index--;
+        digits[ index ] = ( char ) ( '0' + ( char ) ( remaining % 10U ) );
+        remaining = remaining / 10U;
+    } while( remaining != 0U );
+
+    appendChars( pBuilder, &digits[ index ], AT_BUILDER_UINT32_DIGITS - index );
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_AtBuilderAppendSigned( cellularAtBuilder_t * pBuilder,
+                                      int32_t value )
+{
+    uint32_t magnitude = ( uint32_t ) value;
+
+    if( value < 0 )
+    {
+        /* Two's complement negation also covers INT32_MIN. */
+        magnitude = ( ~magnitude ) + 1U;
+        appendChars( pBuilder, "-", 1U );
+    }
+
+    _Cellular_AtBuilderAppendUnsigned( pBuilder, magnitude );
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_AtBuilderAppendHex( cellularAtBuilder_t * pBuilder,
+                                   uint64_t value )
+{
+    static const char hexDigits[] = "0123456789abcdef";
+    char digits[ AT_BUILDER_UINT64_XDIGITS ];
+    uint32_t index = AT_BUILDER_UINT64_XDIGITS;
+    uint64_t remaining = value;
+
+    do
+    {
+        index--;
+        digits[ index ] = hexDigits[ remaining & 0x0FU ];
+        remaining = remaining >> 4;
+    } while( remaining != 0U );
+
+    appendChars( pBuilder, &digits[ index ], AT_BUILDER_UINT64_XDIGITS - index );
+}
+
+/*-----------------------------------------------------------*/
+
+/* A quote would end the string and control characters the command line. The
+ * \HH escapes of ITU-T V.250 are not known to be decoded by the BG96, so a
+ * backslash is not sent either. All of them are rejected. */
+void _Cellular_AtBuilderAppendQuoted( cellularAtBuilder_t * pBuilder,
+                                      const char * pString )
+{
+    uint32_t i = 0;
+
+    if( pString == NULL )
+    {
+        pBuilder->status = CELLULAR_BAD_PARAMETER;
+    }
+
+    appendChars( pBuilder, "\"", 1U );
+
+    while( ( pBuilder->status == CELLULAR_SUCCESS ) && ( pString[ i ] != '\0' ) )
+    {
+        if( ( pString[ i ] == '"' ) || ( pString[ i ] == '\\' ) ||
+            ( ( uint8_t ) pString[ i ] < 0x20U ) || ( ( uint8_t ) pString[ i ] == 0x7FU ) )
+        {
+            pBuilder->status = CELLULAR_BAD_PARAMETER;
+        }
+        else
+        {
+            appendChars( pBuilder, &pString[ i ], 1U );
+        }
+
+        i++;
+    }
+
+    appendChars( pBuilder, "\"", 1U );
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t _Cellular_AtBuilderStatus( const cellularAtBuilder_t * pBuilder )
+{
+    if( pBuilder->status != CELLULAR_SUCCESS )
+    {
+        LogError( ( "AT command builder failed %d: %s", pBuilder->status,
+                    ( pBuilder->pBuf != NULL ) ? pBuilder->pBuf : "" ) );
+    }
+
+    return pBuilder->status;
+}
+
+/*-----------------------------------------------------------*/
@@ -0,0 +1,1590 @@
+/*
+ * FreeRTOS-Cellular-Interface v1.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ */
+
+/* The config header is always included first. */
+#include "cellular_config.h"
+#include "cellular_config_defaults.h"
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+#include "cellular_platform.h"
+#include "cellular_types.h"
+#include "cellular_comm_interface.h"
+#include "cellular_at_core.h"
+
+#include "cellular_bg96.h"
+#include "cellular_bg96_cmux.h"
+
+#if ( CELLULAR_BG96_CMUX == 1 )
+
+/*-----------------------------------------------------------*/
+
+/* AT+IPR is not allowed once the UART is multiplexed. */
+    #if ( CELLULAR_BG96_BAUD_RATE > 0U )
+        #error "CELLULAR_BG96_BAUD_RATE can not be used with CELLULAR_BG96_CMUX."
+    #endif
+
+    #define CMUX_FLAG                     ( 0xF9U )
+    #define CMUX_ADDRESS_EA               ( 0x01U )
+    #define CMUX_ADDRESS_CR               ( 0x02U )
+    #define CMUX_LENGTH_EA                ( 0x01U )
+    #define CMUX_CONTROL_PF               ( 0x10U )
+
+    #define CMUX_FRAME_SABM               ( 0x2FU )
+    #define CMUX_FRAME_UA                 ( 0x63U )
+    #define CMUX_FRAME_DM                 ( 0x0FU )
+    #define CMUX_FRAME_DISC               ( 0x43U )
+    #define CMUX_FRAME_UIH                ( 0xEFU )
+    #define CMUX_FRAME_UI                 ( 0x03U )
+
+    #define CMUX_FCS_INIT                 ( 0xFFU )
+    #define CMUX_FCS_POLYNOMIAL           ( 0xE0U ) /* Reversed x^8 + x^2 + x + 1. */
+    #define CMUX_FCS_GOOD                 ( 0xCFU )
+
+/* Control channel message types, EA bit set and C/R bit clear. */
+    #define CMUX_MSG_EA                   ( 0x01U )
+    #define CMUX_MSG_CR                   ( 0x02U )
+    #define CMUX_MSG_CLD                  ( 0xC1U )
+    #define CMUX_MSG_MSC                  ( 0xE1U )
+    #define CMUX_MSG_FCON                 ( 0xA1U )
+    #define CMUX_MSG_FCOFF                ( 0x61U )
+
+/* V.24 signals of the MSC message. */
+    #define CMUX_V24_FC                   ( 0x02U )
+    #define CMUX_V24_RTC                  ( 0x04U )
+    #define CMUX_V24_RTR                  ( 0x08U )
+    #define CMUX_V24_DV                   ( 0x80U )
+
+/* Flag, address, control, one length byte, FCS and flag. */
+    #define CMUX_FRAME_OVERHEAD           ( 6U )
+    #define CMUX_TX_FRAME_SIZE            ( CELLULAR_BG96_CMUX_FRAME_SIZE + CMUX_FRAME_OVERHEAD )
+
+/* Frames received with a larger information field are dropped. */
+    #define CMUX_RX_INFO_SIZE             ( 127U )
+    #define CMUX_PHY_RECV_BUFFER_SIZE     ( 64U )
+    #define CMUX_THREAD_POLL_MS           ( 100U )
+    #define CMUX_FRAME_SEND_TIMEOUT_MS    ( 1000U )
+
+    #define CMUX_AT_COMMAND               "AT+CMUX=0\r"
+    #define CMUX_AT_RESPONSE_SIZE         ( 64U )
+
+/* Lines longer than this are truncated. Only the start of a line is matched. */
+    #define CMUX_SOCKET_LINE_SIZE         ( 32U )
+    #define CMUX_SOCKET_PROMPT            "> "
+
+    #define CMUX_EVT_PHY_RX               ( 0x0001U )
+    #define CMUX_EVT_STOP                 ( 0x0002U )
+    #define CMUX_EVT_THREAD_STOPPED       ( 0x0004U )
+    #define CMUX_EVT_UA                   ( 0x0008U )
+    #define CMUX_EVT_DM                   ( 0x0010U )
+    #define CMUX_EVT_FLOW                 ( 0x0020U )
+    #define CMUX_EVT_CHANNEL_RX( dlci )    ( ( PlatformEventGroup_EventBits ) 0x0100U << ( dlci ) )
+
+/*-----------------------------------------------------------*/
+
+    typedef enum cmuxDecodeState
+    {
+        CMUX_DECODE_FLAG,
+        CMUX_DECODE_ADDRESS,
+        CMUX_DECODE_CONTROL,
+        CMUX_DECODE_LENGTH,
+        CMUX_DECODE_LENGTH_2,
+        CMUX_DECODE_INFO,
+        CMUX_DECODE_FCS,
+        CMUX_DECODE_END_FLAG
+    } cmuxDecodeState_t;
+
+    typedef struct cmuxDecoder
+    {
+        cmuxDecodeState_t state;
+        uint8_t header[ 4 ];                    /* Address, control and up to two length bytes. */
+        uint8_t headerLength;
+        uint16_t infoLength;
+        uint16_t infoReceived;
+        uint8_t fcs;
+        uint8_t info[ CMUX_RX_INFO_SIZE ];
+    } cmuxDecoder_t;
+
+    typedef struct cmuxChannel
+    {
+        uint8_t dlci;
+        bool established;                       /* SABM acknowledged by the modem. */
+        bool txStopped;                         /* FC bit of the last MSC from the modem. */
+        bool rxMutexCreated;
+        CellularCommInterfaceReceiveCallback_t receiveCallback;
+        void * pUserData;
+        PlatformMutex_t rxMutex;
+        uint32_t rxHead;
+        uint32_t rxTail;
+        uint32_t rxCount;
+        uint32_t rxDropped;
+        uint8_t rxBuffer[ CELLULAR_BG96_CMUX_RX_BUFFER_SIZE ];
+    } cmuxChannel_t;
+
+    typedef struct cmuxContext
+    {
+        bool started;
+        bool threadStarted;
+        bool txStopped;                         /* FCoff received from the modem. */
+        bool txMutexCreated;
+        bool socketMutexCreated;
+        const CellularCommInterface_t * pPhysicalCommIntf;
+        CellularCommInterfaceHandle_t physicalCommHandle;
+        PlatformEventGroupHandle_t events;
+        PlatformMutex_t txMutex;
+        PlatformMutex_t socketMutex;            /* One socket command at a time on the socket DLCI. */
+        uint8_t txFrame[ CMUX_TX_FRAME_SIZE ];
+        cmuxDecoder_t decoder;
+        cmuxChannel_t channels[ CELLULAR_BG96_CMUX_CHANNELS + 1U ]; /* Index is the DLCI. */
+    } cmuxContext_t;
+
+/*-----------------------------------------------------------*/
+
+    static uint8_t cmuxFcs( const uint8_t * pData,
+                            uint32_t dataLength,
+                            uint8_t initFcs );
+    static uint32_t cmuxEncodeFrame( uint8_t * pFrame,
+                                     uint8_t dlci,
+                                     bool command,
+                                     uint8_t control,
+                                     const uint8_t * pInfo,
+                                     uint32_t infoLength );
+    static CellularCommInterfaceError_t cmuxSendFrame( uint8_t dlci,
+                                                       bool command,
+                                                       uint8_t control,
+                                                       const uint8_t * pInfo,
+                                                       uint32_t infoLength,
+                                                       uint32_t timeoutMilliseconds );
+    static void cmuxDeliverData( cmuxChannel_t * pChannel,
+                                 const uint8_t * pData,
+                                 uint32_t dataLength );
+    static void cmuxHandleControlMessage( const uint8_t * pInfo,
+                                          uint32_t infoLength );
+    static void cmuxHandleFrame( uint8_t address,
+                                 uint8_t control,
+                                 const uint8_t * pInfo,
+                                 uint32_t infoLength );
+    static void cmuxDecodeByte( cmuxDecoder_t * pDecoder,
+                                uint8_t byte );
+    static void cmuxThread( void * pUserData );
+    static CellularCommInterfaceError_t cmuxPhysicalRxCallback( void * pUserData,
+                                                                CellularCommInterfaceHandle_t commInterfaceHandle );
+    static CellularError_t cmuxEnterMuxMode( void );
+    static CellularError_t cmuxOpenDlci( uint8_t dlci );
+    static void cmuxCloseDlci( uint8_t dlci );
+    static void cmuxShutdown( void );
+    static CellularCommInterfaceError_t cmuxChannelOpen( uint8_t dlci,
+                                                         CellularCommInterfaceReceiveCallback_t receiveCallback,
+                                                         void * pUserData,
+                                                         CellularCommInterfaceHandle_t * pCommInterfaceHandle );
+    static CellularCommInterfaceError_t cmuxChannel1Open( CellularCommInterfaceReceiveCallback_t receiveCallback,
+                                                          void * pUserData,
+                                                          CellularCommInterfaceHandle_t * pCommInterfaceHandle );
+    #if ( CELLULAR_BG96_CMUX_CHANNELS > 1U )
+        static CellularCommInterfaceError_t cmuxChannel2Open( CellularCommInterfaceReceiveCallback_t receiveCallback,
+                                                              void * pUserData,
+                                                              CellularCommInterfaceHandle_t * pCommInterfaceHandle );
+    #endif
+    #if ( CELLULAR_BG96_CMUX_CHANNELS > 2U )
+        static CellularCommInterfaceError_t cmuxChannel3Open( CellularCommInterfaceReceiveCallback_t receiveCallback,
+                                                              void * pUserData,
+                                                              CellularCommInterfaceHandle_t * pCommInterfaceHandle );
+    #endif
+    static CellularCommInterfaceError_t cmuxChannelSend( CellularCommInterfaceHandle_t commInterfaceHandle,
+                                                         const uint8_t * pData,
+                                                         uint32_t dataLength,
+                                                         uint32_t timeoutMilliseconds,
+                                                         uint32_t * pDataSentLength );
+    static CellularCommInterfaceError_t cmuxChannelRecv( CellularCommInterfaceHandle_t commInterfaceHandle,
+                                                         uint8_t * pBuffer,
+                                                         uint32_t bufferLength,
+                                                         uint32_t timeoutMilliseconds,
+                                                         uint32_t * pDataReceivedLength );
+    static CellularCommInterfaceError_t cmuxChannelClose( CellularCommInterfaceHandle_t commInterfaceHandle );
+    #if ( CELLULAR_BG96_CMUX_SOCKET_DLCI > 0U )
+        static void cmuxSocketFlush( cmuxChannel_t * pChannel );
+        static CellularError_t cmuxSocketRead( cmuxChannel_t * pChannel,
+                                               uint8_t * pBuffer,
+                                               uint32_t length,
+                                               TickType_t startTick,
+                                               TickType_t timeoutTicks );
+        static CellularError_t cmuxSocketWaitLine( cmuxChannel_t * pChannel,
+                                                   const char * pPrefix,
+                                                   char * pLine,
+                                                   TickType_t startTick,
+                                                   TickType_t timeoutTicks );
+        static CellularError_t cmuxSocketCommand( cmuxChannel_t * pChannel,
+                                                  const char * pAtCmd );
+        static CellularError_t cmuxSocketChannelInit( void );
+    #endif
+
+/*-----------------------------------------------------------*/
+
+    static cmuxContext_t cmuxContext = { 0 };
+
+/* The open function of each interface binds it to its DLCI. */
+    static const CellularCommInterface_t cmuxCommInterfaces[ CELLULAR_BG96_CMUX_CHANNELS ] =
+    {
+        { cmuxChannel1Open, cmuxChannelSend, cmuxChannelRecv, cmuxChannelClose },
+        #if ( CELLULAR_BG96_CMUX_CHANNELS > 1U )
+            { cmuxChannel2Open, cmuxChannelSend, cmuxChannelRecv, cmuxChannelClose },
+        #endif
+        #if ( CELLULAR_BG96_CMUX_CHANNELS > 2U )
+            { cmuxChannel3Open, cmuxChannelSend, cmuxChannelRecv, cmuxChannelClose },
+        #endif
+    };
+
+/*-----------------------------------------------------------*/
+
+/* Reflected CRC-8 of 27.010 section 5.2.1.6. Pass CMUX_FCS_INIT to start. */
+    static uint8_t cmuxFcs( const uint8_t * pData,
+                            uint32_t dataLength,
+                            uint8_t initFcs )
+    {
+        uint8_t fcs = initFcs;
+        uint32_t i = 0;
+        uint8_t bit = 0;
+
+        for( i = 0; i < dataLength; i++ )
+        {
+            fcs = fcs ^ pData[ i ];
+
+            for( bit = 0; bit < 8U; bit++ )
+            {
+                if( ( fcs & 0x01U ) != 0U )
+                {
+                    fcs = ( uint8_t ) ( ( fcs >> 1 ) ^ CMUX_FCS_POLYNOMIAL );
+                }
+                else
+                {
+                    fcs = ( uint8_t ) ( fcs >> 1 );
+                }
+            }
+        }
+
+        return fcs;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* The FCS of UIH frames covers the address, control and length fields only.
+ * Frames sent by this side carry at most 127 bytes so the length is one byte. */
+    static uint32_t cmuxEncodeFrame( uint8_t * pFrame,
+                                     uint8_t dlci,
+                                     bool command,
+                                     uint8_t control,
+                                     const uint8_t * pInfo,
+                                     uint32_t infoLength )
+    {
+        uint32_t frameLength = 0;
+        uint8_t address = ( uint8_t ) ( ( uint32_t ) dlci << 2 ) | CMUX_ADDRESS_EA;
+
+        /* This side is the initiator. C/R is set in its commands and clear in its responses. */
+        if( command == true )
+        {
+            address = address | CMUX_ADDRESS_CR;
+        }
+
+        pFrame[ frameLength++ ] = CMUX_FLAG;
+        pFrame[ frameLength++ ] = address;
+        pFrame[ frameLength++ ] = control;
+        pFrame[ frameLength++ ] = ( uint8_t ) ( infoLength << 1 ) | CMUX_LENGTH_EA;
+
+        if( infoLength > 0U )
+        {
+            ( void ) memcpy( &pFrame[ frameLength ], pInfo, infoLength );
+            frameLength = frameLength + infoLength;
+        }
+
+        pFrame[ frameLength++ ] = ( uint8_t ) ( 0xFFU - cmuxFcs( &pFrame[ 1 ], 3U, CMUX_FCS_INIT ) );
+        pFrame[ frameLength++ ] = CMUX_FLAG;
+
+        return frameLength;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static CellularCommInterfaceError_t cmuxSendFrame( uint8_t dlci,
+                                                       bool command,
+                                                       uint8_t control,
+                                                       const uint8_t * pInfo,
+                                                       uint32_t infoLength,
+                                                       uint32_t timeoutMilliseconds )
+    {
+        cmuxContext_t * pCmux = &cmuxContext;
+        CellularCommInterfaceError_t commIntRet = IOT_COMM_INTERFACE_SUCCESS;
+        uint32_t frameLength = 0;
+        uint32_t sentLength = 0;
+
+        PlatformMutex_Lock( &pCmux->txMutex );
+
+        frameLength = cmuxEncodeFrame( pCmux->txFrame, dlci, command, control, pInfo, infoLength );
+        commIntRet = pCmux->pPhysicalCommIntf->send( pCmux->physicalCommHandle, pCmux->txFrame,
+                                                     frameLength, timeoutMilliseconds, &sentLength );
+
+        PlatformMutex_Unlock( &pCmux->txMutex );
+
+        if( ( commIntRet == IOT_COMM_INTERFACE_SUCCESS ) && ( sentLength != frameLength ) )
+        {
+            /* A partial frame can not be recovered by the receiver. */
+            LogError( ( "cmuxSendFrame: DLCI %u sent %u of %u bytes", dlci, sentLength, frameLength ) );
+            commIntRet = IOT_COMM_INTERFACE_TIMEOUT;
+        }
+
+        return commIntRet;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* The receive callback of the channel user is called from the demux thread. The
+ * common library signals its event group from this callback with the ISR variant,
+ * which FreeRTOS also accepts from a task. */
+    static void cmuxDeliverData( cmuxChannel_t * pChannel,
+                                 const uint8_t * pData,
+                                 uint32_t dataLength )
+    {
+        cmuxContext_t * pCmux = &cmuxContext;
+        uint32_t i = 0;
+
+        PlatformMutex_Lock( &pChannel->rxMutex );
+
+        for( i = 0; i < dataLength; i++ )
+        {
+            if( pChannel->rxCount < CELLULAR_BG96_CMUX_RX_BUFFER_SIZE )
+            {
+                pChannel->rxBuffer[ pChannel->rxHead ] = pData[ i ];
+                pChannel->rxHead = ( pChannel->rxHead + 1U ) % CELLULAR_BG96_CMUX_RX_BUFFER_SIZE;
+                pChannel->rxCount++;
+            }
+            else
+            {
+                pChannel->rxDropped++;
+            }
+        }
+
+        PlatformMutex_Unlock( &pChannel->rxMutex );
+
+        if( pChannel->rxDropped > 0U )
+        {
+            LogWarn( ( "cmuxDeliverData: DLCI %u dropped %u bytes", pChannel->dlci, pChannel->rxDropped ) );
+            pChannel->rxDropped = 0;
+        }
+
+        ( void ) PlatformEventGroup_SetBits( pCmux->events, CMUX_EVT_CHANNEL_RX( pChannel->dlci ) );
+
+        if( pChannel->receiveCallback != NULL )
+        {
+            ( void ) pChannel->receiveCallback( pChannel->pUserData, ( CellularCommInterfaceHandle_t ) pChannel );
+        }
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Commands from the modem are answered with the same message with C/R clear. */
+    static void cmuxHandleControlMessage( const uint8_t * pInfo,
+                                          uint32_t infoLength )
+    {
+        cmuxContext_t * pCmux = &cmuxContext;
+        uint8_t messageType = 0;
+        uint8_t dlci = 0;
+        uint8_t response[ CMUX_RX_INFO_SIZE ] = { 0 };
+
+        if( infoLength >= 2U )
+        {
+            messageType = pInfo[ 0 ] & ( uint8_t ) ~CMUX_MSG_CR;
+
+            if( messageType == CMUX_MSG_MSC )
+            {
+                /* Type, length, DLCI address and V.24 signals. */
+                if( infoLength >= 4U )
+                {
+                    dlci = pInfo[ 2 ] >> 2;
+
+                    if( ( dlci > 0U ) && ( dlci <= CELLULAR_BG96_CMUX_CHANNELS ) )
+                    {
+                        pCmux->channels[ dlci ].txStopped = ( ( pInfo[ 3 ] & CMUX_V24_FC ) != 0U ) ? true : false;
+                        ( void ) PlatformEventGroup_SetBits( pCmux->events, CMUX_EVT_FLOW );
+                    }
+                }
+            }
+            else if( messageType == CMUX_MSG_FCOFF )
+            {
+                pCmux->txStopped = true;
+            }
+            else if( messageType == CMUX_MSG_FCON )
+            {
+                pCmux->txStopped = false;
+                ( void ) PlatformEventGroup_SetBits( pCmux->events, CMUX_EVT_FLOW );
+            }
+            else
+            {
+                /* Other messages only need the response. */
+            }
+
+            if( ( pInfo[ 0 ] & CMUX_MSG_CR ) != 0U )
+            {
+                ( void ) memcpy( response, pInfo, infoLength );
+                response[ 0 ] = messageType;
+                ( void ) cmuxSendFrame( 0U, true, CMUX_FRAME_UIH, response, infoLength, CMUX_FRAME_SEND_TIMEOUT_MS );
+            }
+        }
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void cmuxHandleFrame( uint8_t address,
+                                 uint8_t control,
+                                 const uint8_t * pInfo,
+                                 uint32_t infoLength )
+    {
+        cmuxContext_t * pCmux = &cmuxContext;
+        uint8_t dlci = address >> 2;
+        uint8_t frameType = control & ( uint8_t ) ~CMUX_CONTROL_PF;
+
+        if( dlci > CELLULAR_BG96_CMUX_CHANNELS )
+        {
+            LogDebug( ( "cmuxHandleFrame: frame 0x%02x for unused DLCI %u", frameType, dlci ) );
+        }
+        else if( frameType == CMUX_FRAME_UA )
+        {
+            ( void ) PlatformEventGroup_SetBits( pCmux->events, CMUX_EVT_UA );
+        }
+        else if( frameType == CMUX_FRAME_DM )
+        {
+            ( void ) PlatformEventGroup_SetBits( pCmux->events, CMUX_EVT_DM );
+        }
+        else if( frameType == CMUX_FRAME_DISC )
+        {
+            pCmux->channels[ dlci ].established = false;
+            ( void ) cmuxSendFrame( dlci, false, CMUX_FRAME_UA | CMUX_CONTROL_PF, NULL, 0U, CMUX_FRAME_SEND_TIMEOUT_MS );
+        }
+        else if( frameType == CMUX_FRAME_SABM )
+        {
+            /* DLCIs are only established by this side. */
+            ( void ) cmuxSendFrame( dlci, false, CMUX_FRAME_DM | CMUX_CONTROL_PF, NULL, 0U, CMUX_FRAME_SEND_TIMEOUT_MS );
+        }
+        else if( ( frameType == CMUX_FRAME_UIH ) || ( frameType == CMUX_FRAME_UI ) )
+        {
+            if( dlci == 0U )
+            {
+                cmuxHandleControlMessage( pInfo, infoLength );
+            }
+            else if( infoLength > 0U )
+            {
+                cmuxDeliverData( &pCmux->channels[ dlci ], pInfo, infoLength );
+            }
+            else
+            {
+                /* Empty information field. */
+            }
+        }
+        else
+        {
+            LogDebug( ( "cmuxHandleFrame: unknown frame 0x%02x on DLCI %u", control, dlci ) );
+        }
+    }
+
+/*-----------------------------------------------------------*/
+
+/* A single flag may close one frame and open the next one. */
+    static void cmuxDecodeByte( cmuxDecoder_t * pDecoder,
+                                uint8_t byte )
+    {
+        uint8_t fcs = 0;
+
+        switch( pDecoder->state )
+        {
+            case CMUX_DECODE_FLAG:
+
+                if( byte == CMUX_FLAG )
+                {
+                    pDecoder->state = CMUX_DECODE_ADDRESS;
+                }
+
+                break;
+
+            case CMUX_DECODE_ADDRESS:
+
+                if( byte != CMUX_FLAG )
+                {
+                    pDecoder->header[ 0 ] = byte;
+                    pDecoder->headerLength = 1;
+                    pDecoder->state = CMUX_DECODE_CONTROL;
+                }
+
+                break;
+
+            case CMUX_DECODE_CONTROL:
+                pDecoder->header[ pDecoder->headerLength++ ] = byte;
+                pDecoder->state = CMUX_DECODE_LENGTH;
+                break;
+
+            case CMUX_DECODE_LENGTH:
+            case CMUX_DECODE_LENGTH_2:
+                pDecoder->header[ pDecoder->headerLength++ ] = byte;
+
+                if( pDecoder->state == CMUX_DECODE_LENGTH )
+                {
+                    pDecoder->infoLength = byte >> 1;
+                }
+                else
+                {
+                    pDecoder->infoLength = pDecoder->infoLength | ( uint16_t ) ( ( uint16_t ) byte << 7 );
+                }
+
+                pDecoder->infoReceived = 0;
+
+                if( ( pDecoder->state == CMUX_DECODE_LENGTH ) && ( ( byte & CMUX_LENGTH_EA ) == 0U ) )
+                {
+                    pDecoder->state = CMUX_DECODE_LENGTH_2;
+                }
+                else if( pDecoder->infoLength > 0U )
+                {
+                    pDecoder->state = CMUX_DECODE_INFO;
+                }
+                else
+                {
+                    pDecoder->state = CMUX_DECODE_FCS;
+                }
+
+                break;
+
+            case CMUX_DECODE_INFO:
+
+                /* Bytes past the buffer are counted and the frame is dropped at the end. */
+                if( pDecoder->infoReceived < CMUX_RX_INFO_SIZE )
+                {
+                    pDecoder->info[ pDecoder->infoReceived ] = byte;
+                }
+
+                pDecoder->infoReceived++;
+
+                if( pDecoder->infoReceived == pDecoder->infoLength )
+                {
+                    pDecoder->state = CMUX_DECODE_FCS;
+                }
+
+                break;
+
+            case CMUX_DECODE_FCS:
+                pDecoder->fcs = byte;
+                pDecoder->state = CMUX_DECODE_END_FLAG;
+                break;
+
+            case CMUX_DECODE_END_FLAG:
+            default:
+
+                if( byte != CMUX_FLAG )
+                {
+                    LogDebug( ( "cmuxDecodeByte: missing closing flag" ) );
+                    pDecoder->state = CMUX_DECODE_FLAG;
+                }
+                else
+                {
+                    fcs = cmuxFcs( pDecoder->header, pDecoder->headerLength, CMUX_FCS_INIT );
+
+                    /* The FCS of the other frame types also covers the information field. */
+                    if( ( ( pDecoder->header[ 1 ] & ( uint8_t ) ~CMUX_CONTROL_PF ) != CMUX_FRAME_UIH ) &&
+                        ( pDecoder->infoLength <= CMUX_RX_INFO_SIZE ) )
+                    {
+                        fcs = cmuxFcs( pDecoder->info, pDecoder->infoLength, fcs );
+                    }
+
+                    fcs = cmuxFcs( &pDecoder->fcs, 1U, fcs );
+
+                    if( fcs != CMUX_FCS_GOOD )
+                    {
+                        LogDebug( ( "cmuxDecodeByte: bad FCS" ) );
+                    }
+                    else if( pDecoder->infoLength > CMUX_RX_INFO_SIZE )
+                    {
+                        LogWarn( ( "cmuxDecodeByte: frame of %u bytes dropped", pDecoder->infoLength ) );
+                    }
+                    else
+                    {
+                        cmuxHandleFrame( pDecoder->header[ 0 ], pDecoder->header[ 1 ],
+                                         pDecoder->info, pDecoder->infoLength );
+                    }
+
+                    pDecoder->state = CMUX_DECODE_ADDRESS;
+                }
+
+                break;
+        }
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void cmuxThread( void * pUserData )
+    {
+        cmuxContext_t * pCmux = ( cmuxContext_t * ) pUserData;
+        uint8_t recvBuffer[ CMUX_PHY_RECV_BUFFER_SIZE ] = { 0 };
+        uint32_t recvLength = 0;
+        uint32_t i = 0;
+        PlatformEventGroup_EventBits uxBits = 0;
+
+        for( ; ; )
+        {
+            /* Poll as well in case the physical interface missed a receive callback. */
+            uxBits = PlatformEventGroup_WaitBits( pCmux->events, CMUX_EVT_PHY_RX | CMUX_EVT_STOP,
+                                                  pdTRUE, pdFALSE, pdMS_TO_TICKS( CMUX_THREAD_POLL_MS ) );
+
+            if( ( uxBits & CMUX_EVT_STOP ) != 0U )
+            {
+                break;
+            }
+
+            do
+            {
+                recvLength = 0;
+
+                if( pCmux->pPhysicalCommIntf->recv( pCmux->physicalCommHandle, recvBuffer,
+                                                    CMUX_PHY_RECV_BUFFER_SIZE, 0U, &recvLength ) != IOT_COMM_INTERFACE_SUCCESS )
+                {
+                    recvLength = 0;
+                }
+
+                for( i = 0; i < recvLength; i++ )
+                {
+                    cmuxDecodeByte( &pCmux->decoder, recvBuffer[ i ] );
+                }
+            } while( recvLength > 0U );
+        }
+
+        ( void ) PlatformEventGroup_SetBits( pCmux->events, CMUX_EVT_THREAD_STOPPED );
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Called by the physical comm interface, usually from an ISR. */
+    static CellularCommInterfaceError_t cmuxPhysicalRxCallback( void * pUserData,
+                                                                CellularCommInterfaceHandle_t commInterfaceHandle )
+    {
+        const cmuxContext_t * pCmux = ( const cmuxContext_t * ) pUserData;
+        BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+        BaseType_t xResult = pdFALSE;
+        CellularCommInterfaceError_t retComm = IOT_COMM_INTERFACE_SUCCESS;
+
+        ( void ) commInterfaceHandle;
+
+        if( pCmux->events == NULL )
+        {
+            retComm = IOT_COMM_INTERFACE_BAD_PARAMETER;
+        }
+        else
+        {
+            xResult = PlatformEventGroup_SetBitsFromISR( pCmux->events, CMUX_EVT_PHY_RX,
+                                                         &xHigherPriorityTaskWoken );
+
+            if( xResult == pdPASS )
+            {
+                if( xHigherPriorityTaskWoken == pdTRUE )
+                {
+                    retComm = IOT_COMM_INTERFACE_SUCCESS;
+                }
+                else
+                {
+                    retComm = IOT_COMM_INTERFACE_BUSY;
+                }
+            }
+            else
+            {
+                retComm = IOT_COMM_INTERFACE_FAILURE;
+            }
+        }
+
+        return retComm;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* The demux thread is not running yet. Read the response to AT+CMUX directly. */
+    static CellularError_t cmuxEnterMuxMode( void )
+    {
+        cmuxContext_t * pCmux = &cmuxContext;
+        CellularError_t cellularStatus = CELLULAR_TIMEOUT;
+        char response[ CMUX_AT_RESPONSE_SIZE ] = { 0 };
+        uint32_t responseLength = 0;
+        uint32_t recvLength = 0;
+        uint32_t sentLength = 0;
+        uint32_t waitedMs = 0;
+        const uint32_t cmdLength = ( uint32_t ) strlen( CMUX_AT_COMMAND );
+
+        if( ( pCmux->pPhysicalCommIntf->send( pCmux->physicalCommHandle, ( const uint8_t * ) CMUX_AT_COMMAND,
+                                              cmdLength, CMUX_FRAME_SEND_TIMEOUT_MS, &sentLength ) != IOT_COMM_INTERFACE_SUCCESS ) ||
+            ( sentLength != cmdLength ) )
+        {
+            cellularStatus = CELLULAR_INTERNAL_FAILURE;
+        }
+        else
+        {
+            while( waitedMs < CELLULAR_BG96_CMUX_RESPONSE_TIMEOUT_MS )
+            {
+                recvLength = 0;
+
+                if( pCmux->pPhysicalCommIntf->recv( pCmux->physicalCommHandle,
+                                                    ( uint8_t * ) &response[ responseLength ],
+                                                    ( CMUX_AT_RESPONSE_SIZE - 1U ) - responseLength,
+                                                    CMUX_THREAD_POLL_MS, &recvLength ) != IOT_COMM_INTERFACE_SUCCESS )
+                {
+                    recvLength = 0;
+                }
+
+                responseLength = responseLength + recvLength;
+                response[ responseLength ] = '\0';
+
+                if( strstr( response, "OK\r\n" ) != NULL )
+                {
+                    cellularStatus = CELLULAR_SUCCESS;
+                    break;
+                }
+                else if( strstr( response, "ERROR" ) != NULL )
+                {
+                    cellularStatus = CELLULAR_UNSUPPORTED;
+                    break;
+                }
+                else if( responseLength == ( CMUX_AT_RESPONSE_SIZE - 1U ) )
+                {
+                    /* Keep the tail in case the final result is split. */
+                    ( void ) memmove( response, &response[ responseLength / 2U ], ( responseLength - ( responseLength / 2U ) ) + 1U );
+                    responseLength = responseLength - ( responseLength / 2U );
+                }
+                else
+                {
+                    /* Wait for more data. */
+                }
+
+                if( recvLength == 0U )
+                {
+                    waitedMs = waitedMs + CMUX_THREAD_POLL_MS;
+                }
+            }
+        }
+
+        if( cellularStatus != CELLULAR_SUCCESS )
+        {
+            LogError( ( "cmuxEnterMuxMode: AT+CMUX failed %d", cellularStatus ) );
+        }
+
+        return cellularStatus;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static CellularError_t cmuxOpenDlci( uint8_t dlci )
+    {
+        cmuxContext_t * pCmux = &cmuxContext;
+        CellularError_t cellularStatus = CELLULAR_SUCCESS;
+        PlatformEventGroup_EventBits uxBits = 0;
+        uint8_t mscMessage[ 4 ] = { 0 };
+
+        ( void ) PlatformEventGroup_ClearBits( pCmux->events, CMUX_EVT_UA | CMUX_EVT_DM );
+
+        if( cmuxSendFrame( dlci, true, CMUX_FRAME_SABM | CMUX_CONTROL_PF, NULL, 0U,
+                           CMUX_FRAME_SEND_TIMEOUT_MS ) != IOT_COMM_INTERFACE_SUCCESS )
+        {
+            cellularStatus = CELLULAR_INTERNAL_FAILURE;
+        }
+        else
+        {
+            uxBits = PlatformEventGroup_WaitBits( pCmux->events, CMUX_EVT_UA | CMUX_EVT_DM, pdTRUE, pdFALSE,
+                                                  pdMS_TO_TICKS( CELLULAR_BG96_CMUX_RESPONSE_TIMEOUT_MS ) );
+
+            if( ( uxBits & CMUX_EVT_UA ) != 0U )
+            {
+                pCmux->channels[ dlci ].established = true;
+            }
+            else if( ( uxBits & CMUX_EVT_DM ) != 0U )
+            {
+                cellularStatus = CELLULAR_NOT_ALLOWED;
+            }
+            else
+            {
+                cellularStatus = CELLULAR_TIMEOUT;
+            }
+        }
+
+        /* Report the V.24 signals of a data DLCI as ready. */
+        if( ( cellularStatus == CELLULAR_SUCCESS ) && ( dlci > 0U ) )
+        {
+            mscMessage[ 0 ] = CMUX_MSG_MSC | CMUX_MSG_CR;
+            mscMessage[ 1 ] = ( uint8_t ) ( 2U << 1 ) | CMUX_MSG_EA;
+            mscMessage[ 2 ] = ( uint8_t ) ( dlci << 2 ) | CMUX_ADDRESS_CR | CMUX_ADDRESS_EA;
+            mscMessage[ 3 ] = CMUX_V24_DV | CMUX_V24_RTR | CMUX_V24_RTC | CMUX_MSG_EA;
+            ( void ) cmuxSendFrame( 0U, true, CMUX_FRAME_UIH, mscMessage, sizeof( mscMessage ), CMUX_FRAME_SEND_TIMEOUT_MS );
+        }
+
+        if( cellularStatus != CELLULAR_SUCCESS )
+        {
+            LogError( ( "cmuxOpenDlci: DLCI %u failed %d", dlci, cellularStatus ) );
+        }
+
+        return cellularStatus;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void cmuxCloseDlci( uint8_t dlci )
+    {
+        cmuxContext_t * pCmux = &cmuxContext;
+
+        ( void ) PlatformEventGroup_ClearBits( pCmux->events, CMUX_EVT_UA | CMUX_EVT_DM );
+
+        if( cmuxSendFrame( dlci, true, CMUX_FRAME_DISC | CMUX_CONTROL_PF, NULL, 0U,
+                           CMUX_FRAME_SEND_TIMEOUT_MS ) == IOT_COMM_INTERFACE_SUCCESS )
+        {
+            ( void ) PlatformEventGroup_WaitBits( pCmux->events, CMUX_EVT_UA | CMUX_EVT_DM, pdTRUE, pdFALSE,
+                                                  pdMS_TO_TICKS( CELLULAR_BG96_CMUX_RESPONSE_TIMEOUT_MS ) );
+        }
+
+        pCmux->channels[ dlci ].established = false;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void cmuxShutdown( void )
+    {
+        cmuxContext_t * pCmux = &cmuxContext;
+        uint8_t dlci = 0;
+
+        if( pCmux->threadStarted == true )
+        {
+            ( void ) PlatformEventGroup_SetBits( pCmux->events, CMUX_EVT_STOP );
+            ( void ) PlatformEventGroup_WaitBits( pCmux->events, CMUX_EVT_THREAD_STOPPED, pdTRUE, pdFALSE,
+                                                  portMAX_DELAY );
+            pCmux->threadStarted = false;
+        }
+
+        if( pCmux->physicalCommHandle != NULL )
+        {
+            ( void ) pCmux->pPhysicalCommIntf->close( pCmux->physicalCommHandle );
+            pCmux->physicalCommHandle = NULL;
+        }
+
+        for( dlci = 1U; dlci <= CELLULAR_BG96_CMUX_CHANNELS; dlci++ )
+        {
+            if( pCmux->channels[ dlci ].rxMutexCreated == true )
+            {
+                PlatformMutex_Destroy( &pCmux->channels[ dlci ].rxMutex );
+                pCmux->channels[ dlci ].rxMutexCreated = false;
+            }
+        }
+
+        if( pCmux->txMutexCreated == true )
+        {
+            PlatformMutex_Destroy( &pCmux->txMutex );
+            pCmux->txMutexCreated = false;
+        }
+
+        if( pCmux->socketMutexCreated == true )
+        {
+            PlatformMutex_Destroy( &pCmux->socketMutex );
+            pCmux->socketMutexCreated = false;
+        }
+
+        if( pCmux->events != NULL )
+        {
+            PlatformEventGroup_Delete( pCmux->events );
+            pCmux->events = NULL;
+        }
+
+        pCmux->started = false;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static CellularCommInterfaceError_t cmuxChannelOpen( uint8_t dlci,
+                                                         CellularCommInterfaceReceiveCallback_t receiveCallback,
+                                                         void * pUserData,
+                                                         CellularCommInterfaceHandle_t * pCommInterfaceHandle )
+    {
+        cmuxChannel_t * pChannel = &cmuxContext.channels[ dlci ];
+        CellularCommInterfaceError_t commIntRet = IOT_COMM_INTERFACE_SUCCESS;
+
+        if( ( receiveCallback == NULL ) || ( pCommInterfaceHandle == NULL ) )
+        {
+            commIntRet = IOT_COMM_INTERFACE_BAD_PARAMETER;
+        }
+        else if( ( cmuxContext.started == false ) || ( pChannel->established == false ) )
+        {
+            commIntRet = IOT_COMM_INTERFACE_FAILURE;
+        }
+        else if( ( pChannel->receiveCallback != NULL ) || ( dlci == CELLULAR_BG96_CMUX_SOCKET_DLCI ) )
+        {
+            commIntRet = IOT_COMM_INTERFACE_BUSY;
+        }
+        else
+        {
+            pChannel->pUserData = pUserData;
+            pChannel->receiveCallback = receiveCallback;
+            *pCommInterfaceHandle = ( CellularCommInterfaceHandle_t ) pChannel;
+        }
+
+        return commIntRet;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static CellularCommInterfaceError_t cmuxChannel1Open( CellularCommInterfaceReceiveCallback_t receiveCallback,
+                                                          void * pUserData,
+                                                          CellularCommInterfaceHandle_t * pCommInterfaceHandle )
+    {
+        return cmuxChannelOpen( 1U, receiveCallback, pUserData, pCommInterfaceHandle );
+    }
+
+/*-----------------------------------------------------------*/
+
+    #if ( CELLULAR_BG96_CMUX_CHANNELS > 1U )
+        static CellularCommInterfaceError_t cmuxChannel2Open( CellularCommInterfaceReceiveCallback_t receiveCallback,
+                                                              void * pUserData,
+                                                              CellularCommInterfaceHandle_t * pCommInterfaceHandle )
+        {
+            return cmuxChannelOpen( 2U, receiveCallback, pUserData, pCommInterfaceHandle );
+        }
+    #endif
+
+/*-----------------------------------------------------------*/
+
+    #if ( CELLULAR_BG96_CMUX_CHANNELS > 2U )
+        static CellularCommInterfaceError_t cmuxChannel3Open( CellularCommInterfaceReceiveCallback_t receiveCallback,
+                                                              void * pUserData,
+                                                              CellularCommInterfaceHandle_t * pCommInterfaceHandle )
+        {
+            return cmuxChannelOpen( 3U, receiveCallback, pUserData, pCommInterfaceHandle );
+        }
+    #endif
+
+/*-----------------------------------------------------------*/
+
+/* Data is split into UIH frames of CELLULAR_BG96_CMUX_FRAME_SIZE bytes. Frames of
+ * different DLCIs interleave on the UART so one channel can not hold the others
+ * behind a long transfer. */
+    static CellularCommInterfaceError_t cmuxChannelSend( CellularCommInterfaceHandle_t commInterfaceHandle,
+                                                         const uint8_t * pData,
+                                                         uint32_t dataLength,
+                                                         uint32_t timeoutMilliseconds,
+                                                         uint32_t * pDataSentLength )
+    {
+        cmuxContext_t * pCmux = &cmuxContext;
+        cmuxChannel_t * pChannel = ( cmuxChannel_t * ) commInterfaceHandle;
+        CellularCommInterfaceError_t commIntRet = IOT_COMM_INTERFACE_SUCCESS;
+        uint32_t sentLength = 0;
+        uint32_t frameLength = 0;
+        TickType_t startTick = xTaskGetTickCount();
+        TickType_t timeoutTicks = pdMS_TO_TICKS( timeoutMilliseconds );
+
+        if( ( pChannel == NULL ) || ( pData == NULL ) || ( pDataSentLength == NULL ) )
+        {
+            commIntRet = IOT_COMM_INTERFACE_BAD_PARAMETER;
+        }
+        else if( pChannel->established == false )
+        {
+            commIntRet = IOT_COMM_INTERFACE_FAILURE;
+        }
+        else
+        {
+            while( sentLength < dataLength )
+            {
+                /* Wait while the modem has flow control on for this DLCI or for all of them. */
+                while( ( ( pCmux->txStopped == true ) || ( pChannel->txStopped == true ) ) &&
+                       ( ( xTaskGetTickCount() - startTick ) < timeoutTicks ) )
+                {
+                    ( void ) PlatformEventGroup_WaitBits( pCmux->events, CMUX_EVT_FLOW, pdTRUE, pdFALSE,
+                                                          pdMS_TO_TICKS( CMUX_THREAD_POLL_MS ) );
+                }
+
+                if( ( pCmux->txStopped == true ) || ( pChannel->txStopped == true ) )
+                {
+                    commIntRet = IOT_COMM_INTERFACE_TIMEOUT;
+                    break;
+                }
+
+                frameLength = dataLength - sentLength;
+
+                if( frameLength > CELLULAR_BG96_CMUX_FRAME_SIZE )
+                {
+                    frameLength = CELLULAR_BG96_CMUX_FRAME_SIZE;
+                }
+
+                commIntRet = cmuxSendFrame( pChannel->dlci, true, CMUX_FRAME_UIH, &pData[ sentLength ],
+                                            frameLength, timeoutMilliseconds );
+
+                if( commIntRet != IOT_COMM_INTERFACE_SUCCESS )
+                {
+                    break;
+                }
+
+                sentLength = sentLength + frameLength;
+            }
+
+            *pDataSentLength = sentLength;
+        }
+
+        return commIntRet;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static CellularCommInterfaceError_t cmuxChannelRecv( CellularCommInterfaceHandle_t commInterfaceHandle,
+                                                         uint8_t * pBuffer,
+                                                         uint32_t bufferLength,
+                                                         uint32_t timeoutMilliseconds,
+                                                         uint32_t * pDataReceivedLength )
+    {
+        cmuxContext_t * pCmux = &cmuxContext;
+        cmuxChannel_t * pChannel = ( cmuxChannel_t * ) commInterfaceHandle;
+        CellularCommInterfaceError_t commIntRet = IOT_COMM_INTERFACE_SUCCESS;
+        uint32_t recvLength = 0;
+        uint32_t rxCount = 0;
+
+        if( ( pChannel == NULL ) || ( pBuffer == NULL ) || ( pDataReceivedLength == NULL ) || ( bufferLength == 0U ) )
+        {
+            commIntRet = IOT_COMM_INTERFACE_BAD_PARAMETER;
+        }
+        else
+        {
+            /* Clear the event before checking the buffer so data delivered in between is not missed. */
+            ( void ) PlatformEventGroup_ClearBits( pCmux->events, CMUX_EVT_CHANNEL_RX( pChannel->dlci ) );
+
+            PlatformMutex_Lock( &pChannel->rxMutex );
+            rxCount = pChannel->rxCount;
+            PlatformMutex_Unlock( &pChannel->rxMutex );
+
+            if( ( rxCount == 0U ) && ( timeoutMilliseconds > 0U ) )
+            {
+                ( void ) PlatformEventGroup_WaitBits( pCmux->events, CMUX_EVT_CHANNEL_RX( pChannel->dlci ),
+                                                      pdTRUE, pdFALSE, pdMS_TO_TICKS( timeoutMilliseconds ) );
+            }
+
+            PlatformMutex_Lock( &pChannel->rxMutex );
+
+            while( ( recvLength < bufferLength ) && ( pChannel->rxCount > 0U ) )
+            {
+                pBuffer[ recvLength++ ] = pChannel->rxBuffer[ pChannel->rxTail ];
+                pChannel->rxTail = ( pChannel->rxTail + 1U ) % CELLULAR_BG96_CMUX_RX_BUFFER_SIZE;
+                pChannel->rxCount--;
+            }
+
+            PlatformMutex_Unlock( &pChannel->rxMutex );
+
+            *pDataReceivedLength = recvLength;
+        }
+
+        return commIntRet;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* The DLCI stays established. Only the user of the channel is detached. */
+    static CellularCommInterfaceError_t cmuxChannelClose( CellularCommInterfaceHandle_t commInterfaceHandle )
+    {
+        cmuxChannel_t * pChannel = ( cmuxChannel_t * ) commInterfaceHandle;
+        CellularCommInterfaceError_t commIntRet = IOT_COMM_INTERFACE_SUCCESS;
+
+        if( pChannel == NULL )
+        {
+            commIntRet = IOT_COMM_INTERFACE_BAD_PARAMETER;
+        }
+        else
+        {
+            pChannel->receiveCallback = NULL;
+            pChannel->pUserData = NULL;
+
+            PlatformMutex_Lock( &pChannel->rxMutex );
+            pChannel->rxHead = 0;
+            pChannel->rxTail = 0;
+            pChannel->rxCount = 0;
+            PlatformMutex_Unlock( &pChannel->rxMutex );
+        }
+
+        return commIntRet;
+    }
+
+/*-----------------------------------------------------------*/
+
+    #if ( CELLULAR_BG96_CMUX_SOCKET_DLCI > 0U )
+
+/* Drop what is left of an earlier command, e.g. the result of a timed out send. */
+        static void cmuxSocketFlush( cmuxChannel_t * pChannel )
+        {
+            PlatformMutex_Lock( &pChannel->rxMutex );
+            pChannel->rxHead = 0;
+            pChannel->rxTail = 0;
+            pChannel->rxCount = 0;
+            PlatformMutex_Unlock( &pChannel->rxMutex );
+        }
+
+/*-----------------------------------------------------------*/
+
+        static CellularError_t cmuxSocketRead( cmuxChannel_t * pChannel,
+                                               uint8_t * pBuffer,
+                                               uint32_t length,
+                                               TickType_t startTick,
+                                               TickType_t timeoutTicks )
+        {
+            CellularError_t cellularStatus = CELLULAR_SUCCESS;
+            uint32_t readLength = 0;
+            uint32_t recvLength = 0;
+
+            while( readLength < length )
+            {
+                if( ( xTaskGetTickCount() - startTick ) >= timeoutTicks )
+                {
+                    cellularStatus = CELLULAR_TIMEOUT;
+                    break;
+                }
+
+                recvLength = 0;
+                ( void ) cmuxChannelRecv( ( CellularCommInterfaceHandle_t ) pChannel, &pBuffer[ readLength ],
+                                          length - readLength, CMUX_THREAD_POLL_MS, &recvLength );
+                readLength = readLength + recvLength;
+            }
+
+            return cellularStatus;
+        }
+
+/*-----------------------------------------------------------*/
+
+/* Read lines until one starts with pPrefix. Other lines are skipped. The prompt
+ * of AT+QISEND is not terminated by CR LF. Bytes are read one at a time so the
+ * data following +QIRD is left in the buffer. */
+        static CellularError_t cmuxSocketWaitLine( cmuxChannel_t * pChannel,
+                                                   const char * pPrefix,
+                                                   char * pLine,
+                                                   TickType_t startTick,
+                                                   TickType_t timeoutTicks )
+        {
+            CellularError_t cellularStatus = CELLULAR_TIMEOUT;
+            uint32_t lineLength = 0;
+            uint8_t byte = 0;
+            bool lineDone = false;
+
+            pLine[ 0 ] = '\0';
+
+            while( cmuxSocketRead( pChannel, &byte, 1U, startTick, timeoutTicks ) == CELLULAR_SUCCESS )
+            {
+                if( byte == ( uint8_t ) '\n' )
+                {
+                    lineDone = true;
+                }
+                else if( byte != ( uint8_t ) '\r' )
+                {
+                    if( lineLength < ( CMUX_SOCKET_LINE_SIZE - 1U ) )
+                    {
+                        pLine[ lineLength ] = ( char ) byte;
+                        lineLength++;
+                        pLine[ lineLength ] = '\0';
+                    }
+
+                    lineDone = ( strcmp( pLine, CMUX_SOCKET_PROMPT ) == 0 );
+                }
+                else
+                {
+                    lineDone = false;
+                }
+
+                if( ( lineDone == true ) && ( lineLength > 0U ) )
+                {
+                    if( strncmp( pLine, pPrefix, strlen( pPrefix ) ) == 0 )
+                    {
+                        cellularStatus = CELLULAR_SUCCESS;
+                        break;
+                    }
+                    else if( ( strcmp( pLine, "ERROR" ) == 0 ) || ( strcmp( pLine, "SEND FAIL" ) == 0 ) ||
+                             ( strncmp( pLine, "+CME ERROR", strlen( "+CME ERROR" ) ) == 0 ) )
+                    {
+                        cellularStatus = CELLULAR_INTERNAL_FAILURE;
+                        break;
+                    }
+                    else
+                    {
+                        lineLength = 0;
+                        pLine[ 0 ] = '\0';
+                    }
+                }
+            }
+
+            return cellularStatus;
+        }
+
+/*-----------------------------------------------------------*/
+
+        static CellularError_t cmuxSocketCommand( cmuxChannel_t * pChannel,
+                                                  const char * pAtCmd )
+        {
+            CellularError_t cellularStatus = CELLULAR_SUCCESS;
+            const uint32_t cmdLength = ( uint32_t ) strlen( pAtCmd );
+            uint32_t sentLength = 0;
+
+            cmuxSocketFlush( pChannel );
+
+            if( ( cmuxChannelSend( ( CellularCommInterfaceHandle_t ) pChannel, ( const uint8_t * ) pAtCmd, cmdLength,
+                                   CMUX_FRAME_SEND_TIMEOUT_MS, &sentLength ) != IOT_COMM_INTERFACE_SUCCESS ) ||
+                ( sentLength != cmdLength ) )
+            {
+                cellularStatus = CELLULAR_INTERNAL_FAILURE;
+            }
+            else if( ( cmuxChannelSend( ( CellularCommInterfaceHandle_t ) pChannel, ( const uint8_t * ) "\r", 1U,
+                                        CMUX_FRAME_SEND_TIMEOUT_MS, &sentLength ) != IOT_COMM_INTERFACE_SUCCESS ) ||
+                     ( sentLength != 1U ) )
+            {
+                cellularStatus = CELLULAR_INTERNAL_FAILURE;
+            }
+            else
+            {
+                /* Empty else MISRA 15.7 */
+            }
+
+            return cellularStatus;
+        }
+
+/*-----------------------------------------------------------*/
+
+/* Each DLCI has its own AT interpreter, started with echo on. */
+        static CellularError_t cmuxSocketChannelInit( void )
+        {
+            cmuxChannel_t * pChannel = &cmuxContext.channels[ CELLULAR_BG96_CMUX_SOCKET_DLCI ];
+            CellularError_t cellularStatus = CELLULAR_SUCCESS;
+            TickType_t startTick = xTaskGetTickCount();
+            char line[ CMUX_SOCKET_LINE_SIZE ] = { 0 };
+
+            cellularStatus = cmuxSocketCommand( pChannel, "ATE0" );
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                cellularStatus = cmuxSocketWaitLine( pChannel, "OK", line, startTick,
+                                                     pdMS_TO_TICKS( CELLULAR_BG96_CMUX_RESPONSE_TIMEOUT_MS ) );
+            }
+
+            if( cellularStatus != CELLULAR_SUCCESS )
+            {
+                LogError( ( "cmuxSocketChannelInit: ATE0 on DLCI %u failed %d", CELLULAR_BG96_CMUX_SOCKET_DLCI, cellularStatus ) );
+            }
+
+            return cellularStatus;
+        }
+    #endif /* CELLULAR_BG96_CMUX_SOCKET_DLCI. */
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96CmuxStart( const CellularCommInterface_t * pPhysicalCommIntf )
+{
+    cmuxContext_t * pCmux = &cmuxContext;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint8_t dlci = 0;
+
+    if( pPhysicalCommIntf == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( pCmux->started == true )
+    {
+        cellularStatus = CELLULAR_LIBRARY_ALREADY_OPEN;
+    }
+    else
+    {
+        ( void ) memset( pCmux, 0, sizeof( cmuxContext_t ) );
+        pCmux->pPhysicalCommIntf = pPhysicalCommIntf;
+        pCmux->decoder.state = CMUX_DECODE_FLAG;
+        pCmux->started = true;
+
+        for( dlci = 0U; dlci <= CELLULAR_BG96_CMUX_CHANNELS; dlci++ )
+        {
+            pCmux->channels[ dlci ].dlci = dlci;
+        }
+
+        pCmux->events = PlatformEventGroup_Create();
+
+        if( pCmux->events == NULL )
+        {
+            cellularStatus = CELLULAR_RESOURCE_CREATION_FAIL;
+        }
+    }
+
+    /* The mutexes of the unused DLCI 0 channel are never created. */
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        pCmux->txMutexCreated = PlatformMutex_Create( &pCmux->txMutex, false );
+        pCmux->socketMutexCreated = PlatformMutex_Create( &pCmux->socketMutex, false );
+
+        for( dlci = 1U; dlci <= CELLULAR_BG96_CMUX_CHANNELS; dlci++ )
+        {
+            pCmux->channels[ dlci ].rxMutexCreated = PlatformMutex_Create( &pCmux->channels[ dlci ].rxMutex, false );
+
+            if( pCmux->channels[ dlci ].rxMutexCreated == false )
+            {
+                cellularStatus = CELLULAR_RESOURCE_CREATION_FAIL;
+            }
+        }
+
+        if( ( pCmux->txMutexCreated == false ) || ( pCmux->socketMutexCreated == false ) )
+        {
+            cellularStatus = CELLULAR_RESOURCE_CREATION_FAIL;
+        }
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        if( pPhysicalCommIntf->open( cmuxPhysicalRxCallback, pCmux,
+                                     &pCmux->physicalCommHandle ) != IOT_COMM_INTERFACE_SUCCESS )
+        {
+            pCmux->physicalCommHandle = NULL;
+            cellularStatus = CELLULAR_INTERNAL_FAILURE;
+        }
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = cmuxEnterMuxMode();
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        if( Platform_CreateDetachedThread( cmuxThread, pCmux, CELLULAR_BG96_CMUX_THREAD_PRIORITY,
+                                           CELLULAR_BG96_CMUX_THREAD_STACK_SIZE ) == true )
+        {
+            pCmux->threadStarted = true;
+        }
+        else
+        {
+            cellularStatus = CELLULAR_RESOURCE_CREATION_FAIL;
+        }
+    }
+
+    /* DLCI 0 first, then the data DLCIs. */
+    for( dlci = 0U; ( dlci <= CELLULAR_BG96_CMUX_CHANNELS ) && ( cellularStatus == CELLULAR_SUCCESS ); dlci++ )
+    {
+        cellularStatus = cmuxOpenDlci( dlci );
+    }
+
+    #if ( CELLULAR_BG96_CMUX_SOCKET_DLCI > 0U )
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            cellularStatus = cmuxSocketChannelInit();
+        }
+    #endif
+
+    if( ( cellularStatus != CELLULAR_SUCCESS ) && ( cellularStatus != CELLULAR_BAD_PARAMETER ) &&
+        ( cellularStatus != CELLULAR_LIBRARY_ALREADY_OPEN ) )
+    {
+        cmuxShutdown();
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+const CellularCommInterface_t * Cellular_BG96CmuxGetCommInterface( uint8_t dlci )
+{
+    const CellularCommInterface_t * pCommIntf = NULL;
+
+    if( ( dlci > 0U ) && ( dlci <= CELLULAR_BG96_CMUX_CHANNELS ) && ( dlci != CELLULAR_BG96_CMUX_SOCKET_DLCI ) )
+    {
+        pCommIntf = &cmuxCommInterfaces[ dlci - 1U ];
+    }
+
+    return pCommIntf;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96CmuxStop( void )
+{
+    cmuxContext_t * pCmux = &cmuxContext;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    uint8_t dlci = 0;
+    const uint8_t cldMessage[ 2 ] = { CMUX_MSG_CLD | CMUX_MSG_CR, CMUX_MSG_EA };
+
+    if( pCmux->started == false )
+    {
+        cellularStatus = CELLULAR_LIBRARY_NOT_OPEN;
+    }
+    else
+    {
+        for( dlci = CELLULAR_BG96_CMUX_CHANNELS; dlci > 0U; dlci-- )
+        {
+            if( pCmux->channels[ dlci ].established == true )
+            {
+                cmuxCloseDlci( dlci );
+            }
+        }
+
+        /* Close down the multiplexer. The modem returns to AT command mode. */
+        ( void ) cmuxSendFrame( 0U, true, CMUX_FRAME_UIH, cldMessage, sizeof( cldMessage ),
+                                CMUX_FRAME_SEND_TIMEOUT_MS );
+        Platform_Delay( CMUX_THREAD_POLL_MS );
+        cmuxShutdown();
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+#endif /* CELLULAR_BG96_CMUX */
+
+/*-----------------------------------------------------------*/
+
+/* Only data the modem accepted with SEND OK is reported as sent. */
+CellularError_t _Cellular_CmuxSocketSend( const char * pAtCmd,
+                                          const uint8_t * pData,
+                                          uint32_t dataLength,
+                                          uint32_t * pSentDataLength,
+                                          uint32_t timeoutMs )
+{
+    CellularError_t cellularStatus = CELLULAR_UNSUPPORTED;
+
+    #if ( CELLULAR_BG96_CMUX == 1 ) && ( CELLULAR_BG96_CMUX_SOCKET_DLCI > 0U )
+        cmuxContext_t * pCmux = &cmuxContext;
+        cmuxChannel_t * pChannel = &pCmux->channels[ CELLULAR_BG96_CMUX_SOCKET_DLCI ];
+        char line[ CMUX_SOCKET_LINE_SIZE ] = { 0 };
+        uint32_t sentLength = 0;
+
+        if( ( pCmux->started == true ) && ( pChannel->established == true ) )
+        {
+            PlatformMutex_Lock( &pCmux->socketMutex );
+            *pSentDataLength = 0;
+            cellularStatus = cmuxSocketCommand( pChannel, pAtCmd );
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                cellularStatus = cmuxSocketWaitLine( pChannel, CMUX_SOCKET_PROMPT, line, xTaskGetTickCount(),
+                                                     pdMS_TO_TICKS( PACKET_REQ_TIMEOUT_MS ) );
+            }
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                if( ( cmuxChannelSend( ( CellularCommInterfaceHandle_t ) pChannel, pData, dataLength, timeoutMs,
+                                       &sentLength ) != IOT_COMM_INTERFACE_SUCCESS ) || ( sentLength != dataLength ) )
+                {
+                    cellularStatus = CELLULAR_INTERNAL_FAILURE;
+                }
+            }
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                cellularStatus = cmuxSocketWaitLine( pChannel, "SEND OK", line, xTaskGetTickCount(),
+                                                     pdMS_TO_TICKS( timeoutMs ) );
+            }
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                *pSentDataLength = dataLength;
+            }
+
+            PlatformMutex_Unlock( &pCmux->socketMutex );
+
+            if( cellularStatus != CELLULAR_SUCCESS )
+            {
+                LogError( ( "_Cellular_CmuxSocketSend: %s failed %d", pAtCmd, cellularStatus ) );
+            }
+        }
+    #else
+        ( void ) pAtCmd;
+        ( void ) pData;
+        ( void ) dataLength;
+        ( void ) pSentDataLength;
+        ( void ) timeoutMs;
+    #endif /* CELLULAR_BG96_CMUX_SOCKET_DLCI. */
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+/* The response is +QIRD: <length>, the data and OK. */
+CellularError_t _Cellular_CmuxSocketRecv( const char * pAtCmd,
+                                          uint8_t * pBuffer,
+                                          uint32_t bufferLength,
+                                          uint32_t * pReceivedDataLength,
+                                          uint32_t timeoutMs )
+{
+    CellularError_t cellularStatus = CELLULAR_UNSUPPORTED;
+
+    #if ( CELLULAR_BG96_CMUX == 1 ) && ( CELLULAR_BG96_CMUX_SOCKET_DLCI > 0U )
+        cmuxContext_t * pCmux = &cmuxContext;
+        cmuxChannel_t * pChannel = &pCmux->channels[ CELLULAR_BG96_CMUX_SOCKET_DLCI ];
+        char line[ CMUX_SOCKET_LINE_SIZE ] = { 0 };
+        TickType_t startTick = xTaskGetTickCount();
+        int32_t dataLength = 0;
+
+        if( ( pCmux->started == true ) && ( pChannel->established == true ) )
+        {
+            PlatformMutex_Lock( &pCmux->socketMutex );
+            *pReceivedDataLength = 0;
+            cellularStatus = cmuxSocketCommand( pChannel, pAtCmd );
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                cellularStatus = cmuxSocketWaitLine( pChannel, "+QIRD:", line, startTick, pdMS_TO_TICKS( timeoutMs ) );
+            }
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                if( ( Cellular_ATStrtoi( &line[ strlen( "+QIRD:" ) ], 10, &dataLength ) != CELLULAR_AT_SUCCESS ) ||
+                    ( dataLength < 0 ) || ( ( uint32_t ) dataLength > bufferLength ) )
+                {
+                    cellularStatus = CELLULAR_INTERNAL_FAILURE;
+                }
+            }
+
+            if( ( cellularStatus == CELLULAR_SUCCESS ) && ( dataLength > 0 ) )
+            {
+                cellularStatus = cmuxSocketRead( pChannel, pBuffer, ( uint32_t ) dataLength, startTick,
+                                                 pdMS_TO_TICKS( timeoutMs ) );
+            }
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                cellularStatus = cmuxSocketWaitLine( pChannel, "OK", line, startTick, pdMS_TO_TICKS( timeoutMs ) );
+            }
+
+            if( cellularStatus == CELLULAR_SUCCESS )
+            {
+                *pReceivedDataLength = ( uint32_t ) dataLength;
+            }
+
+            PlatformMutex_Unlock( &pCmux->socketMutex );
+
+            if( cellularStatus != CELLULAR_SUCCESS )
+            {
+                LogError( ( "_Cellular_CmuxSocketRecv: %s failed %d", pAtCmd, cellularStatus ) );
+            }
+        }
+    #else
+        ( void ) pAtCmd;
+        ( void ) pBuffer;
+        ( void ) bufferLength;
+        ( void ) pReceivedDataLength;
+        ( void ) timeoutMs;
+    #endif /* CELLULAR_BG96_CMUX_SOCKET_DLCI. */
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
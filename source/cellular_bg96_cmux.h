@@ -0,0 +1,144 @@
+/*
+ * FreeRTOS-Cellular-Interface v1.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ */
+
+#ifndef __CELLULAR_BG96_CMUX_H__
+#define __CELLULAR_BG96_CMUX_H__
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    extern "C" {
+#endif
+/* *INDENT-ON* */
+
+/* Standard includes. */
+#include <stdint.h>
+
+#include "cellular_types.h"
+#include "cellular_comm_interface.h"
+
+/* Run the UART as a 3GPP 27.010 multiplexer ( AT+CMUX ). The physical comm
+ * interface is owned by the multiplexer and each DLCI is exposed as its own
+ * comm interface. Cellular_CommonInit is given the interface of one DLCI, which
+ * carries the control commands and the URCs. AT+QISEND and AT+QIRD of buffer
+ * mode sockets go over CELLULAR_BG96_CMUX_SOCKET_DLCI, so a long socket transfer
+ * does not hold the control commands back. */
+#ifndef CELLULAR_BG96_CMUX
+    #define CELLULAR_BG96_CMUX    0
+#endif
+
+/* Number of DLCIs opened in addition to the control channel DLCI 0. */
+#ifndef CELLULAR_BG96_CMUX_CHANNELS
+    #define CELLULAR_BG96_CMUX_CHANNELS    ( 2U )
+#endif
+
+/* DLCI used by the port for socket data. It is not available to the application.
+ * Bytes the modem sends on it outside a socket command are dropped, so URCs must
+ * be reported on the DLCI given to Cellular_CommonInit. Set to 0 to send socket
+ * data on that DLCI too. */
+#ifndef CELLULAR_BG96_CMUX_SOCKET_DLCI
+    #define CELLULAR_BG96_CMUX_SOCKET_DLCI    ( 2U )
+#endif
+
+/* Maximum information field size of a UIH frame. Must not exceed the N1 value
+ * the modem is running with. 31 is the 27.010 default for the basic option. */
+#ifndef CELLULAR_BG96_CMUX_FRAME_SIZE
+    #define CELLULAR_BG96_CMUX_FRAME_SIZE    ( 31U )
+#endif
+
+/* Receive buffer of each DLCI. Bytes that do not fit are dropped. */
+#ifndef CELLULAR_BG96_CMUX_RX_BUFFER_SIZE
+    #define CELLULAR_BG96_CMUX_RX_BUFFER_SIZE    ( 1600U )
+#endif
+
+/* Timeout for the AT+CMUX response and for each SABM / DISC acknowledgement. */
+#ifndef CELLULAR_BG96_CMUX_RESPONSE_TIMEOUT_MS
+    #define CELLULAR_BG96_CMUX_RESPONSE_TIMEOUT_MS    ( 3000U )
+#endif
+
+#ifndef CELLULAR_BG96_CMUX_THREAD_PRIORITY
+    #define CELLULAR_BG96_CMUX_THREAD_PRIORITY    PLATFORM_THREAD_DEFAULT_PRIORITY
+#endif
+
+#ifndef CELLULAR_BG96_CMUX_THREAD_STACK_SIZE
+    #define CELLULAR_BG96_CMUX_THREAD_STACK_SIZE    PLATFORM_THREAD_DEFAULT_STACK_SIZE
+#endif
+
+#if ( CELLULAR_BG96_CMUX == 1 ) && ( ( CELLULAR_BG96_CMUX_CHANNELS < 1U ) || ( CELLULAR_BG96_CMUX_CHANNELS > 3U ) )
+    #error "CELLULAR_BG96_CMUX_CHANNELS must be between 1 and 3."
+#endif
+
+#if ( CELLULAR_BG96_CMUX == 1 ) && ( CELLULAR_BG96_CMUX_SOCKET_DLCI > CELLULAR_BG96_CMUX_CHANNELS )
+    #error "CELLULAR_BG96_CMUX_SOCKET_DLCI must be 0 or one of the opened DLCIs."
+#endif
+
+#if ( CELLULAR_BG96_CMUX == 1 ) && ( ( CELLULAR_BG96_CMUX_FRAME_SIZE < 1U ) || ( CELLULAR_BG96_CMUX_FRAME_SIZE > 127U ) )
+    #error "CELLULAR_BG96_CMUX_FRAME_SIZE must be between 1 and 127."
+#endif
+
+/*-----------------------------------------------------------*/
+
+/**
+ * @brief Switch the modem to 27.010 multiplexing mode.
+ *
+ * Open the physical comm interface, send AT+CMUX=0 and establish DLCI 0 and
+ * DLCI 1 to CELLULAR_BG96_CMUX_CHANNELS. Echo is turned off on the socket
+ * DLCI. The modem must already be powered on and answering AT commands. Call it
+ * before Cellular_Init.
+ *
+ * @param[in] pPhysicalCommIntf The comm interface of the UART.
+ *
+ * @return CELLULAR_SUCCESS if all the DLCIs are established, otherwise an error
+ * code indicating the cause of the error. The physical comm interface is closed
+ * on error.
+ */
+CellularError_t Cellular_BG96CmuxStart( const CellularCommInterface_t * pPhysicalCommIntf );
+
+/**
+ * @brief Get the comm interface of a DLCI.
+ *
+ * @param[in] dlci The DLCI, from 1 to CELLULAR_BG96_CMUX_CHANNELS.
+ *
+ * @return The comm interface of the DLCI, or NULL if the DLCI is out of range
+ * or is CELLULAR_BG96_CMUX_SOCKET_DLCI.
+ * The interface can be opened once the multiplexer is started.
+ */
+const CellularCommInterface_t * Cellular_BG96CmuxGetCommInterface( uint8_t dlci );
+
+/**
+ * @brief Close all the DLCIs, leave multiplexing mode and close the physical
+ * comm interface. Call it after Cellular_Cleanup.
+ *
+ * @return CELLULAR_SUCCESS if the multiplexer is stopped, otherwise an error
+ * code indicating the cause of the error.
+ */
+CellularError_t Cellular_BG96CmuxStop( void );
+
+/* *INDENT-OFF* */
+#ifdef __cplusplus
+    }
+#endif
+/* *INDENT-ON* */
+
+#endif /* __CELLULAR_BG96_CMUX_H__ */
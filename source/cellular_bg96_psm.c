@@ -0,0 +1,1151 @@
+/*
+ * FreeRTOS-Cellular-Interface v1.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ */
+
+/* The config header is always included first. */
+#include "cellular_config.h"
+#include "cellular_config_defaults.h"
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+#include "cellular_platform.h"
+#include "cellular_types.h"
+#include "cellular_api.h"
+#include "cellular_common.h"
+#include "cellular_bg96.h"
+
+/*-----------------------------------------------------------*/
+
+/* GPRS timers of 3GPP TS 24.008 10.5.7. Bits 1 to 5 are the value and bits 6
+ * to 8 the unit. */
+#define PSM_TIMER_VALUE_MASK          ( 0x1FU )
+#define PSM_TIMER_VALUE_MAX           ( 31U )
+#define PSM_TIMER_UNIT_SHIFT          ( 5U )
+#define PSM_TIMER_UNIT_MASK           ( 0x07U )
+#define PSM_TIMER_UNIT_DEACTIVATED    ( 7U )
+#define PSM_TIMER_ENCODED_MAX         ( 0xFFU )
+
+/*-----------------------------------------------------------*/
+
+/* Unit durations in seconds of GPRS Timer 3, 10.5.7.4a, by the unit bits. */
+static const uint32_t psmTimer3UnitSeconds[ PSM_TIMER_UNIT_DEACTIVATED ] =
+{
+    600U, 3600U, 36000U, 2U, 30U, 60U, 1152000U
+};
+
+/* Unit durations in seconds of GPRS Timer, 10.5.7.3, and GPRS Timer 2, 10.5.7.4.
+ * The units that are 0 aren't defined and are decoded as 1 minute. */
+static const uint32_t psmTimer2UnitSeconds[ PSM_TIMER_UNIT_DEACTIVATED ] =
+{
+    2U, 60U, 360U, 0U, 0U, 0U, 0U
+};
+
+/*-----------------------------------------------------------*/
+
+static const uint32_t * psmTimerUnits( CellularBG96PsmTimer_t psmTimer );
+static bool psmTimerIsCloser( uint32_t seconds,
+                              CellularBG96PsmRounding_t rounding,
+                              uint32_t candidateSeconds,
+                              bool bestFound,
+                              uint32_t bestSeconds );
+
+/*-----------------------------------------------------------*/
+
+static const uint32_t * psmTimerUnits( CellularBG96PsmTimer_t psmTimer )
+{
+    const uint32_t * pUnitSeconds = psmTimer2UnitSeconds;
+
+    if( ( psmTimer == CELLULAR_BG96_PSM_TIMER_PERIODIC_TAU ) ||
+        ( psmTimer == CELLULAR_BG96_PSM_TIMER_PERIODIC_RAU ) )
+    {
+        pUnitSeconds = psmTimer3UnitSeconds;
+    }
+
+    return pUnitSeconds;
+}
+
+/*-----------------------------------------------------------*/
+
+/* A candidate at the same distance as the best one is closer if it is longer,
+ * so that the nearest rounding rounds half up. */
+static bool psmTimerIsCloser( uint32_t seconds,
+                              CellularBG96PsmRounding_t rounding,
+                              uint32_t candidateSeconds,
+                              bool bestFound,
+                              uint32_t bestSeconds )
+{
+    bool isCloser = false;
+    uint32_t candidateDistance = 0;
+    uint32_t bestDistance = 0;
+
+    if( ( rounding == CELLULAR_BG96_PSM_ROUND_UP ) && ( candidateSeconds < seconds ) )
+    {
+        isCloser = false;
+    }
+    else if( ( rounding == CELLULAR_BG96_PSM_ROUND_DOWN ) && ( candidateSeconds > seconds ) )
+    {
+        isCloser = false;
+    }
+    else if( bestFound == false )
+    {
+        isCloser = true;
+    }
+    else
+    {
+        candidateDistance = ( candidateSeconds > seconds ) ? ( candidateSeconds - seconds ) : ( seconds - candidateSeconds );
+        bestDistance = ( bestSeconds > seconds ) ? ( bestSeconds - seconds ) : ( seconds - bestSeconds );
+
+        if( ( candidateDistance < bestDistance ) ||
+            ( ( candidateDistance == bestDistance ) && ( candidateSeconds > bestSeconds ) ) )
+        {
+            isCloser = true;
+        }
+    }
+
+    return isCloser;
+}
+
+/*-----------------------------------------------------------*/
+
+#if ( CELLULAR_BG96_PSM_SCHEDULER == 1 )
+
+    #define PSM_EVT_QUEUE             ( 0x0001U )
+    #define PSM_EVT_STOP              ( 0x0002U )
+    #define PSM_EVT_THREAD_STOPPED    ( 0x0004U )
+
+/*-----------------------------------------------------------*/
+
+    static uint32_t psmActiveTimeMs( const CellularPsmSettings_t * pPsmSettings );
+    static TickType_t psmMsToTicks( uint32_t timeMs );
+    static bool psmWindowIsOpen( cellularModuleContext_t * pModuleContext );
+    static bool psmTakeEntry( cellularModuleContext_t * pModuleContext,
+                              bool dueOnly,
+                              cellularPsmTxEntry_t * pEntry );
+    static TickType_t psmNextDueTicks( const cellularModuleContext_t * pModuleContext );
+    static CellularError_t psmSendEntry( CellularHandle_t cellularHandle,
+                                         const cellularPsmTxEntry_t * pEntry,
+                                         uint32_t * pSentLength );
+    static void psmSchedulerRun( cellularModuleContext_t * pModuleContext );
+    static void psmSchedulerThread( void * pUserData );
+    static void psmSchedulerShutdown( cellularModuleContext_t * pModuleContext );
+
+/*-----------------------------------------------------------*/
+
+/* T3324 deactivated means the modem doesn't enter PSM. */
+    static uint32_t psmActiveTimeMs( const CellularPsmSettings_t * pPsmSettings )
+    {
+        uint32_t activeTimeSeconds = CELLULAR_BG96_PSM_TIMER_DEACTIVATED;
+        uint32_t activeTimeMs = 0;
+
+        if( pPsmSettings->mode == 1U )
+        {
+            ( void ) Cellular_BG96PsmTimerDecode( CELLULAR_BG96_PSM_TIMER_ACTIVE_TIME,
+                                                  pPsmSettings->activeTimeValue,
+                                                  &activeTimeSeconds );
+        }
+
+        if( activeTimeSeconds != CELLULAR_BG96_PSM_TIMER_DEACTIVATED )
+        {
+            activeTimeMs = activeTimeSeconds * 1000U;
+        }
+
+        return activeTimeMs;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* pdMS_TO_TICKS multiplies the milliseconds by the tick rate first and overflows
+ * for the PSM timers. Convert whole seconds separately and clamp. */
+    static TickType_t psmMsToTicks( uint32_t timeMs )
+    {
+        TickType_t timeTicks = portMAX_DELAY;
+        const uint32_t timeSeconds = timeMs / 1000U;
+
+        if( timeSeconds < ( ( uint32_t ) portMAX_DELAY / ( uint32_t ) configTICK_RATE_HZ ) )
+        {
+            timeTicks = ( ( TickType_t ) timeSeconds * ( TickType_t ) configTICK_RATE_HZ ) +
+                        pdMS_TO_TICKS( timeMs % 1000U );
+        }
+
+        return timeTicks;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Called with stateMutex held. */
+    static bool psmWindowIsOpen( cellularModuleContext_t * pModuleContext )
+    {
+        if( ( pModuleContext->psmWindowOpen == true ) && ( pModuleContext->psmActiveTimeMs > 0U ) &&
+            ( ( xTaskGetTickCount() - pModuleContext->psmLastActivityTick ) >= psmMsToTicks( pModuleContext->psmActiveTimeMs ) ) )
+        {
+            LogDebug( ( "PSM scheduler: active time elapsed, window closed" ) );
+            pModuleContext->psmWindowOpen = false;
+        }
+
+        return pModuleContext->psmWindowOpen;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Called with stateMutex held. The entry with the nearest deadline is removed
+ * from the queue and copied to pEntry. */
+    static bool psmTakeEntry( cellularModuleContext_t * pModuleContext,
+                              bool dueOnly,
+                              cellularPsmTxEntry_t * pEntry )
+    {
+        TickType_t currentTick = xTaskGetTickCount();
+        TickType_t elapsedTicks = 0;
+        TickType_t remainingTicks = 0;
+        TickType_t minRemainingTicks = portMAX_DELAY;
+        cellularPsmTxEntry_t * pFound = NULL;
+        uint32_t i = 0;
+
+        for( i = 0; i < CELLULAR_BG96_PSM_SCHEDULER_QUEUE_SIZE; i++ )
+        {
+            if( pModuleContext->psmTxQueue[ i ].inUse == true )
+            {
+                elapsedTicks = currentTick - pModuleContext->psmTxQueue[ i ].queueTick;
+                remainingTicks = 0;
+
+                if( elapsedTicks < pModuleContext->psmTxQueue[ i ].deadlineTicks )
+                {
+                    remainingTicks = pModuleContext->psmTxQueue[ i ].deadlineTicks - elapsedTicks;
+                }
+
+                if( ( ( dueOnly == false ) || ( remainingTicks == 0U ) ) &&
+                    ( ( pFound == NULL ) || ( remainingTicks < minRemainingTicks ) ) )
+                {
+                    pFound = &pModuleContext->psmTxQueue[ i ];
+                    minRemainingTicks = remainingTicks;
+                }
+            }
+        }
+
+        if( pFound != NULL )
+        {
+            *pEntry = *pFound;
+            pFound->inUse = false;
+        }
+
+        return ( pFound != NULL );
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Called with stateMutex held. */
+    static TickType_t psmNextDueTicks( const cellularModuleContext_t * pModuleContext )
+    {
+        TickType_t currentTick = xTaskGetTickCount();
+        TickType_t elapsedTicks = 0;
+        TickType_t nextDueTicks = portMAX_DELAY;
+        uint32_t i = 0;
+
+        for( i = 0; i < CELLULAR_BG96_PSM_SCHEDULER_QUEUE_SIZE; i++ )
+        {
+            if( pModuleContext->psmTxQueue[ i ].inUse == true )
+            {
+                elapsedTicks = currentTick - pModuleContext->psmTxQueue[ i ].queueTick;
+
+                if( elapsedTicks >= pModuleContext->psmTxQueue[ i ].deadlineTicks )
+                {
+                    nextDueTicks = 0;
+                }
+                else if( ( pModuleContext->psmTxQueue[ i ].deadlineTicks - elapsedTicks ) < nextDueTicks )
+                {
+                    nextDueTicks = pModuleContext->psmTxQueue[ i ].deadlineTicks - elapsedTicks;
+                }
+                else
+                {
+                    /* Empty else MISRA 15.7 */
+                }
+            }
+        }
+
+        return nextDueTicks;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* A payload larger than the modem send limit is sent in several calls. */
+    static CellularError_t psmSendEntry( CellularHandle_t cellularHandle,
+                                         const cellularPsmTxEntry_t * pEntry,
+                                         uint32_t * pSentLength )
+    {
+        CellularError_t cellularStatus = CELLULAR_SUCCESS;
+        uint32_t sentLength = 0;
+
+        *pSentLength = 0;
+
+        while( ( cellularStatus == CELLULAR_SUCCESS ) && ( *pSentLength < pEntry->dataLength ) )
+        {
+            sentLength = 0;
+            cellularStatus = Cellular_SocketSend( cellularHandle, pEntry->socketHandle,
+                                                  &pEntry->pData[ *pSentLength ],
+                                                  pEntry->dataLength - *pSentLength, &sentLength );
+
+            if( ( cellularStatus == CELLULAR_SUCCESS ) && ( sentLength == 0U ) )
+            {
+                LogError( ( "PSM scheduler: no data sent" ) );
+                cellularStatus = CELLULAR_INTERNAL_FAILURE;
+            }
+
+            *pSentLength = *pSentLength + sentLength;
+        }
+
+        return cellularStatus;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void psmSchedulerRun( cellularModuleContext_t * pModuleContext )
+    {
+        cellularPsmTxEntry_t entry = { 0 };
+        CellularBG96PsmWakeCallback_t wakeCallback = NULL;
+        CellularError_t wakeStatus = CELLULAR_SUCCESS;
+        CellularError_t sendStatus = CELLULAR_SUCCESS;
+        uint32_t sentLength = 0;
+        bool windowOpen = false;
+        bool entryDue = false;
+        bool wakeFailed = false;
+        bool entryFound = false;
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        windowOpen = psmWindowIsOpen( pModuleContext );
+        entryDue = ( psmNextDueTicks( pModuleContext ) == 0U );
+        wakeCallback = pModuleContext->psmWakeCallback;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        /* Wake the modem for the due payloads. The other payloads are sent in the same window. */
+        if( ( windowOpen == false ) && ( entryDue == true ) && ( wakeCallback != NULL ) )
+        {
+            LogInfo( ( "PSM scheduler: payload due, waking the modem" ) );
+            _Cellular_PowerWakeRequested( pModuleContext );
+            wakeStatus = wakeCallback( pModuleContext->pPsmWakeContext );
+
+            if( wakeStatus == CELLULAR_SUCCESS )
+            {
+                PlatformMutex_Lock( &pModuleContext->stateMutex );
+                pModuleContext->psmWindowOpen = true;
+                pModuleContext->psmLastActivityTick = xTaskGetTickCount();
+                PlatformMutex_Unlock( &pModuleContext->stateMutex );
+            }
+            else
+            {
+                LogWarn( ( "PSM scheduler: wake callback failed %d", wakeStatus ) );
+                wakeFailed = true;
+            }
+        }
+
+        do
+        {
+            entryFound = false;
+
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            windowOpen = psmWindowIsOpen( pModuleContext );
+
+            /* With the window closed, only the due payloads are taken. They are
+             * sent without wake callback or failed with the wake error. A window
+             * closed during the run is handled by the next run. */
+            if( ( windowOpen == true ) || ( wakeCallback == NULL ) || ( wakeFailed == true ) )
+            {
+                entryFound = psmTakeEntry( pModuleContext, ( windowOpen == false ), &entry );
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+            if( entryFound == true )
+            {
+                sentLength = 0;
+
+                if( ( windowOpen == false ) && ( wakeFailed == true ) )
+                {
+                    sendStatus = wakeStatus;
+                }
+                else
+                {
+                    sendStatus = psmSendEntry( pModuleContext->psmCellularHandle, &entry, &sentLength );
+                }
+
+                if( sendStatus == CELLULAR_SUCCESS )
+                {
+                    PlatformMutex_Lock( &pModuleContext->stateMutex );
+                    pModuleContext->psmLastActivityTick = xTaskGetTickCount();
+                    PlatformMutex_Unlock( &pModuleContext->stateMutex );
+                }
+
+                if( entry.callback != NULL )
+                {
+                    entry.callback( entry.socketHandle, entry.pData, sentLength, sendStatus, entry.pCallbackContext );
+                }
+            }
+        } while( entryFound == true );
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void psmSchedulerThread( void * pUserData )
+    {
+        cellularModuleContext_t * pModuleContext = ( cellularModuleContext_t * ) pUserData;
+        PlatformEventGroup_EventBits uxBits = 0;
+        TickType_t waitTicks = 0;
+
+        for( ; ; )
+        {
+            /* Sleep until a payload is queued or the nearest deadline. */
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            waitTicks = psmNextDueTicks( pModuleContext );
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+            uxBits = PlatformEventGroup_WaitBits( pModuleContext->psmSchedulerEvent, PSM_EVT_QUEUE | PSM_EVT_STOP,
+                                                  pdTRUE, pdFALSE, waitTicks );
+
+            if( ( uxBits & PSM_EVT_STOP ) != 0U )
+            {
+                break;
+            }
+
+            psmSchedulerRun( pModuleContext );
+        }
+
+        ( void ) PlatformEventGroup_SetBits( pModuleContext->psmSchedulerEvent, PSM_EVT_THREAD_STOPPED );
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void psmSchedulerShutdown( cellularModuleContext_t * pModuleContext )
+    {
+        cellularPsmTxEntry_t entry = { 0 };
+        bool started = false;
+        bool entryFound = false;
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        started = pModuleContext->psmSchedulerStarted;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        if( started == true )
+        {
+            /* A payload being sent is completed before the thread stops. */
+            ( void ) PlatformEventGroup_SetBits( pModuleContext->psmSchedulerEvent, PSM_EVT_STOP );
+            ( void ) PlatformEventGroup_WaitBits( pModuleContext->psmSchedulerEvent, PSM_EVT_THREAD_STOPPED,
+                                                  pdTRUE, pdFALSE, portMAX_DELAY );
+
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pModuleContext->psmSchedulerStarted = false;
+            pModuleContext->psmWindowOpen = false;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+            do
+            {
+                PlatformMutex_Lock( &pModuleContext->stateMutex );
+                entryFound = psmTakeEntry( pModuleContext, false, &entry );
+                PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+                if( ( entryFound == true ) && ( entry.callback != NULL ) )
+                {
+                    entry.callback( entry.socketHandle, entry.pData, 0U, CELLULAR_INTERNAL_FAILURE, entry.pCallbackContext );
+                }
+            } while( entryFound == true );
+
+            PlatformEventGroup_Delete( pModuleContext->psmSchedulerEvent );
+            pModuleContext->psmSchedulerEvent = NULL;
+        }
+    }
+
+#endif /* CELLULAR_BG96_PSM_SCHEDULER. */
+
+/*-----------------------------------------------------------*/
+
+#if ( CELLULAR_BG96_POWER_STATS == 1 )
+
+    static uint32_t powerElapsedMs( TickType_t startTick,
+                                    TickType_t endTick );
+    static void powerLatencyAdd( CellularBG96LatencyStats_t * pLatencyStats,
+                                 uint32_t latencyMs );
+
+/*-----------------------------------------------------------*/
+
+    static uint32_t powerElapsedMs( TickType_t startTick,
+                                    TickType_t endTick )
+    {
+        return ( uint32_t ) ( endTick - startTick ) * portTICK_PERIOD_MS;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void powerLatencyAdd( CellularBG96LatencyStats_t * pLatencyStats,
+                                 uint32_t latencyMs )
+    {
+        pLatencyStats->count++;
+        pLatencyStats->lastMs = latencyMs;
+        pLatencyStats->totalMs = pLatencyStats->totalMs + latencyMs;
+
+        if( latencyMs > pLatencyStats->maxMs )
+        {
+            pLatencyStats->maxMs = latencyMs;
+        }
+    }
+
+#endif /* CELLULAR_BG96_POWER_STATS. */
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_PowerStateChange( cellularModuleContext_t * pModuleContext,
+                                 CellularBG96PowerState_t powerState )
+{
+    #if ( CELLULAR_BG96_POWER_STATS == 1 )
+        TickType_t currentTick = xTaskGetTickCount();
+        CellularBG96PowerStats_t * pPowerStats = NULL;
+
+        if( ( pModuleContext != NULL ) && ( powerState < CELLULAR_BG96_POWER_STATE_MAX ) )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pPowerStats = &pModuleContext->powerStats;
+            pPowerStats->stateMs[ pPowerStats->state ] += powerElapsedMs( pModuleContext->powerStateTick, currentTick );
+            pModuleContext->powerStateTick = currentTick;
+
+            if( powerState == CELLULAR_BG96_POWER_ACTIVE )
+            {
+                if( pPowerStats->state == CELLULAR_BG96_POWER_PSM )
+                {
+                    pPowerStats->wakeupCount++;
+                }
+
+                /* The socket latency starts at "RDY" if the wakeup is not requested. */
+                if( pModuleContext->wakeRequestPending == true )
+                {
+                    powerLatencyAdd( &pPowerStats->wakeToRdy, powerElapsedMs( pModuleContext->wakeRequestTick, currentTick ) );
+                    pModuleContext->wakeStartTick = pModuleContext->wakeRequestTick;
+                    pModuleContext->wakeRequestPending = false;
+                }
+                else
+                {
+                    pModuleContext->wakeStartTick = currentTick;
+                }
+
+                pModuleContext->wakeSocketPending = true;
+            }
+            else
+            {
+                if( powerState == CELLULAR_BG96_POWER_PSM )
+                {
+                    pPowerStats->psmEntryCount++;
+                }
+
+                pModuleContext->wakeRequestPending = false;
+                pModuleContext->wakeSocketPending = false;
+            }
+
+            pPowerStats->state = powerState;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pModuleContext;
+        ( void ) powerState;
+    #endif /* CELLULAR_BG96_POWER_STATS. */
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_PowerWakeRequested( cellularModuleContext_t * pModuleContext )
+{
+    #if ( CELLULAR_BG96_POWER_STATS == 1 )
+        if( pModuleContext != NULL )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pModuleContext->powerStats.wakeRequestCount++;
+            pModuleContext->wakeRequestTick = xTaskGetTickCount();
+            pModuleContext->wakeRequestPending = true;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pModuleContext;
+    #endif /* CELLULAR_BG96_POWER_STATS. */
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_PowerSocketConnected( cellularModuleContext_t * pModuleContext )
+{
+    #if ( CELLULAR_BG96_POWER_STATS == 1 )
+        if( pModuleContext != NULL )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            if( pModuleContext->wakeSocketPending == true )
+            {
+                powerLatencyAdd( &pModuleContext->powerStats.wakeToSocket,
+                                 powerElapsedMs( pModuleContext->wakeStartTick, xTaskGetTickCount() ) );
+                pModuleContext->wakeSocketPending = false;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pModuleContext;
+    #endif /* CELLULAR_BG96_POWER_STATS. */
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_PsmWindowClose( cellularModuleContext_t * pModuleContext )
+{
+    #if ( CELLULAR_BG96_PSM_SCHEDULER == 1 )
+        if( pModuleContext != NULL )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pModuleContext->psmWindowOpen = false;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pModuleContext;
+    #endif /* CELLULAR_BG96_PSM_SCHEDULER. */
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_PsmSchedulerCleanup( cellularModuleContext_t * pModuleContext )
+{
+    #if ( CELLULAR_BG96_PSM_SCHEDULER == 1 )
+        if( pModuleContext != NULL )
+        {
+            psmSchedulerShutdown( pModuleContext );
+        }
+    #else
+        ( void ) pModuleContext;
+    #endif /* CELLULAR_BG96_PSM_SCHEDULER. */
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96PsmSchedulerStart( CellularHandle_t cellularHandle,
+                                                CellularBG96PsmWakeCallback_t wakeCallback,
+                                                void * pWakeContext )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    #if ( CELLULAR_BG96_PSM_SCHEDULER == 1 )
+        CellularPsmSettings_t psmSettings = { 0 };
+        PlatformEventGroupHandle_t schedulerEvent = NULL;
+        uint32_t activeTimeMs = 0;
+    #endif
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    #if ( CELLULAR_BG96_PSM_SCHEDULER == 1 )
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            /* Without the active time the window closes on the PSM URC only. */
+            if( Cellular_GetPsmSettings( cellularHandle, &psmSettings ) == CELLULAR_SUCCESS )
+            {
+                activeTimeMs = psmActiveTimeMs( &psmSettings );
+            }
+            else
+            {
+                LogWarn( ( "Cellular_BG96PsmSchedulerStart: couldn't read the active time" ) );
+            }
+
+            schedulerEvent = PlatformEventGroup_Create();
+
+            if( schedulerEvent == NULL )
+            {
+                cellularStatus = CELLULAR_RESOURCE_CREATION_FAIL;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            if( pModuleContext->psmSchedulerStarted == true )
+            {
+                cellularStatus = CELLULAR_LIBRARY_ALREADY_OPEN;
+            }
+            else
+            {
+                ( void ) memset( pModuleContext->psmTxQueue, 0, sizeof( pModuleContext->psmTxQueue ) );
+                pModuleContext->psmSchedulerEvent = schedulerEvent;
+                pModuleContext->psmSchedulerStarted = true;
+                pModuleContext->psmWindowOpen = true;
+                pModuleContext->psmLastActivityTick = xTaskGetTickCount();
+                pModuleContext->psmActiveTimeMs = activeTimeMs;
+                pModuleContext->psmCellularHandle = cellularHandle;
+                pModuleContext->psmWakeCallback = wakeCallback;
+                pModuleContext->pPsmWakeContext = pWakeContext;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+            if( cellularStatus != CELLULAR_SUCCESS )
+            {
+                PlatformEventGroup_Delete( schedulerEvent );
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            if( Platform_CreateDetachedThread( psmSchedulerThread, pModuleContext, CELLULAR_BG96_PSM_SCHEDULER_THREAD_PRIORITY,
+                                               CELLULAR_BG96_PSM_SCHEDULER_THREAD_STACK_SIZE ) == false )
+            {
+                PlatformMutex_Lock( &pModuleContext->stateMutex );
+                pModuleContext->psmSchedulerStarted = false;
+                pModuleContext->psmSchedulerEvent = NULL;
+                PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+                PlatformEventGroup_Delete( schedulerEvent );
+                cellularStatus = CELLULAR_RESOURCE_CREATION_FAIL;
+            }
+            else
+            {
+                LogInfo( ( "Cellular_BG96PsmSchedulerStart: active time %u ms", ( unsigned int ) activeTimeMs ) );
+            }
+        }
+    #else
+        ( void ) wakeCallback;
+        ( void ) pWakeContext;
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            cellularStatus = CELLULAR_UNSUPPORTED;
+        }
+    #endif /* CELLULAR_BG96_PSM_SCHEDULER. */
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96PsmSchedulerStop( CellularHandle_t cellularHandle )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        #if ( CELLULAR_BG96_PSM_SCHEDULER == 1 )
+            psmSchedulerShutdown( pModuleContext );
+        #else
+            cellularStatus = CELLULAR_UNSUPPORTED;
+        #endif
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96PsmSchedulerFlush( CellularHandle_t cellularHandle )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        #if ( CELLULAR_BG96_PSM_SCHEDULER == 1 )
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            if( pModuleContext->psmSchedulerStarted == false )
+            {
+                cellularStatus = CELLULAR_UNSUPPORTED;
+            }
+            else
+            {
+                pModuleContext->psmWindowOpen = true;
+                pModuleContext->psmLastActivityTick = xTaskGetTickCount();
+                ( void ) PlatformEventGroup_SetBits( pModuleContext->psmSchedulerEvent, PSM_EVT_QUEUE );
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        #else
+            cellularStatus = CELLULAR_UNSUPPORTED;
+        #endif
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96PsmSend( CellularHandle_t cellularHandle,
+                                      CellularSocketHandle_t socketHandle,
+                                      const uint8_t * pData,
+                                      uint32_t dataLength,
+                                      uint32_t deadlineMs,
+                                      CellularBG96PsmSendCallback_t sendCallback,
+                                      void * pCallbackContext )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    #if ( CELLULAR_BG96_PSM_SCHEDULER == 1 )
+        cellularPsmTxEntry_t * pEntry = NULL;
+        uint32_t i = 0;
+    #endif
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( socketHandle == NULL )
+    {
+        cellularStatus = CELLULAR_INVALID_HANDLE;
+    }
+    else if( ( pData == NULL ) || ( dataLength == 0U ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        #if ( CELLULAR_BG96_PSM_SCHEDULER == 1 )
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            if( pModuleContext->psmSchedulerStarted == false )
+            {
+                cellularStatus = CELLULAR_UNSUPPORTED;
+            }
+            else
+            {
+                for( i = 0; i < CELLULAR_BG96_PSM_SCHEDULER_QUEUE_SIZE; i++ )
+                {
+                    if( pModuleContext->psmTxQueue[ i ].inUse == false )
+                    {
+                        pEntry = &pModuleContext->psmTxQueue[ i ];
+                        break;
+                    }
+                }
+
+                if( pEntry == NULL )
+                {
+                    LogWarn( ( "Cellular_BG96PsmSend: PSM scheduler queue full" ) );
+                    cellularStatus = CELLULAR_NO_MEMORY;
+                }
+                else
+                {
+                    pEntry->inUse = true;
+                    pEntry->socketHandle = socketHandle;
+                    pEntry->pData = pData;
+                    pEntry->dataLength = dataLength;
+                    pEntry->queueTick = xTaskGetTickCount();
+                    pEntry->deadlineTicks = psmMsToTicks( deadlineMs );
+                    pEntry->callback = sendCallback;
+                    pEntry->pCallbackContext = pCallbackContext;
+                    ( void ) PlatformEventGroup_SetBits( pModuleContext->psmSchedulerEvent, PSM_EVT_QUEUE );
+                }
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        #else
+            ( void ) deadlineMs;
+            ( void ) sendCallback;
+            ( void ) pCallbackContext;
+            cellularStatus = CELLULAR_UNSUPPORTED;
+        #endif /* CELLULAR_BG96_PSM_SCHEDULER. */
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96PowerWakeRequested( CellularHandle_t cellularHandle )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        #if ( CELLULAR_BG96_POWER_STATS == 1 )
+            _Cellular_PowerWakeRequested( pModuleContext );
+        #else
+            cellularStatus = CELLULAR_UNSUPPORTED;
+        #endif
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96GetPowerStats( CellularHandle_t cellularHandle,
+                                            CellularBG96PowerStats_t * pPowerStats )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else if( pPowerStats == NULL )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        #if ( CELLULAR_BG96_POWER_STATS == 1 )
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            *pPowerStats = pModuleContext->powerStats;
+            pPowerStats->stateMs[ pPowerStats->state ] += powerElapsedMs( pModuleContext->powerStateTick, xTaskGetTickCount() );
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        #else
+            cellularStatus = CELLULAR_UNSUPPORTED;
+        #endif
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96PsmTimerEncode( CellularBG96PsmTimer_t psmTimer,
+                                             uint32_t seconds,
+                                             CellularBG96PsmRounding_t rounding,
+                                             uint32_t * pTimerValue )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    const uint32_t * pUnitSeconds = NULL;
+    uint32_t unit = 0;
+    uint32_t candidate = 0;
+    uint32_t value = 0;
+    uint32_t bestSeconds = 0;
+    uint32_t bestTimerValue = 0;
+    bool bestFound = false;
+
+    if( ( psmTimer >= CELLULAR_BG96_PSM_TIMER_MAX ) || ( rounding >= CELLULAR_BG96_PSM_ROUND_MAX ) ||
+        ( pTimerValue == NULL ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( seconds == CELLULAR_BG96_PSM_TIMER_DEACTIVATED )
+    {
+        *pTimerValue = PSM_TIMER_UNIT_DEACTIVATED << PSM_TIMER_UNIT_SHIFT;
+    }
+    else
+    {
+        pUnitSeconds = psmTimerUnits( psmTimer );
+
+        /* The units are tried from the last so that a zero duration isn't
+         * encoded as 0, which Cellular_SetPsmSettings leaves out. */
+        for( unit = PSM_TIMER_UNIT_DEACTIVATED; unit > 0U; unit-- )
+        {
+            if( pUnitSeconds[ unit - 1U ] != 0U )
+            {
+                /* The encodable durations around seconds in this unit. */
+                for( candidate = 0; candidate < 2U; candidate++ )
+                {
+                    value = ( seconds / pUnitSeconds[ unit - 1U ] ) + candidate;
+
+                    if( value > PSM_TIMER_VALUE_MAX )
+                    {
+                        value = PSM_TIMER_VALUE_MAX;
+                    }
+
+                    if( psmTimerIsCloser( seconds, rounding, value * pUnitSeconds[ unit - 1U ], bestFound, bestSeconds ) == true )
+                    {
+                        bestFound = true;
+                        bestSeconds = value * pUnitSeconds[ unit - 1U ];
+                        bestTimerValue = ( ( unit - 1U ) << PSM_TIMER_UNIT_SHIFT ) | value;
+                    }
+                }
+            }
+        }
+
+        if( bestFound == true )
+        {
+            *pTimerValue = bestTimerValue;
+        }
+        else
+        {
+            LogError( ( "Cellular_BG96PsmTimerEncode: %u seconds is above the range of timer %d",
+                        ( unsigned int ) seconds, psmTimer ) );
+            cellularStatus = CELLULAR_BAD_PARAMETER;
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96PsmTimerDecode( CellularBG96PsmTimer_t psmTimer,
+                                             uint32_t timerValue,
+                                             uint32_t * pSeconds )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    const uint32_t * pUnitSeconds = NULL;
+    uint32_t unit = ( timerValue >> PSM_TIMER_UNIT_SHIFT ) & PSM_TIMER_UNIT_MASK;
+    uint32_t unitSeconds = 0;
+
+    if( ( psmTimer >= CELLULAR_BG96_PSM_TIMER_MAX ) || ( timerValue > PSM_TIMER_ENCODED_MAX ) ||
+        ( pSeconds == NULL ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else if( unit == PSM_TIMER_UNIT_DEACTIVATED )
+    {
+        *pSeconds = CELLULAR_BG96_PSM_TIMER_DEACTIVATED;
+    }
+    else
+    {
+        pUnitSeconds = psmTimerUnits( psmTimer );
+        unitSeconds = ( pUnitSeconds[ unit ] != 0U ) ? pUnitSeconds[ unit ] : 60U;
+        *pSeconds = ( timerValue & PSM_TIMER_VALUE_MASK ) * unitSeconds;
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96SetPsmTimers( CellularHandle_t cellularHandle,
+                                           uint32_t periodicTauSeconds,
+                                           uint32_t activeTimeSeconds,
+                                           CellularBG96PsmRounding_t rounding )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPsmSettings_t psmSettings = { 0 };
+
+    cellularStatus = Cellular_BG96PsmTimerEncode( CELLULAR_BG96_PSM_TIMER_PERIODIC_TAU, periodicTauSeconds,
+                                                  rounding, &psmSettings.periodicTauValue );
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = Cellular_BG96PsmTimerEncode( CELLULAR_BG96_PSM_TIMER_ACTIVE_TIME, activeTimeSeconds,
+                                                      rounding, &psmSettings.activeTimeValue );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        psmSettings.mode = 1;
+        cellularStatus = Cellular_SetPsmSettings( cellularHandle, &psmSettings );
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96GetPsmTimers( CellularHandle_t cellularHandle,
+                                           uint32_t * pPeriodicTauSeconds,
+                                           uint32_t * pActiveTimeSeconds )
+{
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    CellularPsmSettings_t psmSettings = { 0 };
+
+    if( ( pPeriodicTauSeconds == NULL ) || ( pActiveTimeSeconds == NULL ) )
+    {
+        cellularStatus = CELLULAR_BAD_PARAMETER;
+    }
+    else
+    {
+        cellularStatus = Cellular_GetPsmSettings( cellularHandle, &psmSettings );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        cellularStatus = Cellular_BG96PsmTimerDecode( CELLULAR_BG96_PSM_TIMER_PERIODIC_TAU,
+                                                      psmSettings.periodicTauValue, pPeriodicTauSeconds );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        if( psmSettings.mode == 1U )
+        {
+            cellularStatus = Cellular_BG96PsmTimerDecode( CELLULAR_BG96_PSM_TIMER_ACTIVE_TIME,
+                                                          psmSettings.activeTimeValue, pActiveTimeSeconds );
+        }
+        else
+        {
+            *pActiveTimeSeconds = CELLULAR_BG96_PSM_TIMER_DEACTIVATED;
+        }
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
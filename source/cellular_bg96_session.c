@@ -0,0 +1,784 @@
+/*
+ * FreeRTOS-Cellular-Interface v1.3.0
+ * Copyright (C) 2020 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * https://www.FreeRTOS.org
+ * https://github.com/FreeRTOS
+ */
+
+/* The config header is always included first. */
+#include "cellular_config.h"
+#include "cellular_config_defaults.h"
+
+/* Standard includes. */
+#include <stdint.h>
+#include <string.h>
+
+#include "cellular_platform.h"
+#include "cellular_types.h"
+#include "cellular_api.h"
+#include "cellular_common.h"
+#include "cellular_bg96.h"
+
+/*-----------------------------------------------------------*/
+
+#if ( CELLULAR_BG96_SESSION_RESTORE == 1 )
+
+    #define SESSION_EVT_RDY               ( 0x0001U )
+    #define SESSION_EVT_SOCKET_OPEN       ( 0x0002U )
+    #define SESSION_EVT_STOP              ( 0x0004U )
+    #define SESSION_EVT_THREAD_STOPPED    ( 0x0008U )
+
+/* Restore steps of a socket. */
+    #define SESSION_SOCKET_IDLE           ( 0U )
+    #define SESSION_SOCKET_CONNECTING     ( 1U )
+    #define SESSION_SOCKET_DONE           ( 2U )
+
+/*-----------------------------------------------------------*/
+
+    static cellularSessionPdn_t * sessionPdnSlot( cellularModuleContext_t * pModuleContext,
+                                                  uint8_t contextId,
+                                                  bool allocate );
+    static uint32_t sessionElapsedMs( TickType_t startTick );
+    static bool sessionStopRequested( const cellularModuleContext_t * pModuleContext );
+    static CellularError_t sessionWaitRegistered( const cellularModuleContext_t * pModuleContext,
+                                                  CellularHandle_t cellularHandle,
+                                                  TickType_t rdyTick );
+    static void sessionHoldSockets( cellularModuleContext_t * pModuleContext,
+                                    CellularHandle_t cellularHandle );
+    static void sessionReleaseSocket( cellularModuleContext_t * pModuleContext,
+                                      uint32_t socketIndex );
+    static void sessionConnectSockets( cellularModuleContext_t * pModuleContext,
+                                       CellularHandle_t cellularHandle,
+                                       uint8_t contextId,
+                                       bool pdnActive,
+                                       uint8_t * pSocketSteps,
+                                       CellularBG96SessionRestoreResult_t * pResult );
+    static void sessionWaitSockets( cellularModuleContext_t * pModuleContext,
+                                    CellularHandle_t cellularHandle,
+                                    TickType_t rdyTick,
+                                    uint8_t * pSocketSteps,
+                                    CellularBG96SessionRestoreResult_t * pResult );
+    static void sessionRestoreRun( cellularModuleContext_t * pModuleContext );
+    static void sessionRestoreThread( void * pUserData );
+    static void sessionRestoreShutdown( cellularModuleContext_t * pModuleContext );
+
+/*-----------------------------------------------------------*/
+
+/* Called with stateMutex held. A new context takes a free slot or the slot of
+ * a context that isn't active. */
+    static cellularSessionPdn_t * sessionPdnSlot( cellularModuleContext_t * pModuleContext,
+                                                  uint8_t contextId,
+                                                  bool allocate )
+    {
+        cellularSessionPdn_t * pSessionPdn = NULL;
+        cellularSessionPdn_t * pFreeSlot = NULL;
+        uint32_t slot = 0;
+
+        for( slot = 0; slot < CELLULAR_BG96_SESSION_RESTORE_PDN_SLOTS; slot++ )
+        {
+            if( pModuleContext->sessionPdn[ slot ].contextId == contextId )
+            {
+                pSessionPdn = &pModuleContext->sessionPdn[ slot ];
+                break;
+            }
+
+            if( ( pModuleContext->sessionPdn[ slot ].active == false ) &&
+                ( ( pFreeSlot == NULL ) ||
+                  ( ( pFreeSlot->contextId != 0U ) && ( pModuleContext->sessionPdn[ slot ].contextId == 0U ) ) ) )
+            {
+                pFreeSlot = &pModuleContext->sessionPdn[ slot ];
+            }
+        }
+
+        if( ( pSessionPdn == NULL ) && ( allocate == true ) && ( pFreeSlot != NULL ) )
+        {
+            ( void ) memset( pFreeSlot, 0, sizeof( cellularSessionPdn_t ) );
+            pFreeSlot->contextId = contextId;
+            pSessionPdn = pFreeSlot;
+        }
+
+        return pSessionPdn;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static uint32_t sessionElapsedMs( TickType_t startTick )
+    {
+        return ( uint32_t ) ( xTaskGetTickCount() - startTick ) * ( uint32_t ) portTICK_PERIOD_MS;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static bool sessionStopRequested( const cellularModuleContext_t * pModuleContext )
+    {
+        PlatformEventGroup_EventBits uxBits = 0;
+
+        uxBits = PlatformEventGroup_WaitBits( pModuleContext->sessionEvent, SESSION_EVT_STOP, pdFALSE, pdFALSE, 0U );
+
+        return ( ( uxBits & SESSION_EVT_STOP ) != 0U ) ? true : false;
+    }
+
+/*-----------------------------------------------------------*/
+
+    static CellularError_t sessionWaitRegistered( const cellularModuleContext_t * pModuleContext,
+                                                  CellularHandle_t cellularHandle,
+                                                  TickType_t rdyTick )
+    {
+        CellularError_t cellularStatus = CELLULAR_TIMEOUT;
+        CellularServiceStatus_t serviceStatus = { 0 };
+        bool waiting = true;
+
+        while( waiting == true )
+        {
+            if( ( Cellular_GetServiceStatus( cellularHandle, &serviceStatus ) == CELLULAR_SUCCESS ) &&
+                ( ( serviceStatus.psRegistrationStatus == REGISTRATION_STATUS_REGISTERED_HOME ) ||
+                  ( serviceStatus.psRegistrationStatus == REGISTRATION_STATUS_ROAMING_REGISTERED ) ) )
+            {
+                cellularStatus = CELLULAR_SUCCESS;
+                waiting = false;
+            }
+            else if( sessionElapsedMs( rdyTick ) >= CELLULAR_BG96_SESSION_RESTORE_TIMEOUT_MS )
+            {
+                LogWarn( ( "Session restore: not registered after %u ms", ( unsigned int ) CELLULAR_BG96_SESSION_RESTORE_TIMEOUT_MS ) );
+                waiting = false;
+            }
+            else if( ( PlatformEventGroup_WaitBits( pModuleContext->sessionEvent, SESSION_EVT_STOP, pdFALSE, pdFALSE,
+                                                    pdMS_TO_TICKS( CELLULAR_BG96_SESSION_RESTORE_POLL_MS ) ) & SESSION_EVT_STOP ) != 0U )
+            {
+                cellularStatus = CELLULAR_INTERNAL_FAILURE;
+                waiting = false;
+            }
+            else
+            {
+                /* Empty else MISRA 15.7 */
+            }
+        }
+
+        return cellularStatus;
+    }
+
+/*-----------------------------------------------------------*/
+
+/* The sockets connected or connecting at "RDY" are held until they are
+ * restored. The application calls on them fail in the meantime. */
+    static void sessionHoldSockets( cellularModuleContext_t * pModuleContext,
+                                    CellularHandle_t cellularHandle )
+    {
+        const CellularSocketContext_t * pSocketData = NULL;
+        uint32_t socketIndex = 0;
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+        for( socketIndex = 0; socketIndex < CELLULAR_NUM_SOCKET_MAX; socketIndex++ )
+        {
+            pSocketData = _Cellular_GetSocketData( ( CellularContext_t * ) cellularHandle, socketIndex );
+
+            if( ( pSocketData != NULL ) &&
+                ( ( pSocketData->socketState == SOCKETSTATE_CONNECTED ) ||
+                  ( pSocketData->socketState == SOCKETSTATE_CONNECTING ) ) )
+            {
+                pModuleContext->sessionSocketRestoring[ socketIndex ] = true;
+            }
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void sessionReleaseSocket( cellularModuleContext_t * pModuleContext,
+                                      uint32_t socketIndex )
+    {
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        pModuleContext->sessionSocketRestoring[ socketIndex ] = false;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Connect the sockets of a PDN context, or of any context if contextId is 0.
+ * The sockets connected or connecting at "RDY" are lost with the reboot. The
+ * connect returns when the modem accepts the command and the connections are
+ * set up in parallel. The sockets of a PDN that isn't active are disconnected.
+ * Only the sockets held by sessionHoldSockets are changed. */
+    static void sessionConnectSockets( cellularModuleContext_t * pModuleContext,
+                                       CellularHandle_t cellularHandle,
+                                       uint8_t contextId,
+                                       bool pdnActive,
+                                       uint8_t * pSocketSteps,
+                                       CellularBG96SessionRestoreResult_t * pResult )
+    {
+        CellularSocketContext_t * pSocketData = NULL;
+        CellularSocketAddress_t remoteSocketAddress = { 0 };
+        CellularError_t cellularStatus = CELLULAR_SUCCESS;
+        uint32_t socketIndex = 0;
+
+        for( socketIndex = 0; socketIndex < CELLULAR_NUM_SOCKET_MAX; socketIndex++ )
+        {
+            pSocketData = _Cellular_GetSocketData( ( CellularContext_t * ) cellularHandle, socketIndex );
+
+            if( ( pSocketSteps[ socketIndex ] == SESSION_SOCKET_IDLE ) && ( pSocketData != NULL ) &&
+                ( _Cellular_SessionSocketRestoring( pModuleContext, socketIndex ) == true ) &&
+                ( ( contextId == 0U ) || ( pSocketData->contextId == contextId ) ) )
+            {
+                if( pdnActive == true )
+                {
+                    remoteSocketAddress = pSocketData->remoteSocketAddress;
+                    pSocketData->socketState = SOCKETSTATE_ALLOCATED;
+                    cellularStatus = _Cellular_SocketConnect( cellularHandle, pSocketData, pSocketData->dataMode,
+                                                              &remoteSocketAddress );
+                }
+                else
+                {
+                    pSocketData->socketState = SOCKETSTATE_DISCONNECTED;
+                    cellularStatus = CELLULAR_SOCKET_NOT_CONNECTED;
+                }
+
+                if( cellularStatus == CELLULAR_SUCCESS )
+                {
+                    pSocketSteps[ socketIndex ] = SESSION_SOCKET_CONNECTING;
+                }
+                else
+                {
+                    LogWarn( ( "Session restore: socket %u connect failed %d", ( unsigned int ) socketIndex, cellularStatus ) );
+                    pSocketSteps[ socketIndex ] = SESSION_SOCKET_DONE;
+                    sessionReleaseSocket( pModuleContext, socketIndex );
+                    pResult->socketFailed++;
+
+                    if( pResult->status == CELLULAR_SUCCESS )
+                    {
+                        pResult->status = cellularStatus;
+                    }
+                }
+            }
+        }
+    }
+
+/*-----------------------------------------------------------*/
+
+/* Wait for the "+QIOPEN" URCs of the connecting sockets. */
+    static void sessionWaitSockets( cellularModuleContext_t * pModuleContext,
+                                    CellularHandle_t cellularHandle,
+                                    TickType_t rdyTick,
+                                    uint8_t * pSocketSteps,
+                                    CellularBG96SessionRestoreResult_t * pResult )
+    {
+        const CellularSocketContext_t * pSocketData = NULL;
+        PlatformEventGroup_EventBits uxBits = 0;
+        uint32_t socketIndex = 0;
+        uint32_t pendingCount = 0;
+        uint32_t elapsedMs = 0;
+        bool timedOut = false;
+
+        do
+        {
+            /* Cleared before the sockets are checked, so that a URC received
+             * during the check wakes up the next wait. */
+            ( void ) PlatformEventGroup_ClearBits( pModuleContext->sessionEvent, SESSION_EVT_SOCKET_OPEN );
+            pendingCount = 0;
+            elapsedMs = sessionElapsedMs( rdyTick );
+            timedOut = ( elapsedMs >= CELLULAR_BG96_SESSION_RESTORE_TIMEOUT_MS ) ? true : false;
+
+            for( socketIndex = 0; socketIndex < CELLULAR_NUM_SOCKET_MAX; socketIndex++ )
+            {
+                if( pSocketSteps[ socketIndex ] == SESSION_SOCKET_CONNECTING )
+                {
+                    pSocketData = _Cellular_GetSocketData( ( CellularContext_t * ) cellularHandle, socketIndex );
+
+                    if( ( pSocketData != NULL ) && ( pSocketData->socketState == SOCKETSTATE_CONNECTED ) )
+                    {
+                        pSocketSteps[ socketIndex ] = SESSION_SOCKET_DONE;
+                        sessionReleaseSocket( pModuleContext, socketIndex );
+                        pResult->socketRestored++;
+                    }
+                    else if( ( pSocketData != NULL ) && ( pSocketData->socketState == SOCKETSTATE_CONNECTING ) &&
+                             ( timedOut == false ) )
+                    {
+                        pendingCount++;
+                    }
+                    else
+                    {
+                        LogWarn( ( "Session restore: socket %u not connected", ( unsigned int ) socketIndex ) );
+                        pSocketSteps[ socketIndex ] = SESSION_SOCKET_DONE;
+                        sessionReleaseSocket( pModuleContext, socketIndex );
+                        pResult->socketFailed++;
+
+                        if( pResult->status == CELLULAR_SUCCESS )
+                        {
+                            pResult->status = ( timedOut == true ) ? CELLULAR_TIMEOUT : CELLULAR_SOCKET_NOT_CONNECTED;
+                        }
+                    }
+                }
+            }
+
+            if( pendingCount > 0U )
+            {
+                uxBits = PlatformEventGroup_WaitBits( pModuleContext->sessionEvent, SESSION_EVT_SOCKET_OPEN | SESSION_EVT_STOP,
+                                                      pdFALSE, pdFALSE,
+                                                      pdMS_TO_TICKS( CELLULAR_BG96_SESSION_RESTORE_TIMEOUT_MS - elapsedMs ) );
+
+                if( ( uxBits & SESSION_EVT_STOP ) != 0U )
+                {
+                    pendingCount = 0;
+                }
+            }
+        } while( pendingCount > 0U );
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void sessionRestoreRun( cellularModuleContext_t * pModuleContext )
+    {
+        cellularSessionPdn_t sessionPdn[ CELLULAR_BG96_SESSION_RESTORE_PDN_SLOTS ];
+        uint8_t socketSteps[ CELLULAR_NUM_SOCKET_MAX ] = { 0 };
+        CellularBG96SessionRestoreResult_t result = { 0 };
+        CellularBG96SessionRestoreCallback_t restoreCallback = NULL;
+        void * pRestoreContext = NULL;
+        CellularHandle_t cellularHandle = NULL;
+        CellularError_t cellularStatus = CELLULAR_SUCCESS;
+        TickType_t rdyTick = 0;
+        uint32_t slot = 0;
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        ( void ) memcpy( sessionPdn, pModuleContext->sessionPdn, sizeof( sessionPdn ) );
+        rdyTick = pModuleContext->sessionRdyTick;
+        cellularHandle = pModuleContext->sessionCellularHandle;
+        restoreCallback = pModuleContext->sessionRestoreCallback;
+        pRestoreContext = pModuleContext->pSessionRestoreContext;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        result.status = CELLULAR_SUCCESS;
+        LogInfo( ( "Session restore: modem ready, restoring the session" ) );
+        sessionHoldSockets( pModuleContext, cellularHandle );
+
+        /* The modem starts with echo on and without the URC settings. The
+         * commands below expect the settings of Cellular_Init. */
+        cellularStatus = _Cellular_ModuleRestoreSettings( ( CellularContext_t * ) cellularHandle );
+
+        if( cellularStatus != CELLULAR_SUCCESS )
+        {
+            LogWarn( ( "Session restore: modem settings failed %d", cellularStatus ) );
+        }
+        else
+        {
+            /* The PDN configs are set while the modem registers. */
+            for( slot = 0; slot < CELLULAR_BG96_SESSION_RESTORE_PDN_SLOTS; slot++ )
+            {
+                if( ( sessionPdn[ slot ].contextId != 0U ) && ( sessionPdn[ slot ].configValid == true ) )
+                {
+                    cellularStatus = Cellular_SetPdnConfig( cellularHandle, sessionPdn[ slot ].contextId, &sessionPdn[ slot ].pdnConfig );
+
+                    if( cellularStatus != CELLULAR_SUCCESS )
+                    {
+                        LogWarn( ( "Session restore: PDN context %u config failed %d", sessionPdn[ slot ].contextId, cellularStatus ) );
+                    }
+                }
+            }
+
+            cellularStatus = sessionWaitRegistered( pModuleContext, cellularHandle, rdyTick );
+        }
+
+        if( cellularStatus != CELLULAR_SUCCESS )
+        {
+            result.status = cellularStatus;
+            sessionConnectSockets( pModuleContext, cellularHandle, 0U, false, socketSteps, &result );
+        }
+        else
+        {
+            /* The sockets of a PDN connect while the next PDN is activated. */
+            for( slot = 0; ( slot < CELLULAR_BG96_SESSION_RESTORE_PDN_SLOTS ) && ( sessionStopRequested( pModuleContext ) == false ); slot++ )
+            {
+                if( ( sessionPdn[ slot ].contextId != 0U ) && ( sessionPdn[ slot ].active == true ) )
+                {
+                    cellularStatus = Cellular_ActivatePdn( cellularHandle, sessionPdn[ slot ].contextId );
+
+                    if( cellularStatus == CELLULAR_SUCCESS )
+                    {
+                        result.pdnRestored++;
+                    }
+                    else
+                    {
+                        LogWarn( ( "Session restore: PDN context %u activation failed %d", sessionPdn[ slot ].contextId, cellularStatus ) );
+                        result.pdnFailed++;
+
+                        if( result.status == CELLULAR_SUCCESS )
+                        {
+                            result.status = cellularStatus;
+                        }
+                    }
+
+                    sessionConnectSockets( pModuleContext, cellularHandle, sessionPdn[ slot ].contextId,
+                                           ( cellularStatus == CELLULAR_SUCCESS ), socketSteps, &result );
+                }
+            }
+
+            /* The sockets of the PDN contexts that aren't recorded. */
+            if( sessionStopRequested( pModuleContext ) == false )
+            {
+                sessionConnectSockets( pModuleContext, cellularHandle, 0U, true, socketSteps, &result );
+                sessionWaitSockets( pModuleContext, cellularHandle, rdyTick, socketSteps, &result );
+            }
+        }
+
+        /* A stopped restore hands back the sockets it didn't restore. */
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        ( void ) memset( pModuleContext->sessionSocketRestoring, 0, sizeof( pModuleContext->sessionSocketRestoring ) );
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        if( sessionStopRequested( pModuleContext ) == false )
+        {
+            result.elapsedMs = sessionElapsedMs( rdyTick );
+            LogInfo( ( "Session restore: status %d, %u PDN and %u sockets restored in %u ms",
+                       result.status, result.pdnRestored, result.socketRestored, ( unsigned int ) result.elapsedMs ) );
+
+            /* The payloads held by the PSM scheduler are sent on the restored sockets. */
+            if( result.status == CELLULAR_SUCCESS )
+            {
+                ( void ) Cellular_BG96PsmSchedulerFlush( cellularHandle );
+            }
+
+            if( restoreCallback != NULL )
+            {
+                restoreCallback( &result, pRestoreContext );
+            }
+        }
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void sessionRestoreThread( void * pUserData )
+    {
+        cellularModuleContext_t * pModuleContext = ( cellularModuleContext_t * ) pUserData;
+        PlatformEventGroup_EventBits uxBits = 0;
+
+        for( ; ; )
+        {
+            uxBits = PlatformEventGroup_WaitBits( pModuleContext->sessionEvent, SESSION_EVT_RDY | SESSION_EVT_STOP,
+                                                  pdTRUE, pdFALSE, portMAX_DELAY );
+
+            if( ( uxBits & SESSION_EVT_STOP ) != 0U )
+            {
+                break;
+            }
+
+            /* A "RDY" during the restore starts it again. */
+            sessionRestoreRun( pModuleContext );
+        }
+
+        ( void ) PlatformEventGroup_SetBits( pModuleContext->sessionEvent, SESSION_EVT_THREAD_STOPPED );
+    }
+
+/*-----------------------------------------------------------*/
+
+    static void sessionRestoreShutdown( cellularModuleContext_t * pModuleContext )
+    {
+        bool started = false;
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        started = pModuleContext->sessionRestoreStarted;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        if( started == true )
+        {
+            /* A restore in progress stops after its current AT command. */
+            ( void ) PlatformEventGroup_SetBits( pModuleContext->sessionEvent, SESSION_EVT_STOP );
+            ( void ) PlatformEventGroup_WaitBits( pModuleContext->sessionEvent, SESSION_EVT_THREAD_STOPPED,
+                                                  pdTRUE, pdFALSE, portMAX_DELAY );
+
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pModuleContext->sessionRestoreStarted = false;
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+            PlatformEventGroup_Delete( pModuleContext->sessionEvent );
+            pModuleContext->sessionEvent = NULL;
+        }
+    }
+
+#endif /* CELLULAR_BG96_SESSION_RESTORE. */
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_SessionPdnConfigured( cellularModuleContext_t * pModuleContext,
+                                     uint8_t contextId,
+                                     const CellularPdnConfig_t * pPdnConfig )
+{
+    #if ( CELLULAR_BG96_SESSION_RESTORE == 1 )
+        cellularSessionPdn_t * pSessionPdn = NULL;
+
+        if( ( pModuleContext != NULL ) && ( pPdnConfig != NULL ) )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pSessionPdn = sessionPdnSlot( pModuleContext, contextId, true );
+
+            if( pSessionPdn != NULL )
+            {
+                pSessionPdn->pdnConfig = *pPdnConfig;
+                pSessionPdn->configValid = true;
+            }
+            else
+            {
+                LogWarn( ( "Session restore: no slot to record PDN context %u", contextId ) );
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pModuleContext;
+        ( void ) contextId;
+        ( void ) pPdnConfig;
+    #endif /* CELLULAR_BG96_SESSION_RESTORE. */
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_SessionPdnActive( cellularModuleContext_t * pModuleContext,
+                                 uint8_t contextId,
+                                 bool active )
+{
+    #if ( CELLULAR_BG96_SESSION_RESTORE == 1 )
+        cellularSessionPdn_t * pSessionPdn = NULL;
+
+        if( pModuleContext != NULL )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pSessionPdn = sessionPdnSlot( pModuleContext, contextId, active );
+
+            if( pSessionPdn != NULL )
+            {
+                pSessionPdn->active = active;
+            }
+            else if( active == true )
+            {
+                LogWarn( ( "Session restore: no slot to record PDN context %u", contextId ) );
+            }
+            else
+            {
+                /* Empty else MISRA 15.7 */
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pModuleContext;
+        ( void ) contextId;
+        ( void ) active;
+    #endif /* CELLULAR_BG96_SESSION_RESTORE. */
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_SessionModemReady( cellularModuleContext_t * pModuleContext )
+{
+    #if ( CELLULAR_BG96_SESSION_RESTORE == 1 )
+        if( pModuleContext != NULL )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            if( pModuleContext->sessionRestoreStarted == true )
+            {
+                pModuleContext->sessionRdyTick = xTaskGetTickCount();
+                ( void ) PlatformEventGroup_SetBits( pModuleContext->sessionEvent, SESSION_EVT_RDY );
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pModuleContext;
+    #endif /* CELLULAR_BG96_SESSION_RESTORE. */
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_SessionSocketOpened( cellularModuleContext_t * pModuleContext )
+{
+    #if ( CELLULAR_BG96_SESSION_RESTORE == 1 )
+        if( pModuleContext != NULL )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            if( pModuleContext->sessionRestoreStarted == true )
+            {
+                ( void ) PlatformEventGroup_SetBits( pModuleContext->sessionEvent, SESSION_EVT_SOCKET_OPEN );
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pModuleContext;
+    #endif /* CELLULAR_BG96_SESSION_RESTORE. */
+}
+
+/*-----------------------------------------------------------*/
+
+void _Cellular_SessionRestoreCleanup( cellularModuleContext_t * pModuleContext )
+{
+    #if ( CELLULAR_BG96_SESSION_RESTORE == 1 )
+        if( pModuleContext != NULL )
+        {
+            sessionRestoreShutdown( pModuleContext );
+        }
+    #else
+        ( void ) pModuleContext;
+    #endif /* CELLULAR_BG96_SESSION_RESTORE. */
+}
+
+/*-----------------------------------------------------------*/
+
+bool _Cellular_SessionSocketRestoring( cellularModuleContext_t * pModuleContext,
+                                       uint32_t socketId )
+{
+    bool restoring = false;
+
+    #if ( CELLULAR_BG96_SESSION_RESTORE == 1 )
+        if( ( pModuleContext != NULL ) && ( socketId < CELLULAR_NUM_SOCKET_MAX ) )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            restoring = pModuleContext->sessionSocketRestoring[ socketId ];
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pModuleContext;
+        ( void ) socketId;
+    #endif /* CELLULAR_BG96_SESSION_RESTORE. */
+
+    return restoring;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96SessionRestoreStart( CellularHandle_t cellularHandle,
+                                                  CellularBG96SessionRestoreCallback_t restoreCallback,
+                                                  void * pCallbackContext )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    #if ( CELLULAR_BG96_SESSION_RESTORE == 1 )
+        PlatformEventGroupHandle_t sessionEvent = NULL;
+    #endif
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    #if ( CELLULAR_BG96_SESSION_RESTORE == 1 )
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            sessionEvent = PlatformEventGroup_Create();
+
+            if( sessionEvent == NULL )
+            {
+                cellularStatus = CELLULAR_RESOURCE_CREATION_FAIL;
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            if( pModuleContext->sessionRestoreStarted == true )
+            {
+                cellularStatus = CELLULAR_LIBRARY_ALREADY_OPEN;
+            }
+            else
+            {
+                pModuleContext->sessionEvent = sessionEvent;
+                pModuleContext->sessionRestoreStarted = true;
+                pModuleContext->sessionCellularHandle = cellularHandle;
+                pModuleContext->sessionRestoreCallback = restoreCallback;
+                pModuleContext->pSessionRestoreContext = pCallbackContext;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+            if( cellularStatus != CELLULAR_SUCCESS )
+            {
+                PlatformEventGroup_Delete( sessionEvent );
+            }
+        }
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            if( Platform_CreateDetachedThread( sessionRestoreThread, pModuleContext, CELLULAR_BG96_SESSION_RESTORE_THREAD_PRIORITY,
+                                               CELLULAR_BG96_SESSION_RESTORE_THREAD_STACK_SIZE ) == false )
+            {
+                PlatformMutex_Lock( &pModuleContext->stateMutex );
+                pModuleContext->sessionRestoreStarted = false;
+                pModuleContext->sessionEvent = NULL;
+                PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+                PlatformEventGroup_Delete( sessionEvent );
+                cellularStatus = CELLULAR_RESOURCE_CREATION_FAIL;
+            }
+        }
+    #else
+        ( void ) restoreCallback;
+        ( void ) pCallbackContext;
+
+        if( cellularStatus == CELLULAR_SUCCESS )
+        {
+            cellularStatus = CELLULAR_UNSUPPORTED;
+        }
+    #endif /* CELLULAR_BG96_SESSION_RESTORE. */
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
+
+CellularError_t Cellular_BG96SessionRestoreStop( CellularHandle_t cellularHandle )
+{
+    CellularContext_t * pContext = ( CellularContext_t * ) cellularHandle;
+    CellularError_t cellularStatus = CELLULAR_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    cellularStatus = _Cellular_CheckLibraryStatus( pContext );
+
+    if( cellularStatus != CELLULAR_SUCCESS )
+    {
+        LogDebug( ( "_Cellular_CheckLibraryStatus failed" ) );
+    }
+    else
+    {
+        cellularStatus = _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext );
+    }
+
+    if( cellularStatus == CELLULAR_SUCCESS )
+    {
+        #if ( CELLULAR_BG96_SESSION_RESTORE == 1 )
+            sessionRestoreShutdown( pModuleContext );
+        #else
+            cellularStatus = CELLULAR_UNSUPPORTED;
+        #endif
+    }
+
+    return cellularStatus;
+}
+
+/*-----------------------------------------------------------*/
@@ -46,14 +46,24 @@
 /* The length for the string "+QIURC: \"recv\",<socket_index:1>,<socket_size:1~4>\r\n". */
 #define CELLULAR_BG96_DIRECT_PUSH_SOCKET_URC_PFREFIX_MAX_LEN    24
 
+/* Events of the held back signal strength URC thread. */
+#define CSQ_URC_EVT_PENDING                                     ( 0x0001UL )
+#define CSQ_URC_EVT_STOP                                        ( 0x0002UL )
+#define CSQ_URC_EVT_THREAD_STOPPED                              ( 0x0004UL )
+
 /*-----------------------------------------------------------*/
 
+static void _recordRegistration( const CellularContext_t * pContext,
+                                 const char * pInputLine );
+static void _invalidatePdnStatus( const CellularContext_t * pContext );
 static void _Cellular_ProcessCereg( CellularContext_t * pContext,
                                     char * pInputLine );
 static void _Cellular_ProcessCgreg( CellularContext_t * pContext,
                                     char * pInputLine );
 static void _Cellular_ProcessCreg( CellularContext_t * pContext,
                                    char * pInputLine );
+static void _Cellular_ProcessCpin( CellularContext_t * pContext,
+                                   char * pInputLine );
 static void _Cellular_ProcessPowerDown( CellularContext_t * pContext,
                                         char * pInputLine );
 static void _Cellular_ProcessPsmPowerDown( CellularContext_t * pContext,
@@ -86,6 +96,7 @@ CellularAtParseTokenMap_t CellularUrcHandlerTable[] =
 {
     { "CEREG",          _Cellular_ProcessCereg         },
     { "CGREG",          _Cellular_ProcessCgreg         },
+    { "CPIN",           _Cellular_ProcessCpin          },
     { "CREG",           _Cellular_ProcessCreg          },
     { "POWERED DOWN",   _Cellular_ProcessPowerDown     },
     { "PSM POWER DOWN", _Cellular_ProcessPsmPowerDown  },
@@ -100,11 +111,53 @@ uint32_t CellularUrcHandlerTableSize = sizeof( CellularUrcHandlerTable ) / sizeo
 
 /*-----------------------------------------------------------*/
 
+/* Record the first registration in the boot timing and report the registration
+ * status to the band scan plan. The line is parsed before the common URC handler
+ * modifies it. */
+static void _recordRegistration( const CellularContext_t * pContext,
+                                 const char * pInputLine )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+    long regStatus = 0;
+
+    if( ( pInputLine != NULL ) &&
+        ( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS ) )
+    {
+        /* The first parameter of the URC is <stat>. 1 is home and 5 is roaming. */
+        regStatus = strtol( pInputLine, NULL, 10 );
+
+        if( ( regStatus == 1L ) || ( regStatus == 5L ) )
+        {
+            _Cellular_BootTimingPhase( pModuleContext, CELLULAR_BG96_BOOT_PHASE_REGISTERED );
+        }
+
+        _Cellular_BandScanRegistration( pModuleContext, ( int32_t ) regStatus );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* The modem activates the default bearer PDN context when it attaches to LTE,
+ * without reporting it in a URC. */
+static void _invalidatePdnStatus( const CellularContext_t * pContext )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+    {
+        _Cellular_PdnStatusInvalidate( pModuleContext );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
 static void _Cellular_ProcessCereg( CellularContext_t * pContext,
                                     char * pInputLine )
 {
     CellularPktStatus_t pktStatus;
 
+    _recordRegistration( pContext, pInputLine );
+    _invalidatePdnStatus( pContext );
     pktStatus = Cellular_CommonUrcProcessCereg( pContext, pInputLine );
     if( pktStatus != CELLULAR_PKT_STATUS_OK )
     {
@@ -119,6 +172,8 @@ static void _Cellular_ProcessCgreg( CellularContext_t * pContext,
 {
     CellularPktStatus_t pktStatus;
 
+    _recordRegistration( pContext, pInputLine );
+    _invalidatePdnStatus( pContext );
     pktStatus = Cellular_CommonUrcProcessCgreg( pContext, pInputLine );
     if( pktStatus != CELLULAR_PKT_STATUS_OK )
     {
@@ -133,6 +188,7 @@ static void _Cellular_ProcessCreg( CellularContext_t * pContext,
 {
     CellularPktStatus_t pktStatus;
 
+    _recordRegistration( pContext, pInputLine );
     pktStatus = Cellular_CommonUrcProcessCreg( pContext, pInputLine );
     if( pktStatus != CELLULAR_PKT_STATUS_OK )
     {
@@ -201,6 +257,7 @@ static void _Cellular_ProcessSocketOpen( CellularContext_t * pContext,
     uint32_t sockIndex = 0;
     int32_t tempValue = 0;
     CellularSocketContext_t * pSocketData = NULL;
+    cellularModuleContext_t * pModuleContext = NULL;
 
     if( pContext == NULL )
     {
@@ -251,6 +308,16 @@ static void _Cellular_ProcessSocketOpen( CellularContext_t * pContext,
                 {
                     pktStatus = _parseSocketOpenNextTok( pToken, sockIndex, pSocketData );
                 }
+
+                if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+                {
+                    if( pSocketData->socketState == SOCKETSTATE_CONNECTED )
+                    {
+                        _Cellular_PowerSocketConnected( pModuleContext );
+                    }
+
+                    _Cellular_SessionSocketOpened( pModuleContext );
+                }
             }
             else
             {
@@ -272,6 +339,237 @@ static void _Cellular_ProcessSocketOpen( CellularContext_t * pContext,
 
 /*-----------------------------------------------------------*/
 
+static void _reportSignalStrengthUrc( const CellularContext_t * pContext,
+                                      int16_t rssi,
+                                      int16_t ber )
+{
+    CellularSignalInfo_t signalInfo = { 0 };
+
+    signalInfo.rssi = rssi;
+    signalInfo.rsrp = CELLULAR_INVALID_SIGNAL_VALUE;
+    signalInfo.rsrq = CELLULAR_INVALID_SIGNAL_VALUE;
+    signalInfo.ber = ber;
+    signalInfo.bars = CELLULAR_INVALID_SIGNAL_BAR_VALUE;
+    _Cellular_SignalStrengthChangedCallback( pContext, CELLULAR_URC_EVENT_SIGNAL_CHANGED, &signalInfo );
+}
+
+/*-----------------------------------------------------------*/
+
+/* Report the held back signal strength URC when the minimum interval since the
+ * last reported URC expires. */
+static void _signalStrengthUrcThread( void * pUserData )
+{
+    cellularModuleContext_t * pModuleContext = ( cellularModuleContext_t * ) pUserData;
+    PlatformEventGroup_EventBits uxBits = 0;
+    TickType_t waitTicks = portMAX_DELAY;
+    TickType_t elapsedTicks = 0;
+    TickType_t intervalTicks = 0;
+    bool reportUrc = false;
+    int16_t rssi = CELLULAR_INVALID_SIGNAL_VALUE;
+    int16_t ber = CELLULAR_INVALID_SIGNAL_VALUE;
+    const CellularContext_t * pContext = NULL;
+
+    for( ; ; )
+    {
+        uxBits = PlatformEventGroup_WaitBits( pModuleContext->csqUrcEvent, CSQ_URC_EVT_PENDING | CSQ_URC_EVT_STOP,
+                                              pdTRUE, pdFALSE, waitTicks );
+
+        if( ( uxBits & CSQ_URC_EVT_STOP ) != 0U )
+        {
+            break;
+        }
+
+        reportUrc = false;
+        waitTicks = portMAX_DELAY;
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+        if( pModuleContext->csqUrcPending == true )
+        {
+            elapsedTicks = xTaskGetTickCount() - pModuleContext->csqUrcLastTick;
+            intervalTicks = pdMS_TO_TICKS( pModuleContext->csqUrcMinIntervalMs );
+
+            if( elapsedTicks >= intervalTicks )
+            {
+                pModuleContext->csqUrcPending = false;
+                pModuleContext->csqUrcLastRssi = pModuleContext->csqUrcPendingRssi;
+                pModuleContext->csqUrcLastTick = xTaskGetTickCount();
+                rssi = pModuleContext->csqUrcPendingRssi;
+                ber = pModuleContext->csqUrcPendingBer;
+                pContext = ( const CellularContext_t * ) pModuleContext->csqUrcCellularHandle;
+                reportUrc = true;
+            }
+            else
+            {
+                waitTicks = intervalTicks - elapsedTicks;
+            }
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        if( reportUrc == true )
+        {
+            _reportSignalStrengthUrc( pContext, rssi, ber );
+        }
+    }
+
+    ( void ) PlatformEventGroup_SetBits( pModuleContext->csqUrcEvent, CSQ_URC_EVT_THREAD_STOPPED );
+}
+
+/*-----------------------------------------------------------*/
+
+/* Wake up the held back URC thread, starting it on the first held back URC. */
+static void _holdSignalStrengthUrc( cellularModuleContext_t * pModuleContext,
+                                    bool startThread )
+{
+    bool threadStarted = true;
+
+    if( startThread == true )
+    {
+        pModuleContext->csqUrcEvent = PlatformEventGroup_Create();
+
+        if( pModuleContext->csqUrcEvent == NULL )
+        {
+            threadStarted = false;
+        }
+        else if( Platform_CreateDetachedThread( _signalStrengthUrcThread, pModuleContext, CELLULAR_BG96_CSQ_URC_THREAD_PRIORITY,
+                                                CELLULAR_BG96_CSQ_URC_THREAD_STACK_SIZE ) == false )
+        {
+            PlatformEventGroup_Delete( pModuleContext->csqUrcEvent );
+            pModuleContext->csqUrcEvent = NULL;
+            threadStarted = false;
+        }
+        else
+        {
+            /* Empty else MISRA 15.7 */
+        }
+    }
+
+    if( threadStarted == true )
+    {
+        ( void ) PlatformEventGroup_SetBits( pModuleContext->csqUrcEvent, CSQ_URC_EVT_PENDING );
+    }
+    else
+    {
+        LogWarn( ( "_holdSignalStrengthUrc: the held back URC thread can't be started" ) );
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        pModuleContext->csqUrcThreadStarted = false;
+        pModuleContext->csqUrcPending = false;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+/* Returns true if the signal strength URC passes the rate limit and the
+ * hysteresis configured in the module context. A URC crossing the hysteresis
+ * within the rate limit is held back and reported when the interval expires. */
+static bool _filterSignalStrengthUrc( const CellularContext_t * pContext,
+                                      int16_t rssi,
+                                      int16_t ber )
+{
+    bool reportUrc = true;
+    bool holdUrc = false;
+    bool startThread = false;
+    cellularModuleContext_t * pModuleContext = NULL;
+    TickType_t currentTick = xTaskGetTickCount();
+    int32_t rssiDelta = 0;
+
+    if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+        if( pModuleContext->csqUrcReported == true )
+        {
+            rssiDelta = ( int32_t ) rssi - ( int32_t ) pModuleContext->csqUrcLastRssi;
+
+            if( rssiDelta < 0 )
+            {
+                rssiDelta = -rssiDelta;
+            }
+
+            if( ( rssi == CELLULAR_INVALID_SIGNAL_VALUE ) ||
+                ( pModuleContext->csqUrcLastRssi == CELLULAR_INVALID_SIGNAL_VALUE ) )
+            {
+                /* Always report losing or regaining the signal. */
+                reportUrc = ( rssi != pModuleContext->csqUrcLastRssi );
+            }
+            else if( rssiDelta < ( int32_t ) pModuleContext->csqUrcHysteresisDb )
+            {
+                reportUrc = false;
+            }
+            else if( ( currentTick - pModuleContext->csqUrcLastTick ) <
+                     pdMS_TO_TICKS( pModuleContext->csqUrcMinIntervalMs ) )
+            {
+                reportUrc = false;
+                holdUrc = true;
+            }
+            else
+            {
+                /* Empty else MISRA 15.7 */
+            }
+        }
+
+        /* Only the latest URC is held back. It is dropped if the RSSI returns
+         * within the hysteresis of the last reported URC. */
+        pModuleContext->csqUrcPending = holdUrc;
+
+        if( reportUrc == true )
+        {
+            pModuleContext->csqUrcReported = true;
+            pModuleContext->csqUrcLastRssi = rssi;
+            pModuleContext->csqUrcLastTick = currentTick;
+        }
+        else if( holdUrc == true )
+        {
+            pModuleContext->csqUrcPendingRssi = rssi;
+            pModuleContext->csqUrcPendingBer = ber;
+            pModuleContext->csqUrcCellularHandle = ( CellularHandle_t ) pContext;
+            startThread = ( pModuleContext->csqUrcThreadStarted == false );
+            pModuleContext->csqUrcThreadStarted = true;
+        }
+        else
+        {
+            LogDebug( ( "_filterSignalStrengthUrc: RSSI %d filtered", rssi ) );
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        if( holdUrc == true )
+        {
+            _holdSignalStrengthUrc( pModuleContext, startThread );
+        }
+    }
+
+    return reportUrc;
+}
+
+/*-----------------------------------------------------------*/
+
+/* Refresh the RSSI and BER of the signal information snapshot. The snapshot is
+ * only refreshed if a previous AT+QCSQ query provided the other fields. */
+static void _updateSignalInfoSnapshot( const CellularContext_t * pContext,
+                                       int16_t rssi,
+                                       int16_t ber )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+        if( pModuleContext->signalInfoValid == true )
+        {
+            pModuleContext->signalInfo.rssi = rssi;
+            pModuleContext->signalInfo.ber = ber;
+            pModuleContext->signalInfoTick = xTaskGetTickCount();
+        }
+
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
 static CellularPktStatus_t _parseUrcIndicationCsq( const CellularContext_t * pContext,
                                                    char * pUrcStr )
 {
@@ -281,7 +579,6 @@ static CellularPktStatus_t _parseUrcIndicationCsq( const CellularContext_t * pCo
     CellularError_t cellularStatus = CELLULAR_SUCCESS;
     int32_t retStrtoi = 0;
     int16_t csqRssi = CELLULAR_INVALID_SIGNAL_VALUE, csqBer = CELLULAR_INVALID_SIGNAL_VALUE;
-    CellularSignalInfo_t signalInfo = { 0 };
     char * pLocalUrcStr = pUrcStr;
 
     if( ( pContext == NULL ) || ( pUrcStr == NULL ) )
@@ -345,15 +642,15 @@ static CellularPktStatus_t _parseUrcIndicationCsq( const CellularContext_t * pCo
         }
     }
 
-    /* Handle the callback function. */
     if( atCoreStatus == CELLULAR_AT_SUCCESS )
     {
-        signalInfo.rssi = csqRssi;
-        signalInfo.rsrp = CELLULAR_INVALID_SIGNAL_VALUE;
-        signalInfo.rsrq = CELLULAR_INVALID_SIGNAL_VALUE;
-        signalInfo.ber = csqBer;
-        signalInfo.bars = CELLULAR_INVALID_SIGNAL_BAR_VALUE;
-        _Cellular_SignalStrengthChangedCallback( pContext, CELLULAR_URC_EVENT_SIGNAL_CHANGED, &signalInfo );
+        _updateSignalInfoSnapshot( pContext, csqRssi, csqBer );
+    }
+
+    /* Handle the callback function. */
+    if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) && ( _filterSignalStrengthUrc( pContext, csqRssi, csqBer ) == true ) )
+    {
+        _reportSignalStrengthUrc( pContext, csqRssi, csqBer );
     }
 
     if( atCoreStatus != CELLULAR_AT_SUCCESS )
@@ -434,6 +731,43 @@ static void _informDataReadyToUpperLayer( CellularSocketContext_t * pSocketData
 
 /*-----------------------------------------------------------*/
 
+/* Returns true if the data ready callback should be called for this URC. In buffer
+ * access mode, the callback is called once and further URCs are suppressed until
+ * the application reads the socket with Cellular_SocketRecv. */
+static bool _shouldInformDataReady( const CellularContext_t * pContext,
+                                    uint32_t sockIndex )
+{
+    bool informDataReady = true;
+
+    #if ( CELLULAR_BG96_COALESCE_DATA_READY_URC == 1 )
+        cellularModuleContext_t * pModuleContext = NULL;
+
+        if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+        {
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+
+            if( pModuleContext->dataReadyPending[ sockIndex ] == true )
+            {
+                pModuleContext->dataReadySuppressedCount[ sockIndex ]++;
+                informDataReady = false;
+            }
+            else
+            {
+                pModuleContext->dataReadyPending[ sockIndex ] = true;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    #else
+        ( void ) pContext;
+        ( void ) sockIndex;
+    #endif /* CELLULAR_BG96_COALESCE_DATA_READY_URC. */
+
+    return informDataReady;
+}
+
+/*-----------------------------------------------------------*/
+
 static CellularPktStatus_t _parseSocketUrcRecv( const CellularContext_t * pContext,
                                                 char * pUrcStr )
 {
@@ -475,7 +809,15 @@ static CellularPktStatus_t _parseSocketUrcRecv( const CellularContext_t * pConte
             {
                 /* Data received indication in buffer mode, need to fetch the data. */
                 LogDebug( ( "Data Received on socket Conn Id %d", sockIndex ) );
-                _informDataReadyToUpperLayer( pSocketData );
+
+                if( _shouldInformDataReady( pContext, sockIndex ) == true )
+                {
+                    _informDataReadyToUpperLayer( pSocketData );
+                }
+                else
+                {
+                    LogDebug( ( "Data ready already notified on socket Conn Id %d", sockIndex ) );
+                }
             }
         }
         else
@@ -567,6 +909,7 @@ static CellularPktStatus_t _parseSocketUrcAct( const CellularContext_t * pContex
     char * pToken = NULL;
     char * pLocalUrcStr = pUrcStr;
     uint8_t contextId = 0;
+    cellularModuleContext_t * pModuleContext = NULL;
     CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
     CellularPktStatus_t pktStatus = CELLULAR_PKT_STATUS_OK;
 
@@ -587,6 +930,13 @@ static CellularPktStatus_t _parseSocketUrcAct( const CellularContext_t * pContex
             if( _Cellular_IsValidPdn( contextId ) == CELLULAR_SUCCESS )
             {
                 LogDebug( ( "PDN deactivated. Context Id %d", contextId ) );
+
+                if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+                {
+                    _Cellular_DnsCacheFlush( pModuleContext, contextId );
+                    _Cellular_PdnStatusDeactivated( pModuleContext, contextId );
+                }
+
                 /* Indicate the upper layer about the PDN deactivate. */
                 _Cellular_PdnEventCallback( pContext, CELLULAR_URC_EVENT_PDN_DEACTIVATED, contextId );
             }
@@ -638,7 +988,7 @@ static CellularPktStatus_t _parseSocketUrcDns( const CellularContext_t * pContex
     {
         if( pModuleContext->dnsEventCallback != NULL )
         {
-            pModuleContext->dnsEventCallback( pModuleContext, pUrcStr, pModuleContext->pDnsUsrData );
+            pModuleContext->dnsEventCallback( pModuleContext, pUrcStr );
         }
         else
         {
@@ -729,10 +1079,80 @@ static void _Cellular_ProcessSimstat( CellularContext_t * pContext,
                                       char * pInputLine )
 {
     CellularSimCardState_t simCardState = CELLULAR_SIM_CARD_UNKNOWN;
+    cellularModuleContext_t * pModuleContext = NULL;
 
     if( pContext != NULL )
     {
-        ( void ) _Cellular_ParseSimstat( pInputLine, &simCardState );
+        if( ( _Cellular_ParseSimstat( pInputLine, &simCardState ) == CELLULAR_PKT_STATUS_OK ) &&
+            ( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS ) )
+        {
+            LogDebug( ( "_Cellular_ProcessSimstat: SIM card state %d", simCardState ) );
+            PlatformMutex_Lock( &pModuleContext->stateMutex );
+            pModuleContext->simCardStatus.simCardState = simCardState;
+            pModuleContext->simCardStateValid = true;
+
+            /* The SIM card is removed or inserted. The identity must be read again. */
+            pModuleContext->simCardInfoValid = false;
+            pModuleContext->simCardGeneration++;
+
+            if( simCardState == CELLULAR_SIM_CARD_INSERTED )
+            {
+                /* The lock state of the new SIM card is reported by CPIN URC or queried. */
+                pModuleContext->simCardLockStateValid = false;
+            }
+            else
+            {
+                pModuleContext->simCardStatus.simCardLockState = CELLULAR_SIM_CARD_LOCK_UNKNOWN;
+                pModuleContext->simCardLockStateValid = true;
+            }
+
+            PlatformMutex_Unlock( &pModuleContext->stateMutex );
+        }
+    }
+}
+
+/*-----------------------------------------------------------*/
+
+static void _Cellular_ProcessCpin( CellularContext_t * pContext,
+                                   char * pInputLine )
+{
+    char * pUrcStr = pInputLine;
+    CellularSimCardLockState_t simLockState = CELLULAR_SIM_CARD_LOCK_UNKNOWN;
+    CellularATError_t atCoreStatus = CELLULAR_AT_SUCCESS;
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    if( ( pContext == NULL ) || ( pInputLine == NULL ) )
+    {
+        atCoreStatus = CELLULAR_AT_BAD_PARAMETER;
+    }
+    else
+    {
+        atCoreStatus = Cellular_ATRemoveLeadingWhiteSpaces( &pUrcStr );
+    }
+
+    if( atCoreStatus == CELLULAR_AT_SUCCESS )
+    {
+        atCoreStatus = Cellular_ATRemoveTrailingWhiteSpaces( pUrcStr );
+    }
+
+    if( ( atCoreStatus == CELLULAR_AT_SUCCESS ) &&
+        ( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS ) )
+    {
+        /* "+CPIN: NOT READY" is reported as unknown lock state and requires a query. */
+        simLockState = _Cellular_ParseSimLockState( pUrcStr );
+        LogDebug( ( "_Cellular_ProcessCpin: SIM lock state %d", simLockState ) );
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        pModuleContext->simCardStatus.simCardLockState = simLockState;
+        pModuleContext->simCardLockStateValid = ( simLockState != CELLULAR_SIM_CARD_LOCK_UNKNOWN );
+
+        /* A query in progress must not overwrite the new lock state. */
+        pModuleContext->simCardGeneration++;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+    }
+    else
+    {
+        LogDebug( ( "CPIN URC Parse failure" ) );
     }
 }
 
@@ -741,6 +1161,8 @@ static void _Cellular_ProcessSimstat( CellularContext_t * pContext,
 static void _Cellular_ProcessPowerDown( CellularContext_t * pContext,
                                         char * pInputLine )
 {
+    cellularModuleContext_t * pModuleContext = NULL;
+
     /* The token is the pInputLine. No need to process the pInputLine. */
     ( void ) pInputLine;
 
@@ -751,6 +1173,12 @@ static void _Cellular_ProcessPowerDown( CellularContext_t * pContext,
     else
     {
         LogDebug( ( "_Cellular_ProcessPowerDown: Modem Power down event received" ) );
+
+        if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+        {
+            _Cellular_PowerStateChange( pModuleContext, CELLULAR_BG96_POWER_OFF );
+        }
+
         _Cellular_ModemEventCallback( pContext, CELLULAR_MODEM_EVENT_POWERED_DOWN );
     }
 }
@@ -760,6 +1188,8 @@ static void _Cellular_ProcessPowerDown( CellularContext_t * pContext,
 static void _Cellular_ProcessPsmPowerDown( CellularContext_t * pContext,
                                            char * pInputLine )
 {
+    cellularModuleContext_t * pModuleContext = NULL;
+
     /* The token is the pInputLine. No need to process the pInputLine. */
     ( void ) pInputLine;
 
@@ -770,15 +1200,47 @@ static void _Cellular_ProcessPsmPowerDown( CellularContext_t * pContext,
     else
     {
         LogDebug( ( "_Cellular_ProcessPsmPowerDown: Modem PSM power down event received" ) );
+
+        if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+        {
+            _Cellular_PsmWindowClose( pModuleContext );
+            _Cellular_PowerStateChange( pModuleContext, CELLULAR_BG96_POWER_PSM );
+        }
+
         _Cellular_ModemEventCallback( pContext, CELLULAR_MODEM_EVENT_PSM_ENTER );
     }
 }
 
 /*-----------------------------------------------------------*/
 
+/* The modem state cached in the module context is lost after modem reboot. */
+static void _invalidateModuleState( const CellularContext_t * pContext )
+{
+    cellularModuleContext_t * pModuleContext = NULL;
+
+    if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+    {
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        pModuleContext->signalInfoValid = false;
+        pModuleContext->simCardStateValid = false;
+        pModuleContext->simCardLockStateValid = false;
+        pModuleContext->simCardInfoValid = false;
+        pModuleContext->simCardGeneration++;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        _Cellular_DnsCacheFlush( pModuleContext, 0U );
+        _Cellular_DnsQueryAbort( pModuleContext );
+        _Cellular_PdnStatusInvalidate( pModuleContext );
+    }
+}
+
+/*-----------------------------------------------------------*/
+
 static void _Cellular_ProcessModemRdy( CellularContext_t * pContext,
                                        char * pInputLine )
 {
+    cellularModuleContext_t * pModuleContext = NULL;
+
     /* The token is the pInputLine. No need to process the pInputLine. */
     ( void ) pInputLine;
 
@@ -789,6 +1251,19 @@ static void _Cellular_ProcessModemRdy( CellularContext_t * pContext,
     else
     {
         LogDebug( ( "_Cellular_ProcessModemRdy: Modem Ready event received" ) );
+        _invalidateModuleState( pContext );
+
+        if( _Cellular_GetModuleContext( pContext, ( void ** ) &pModuleContext ) == CELLULAR_SUCCESS )
+        {
+            _Cellular_BootTimingPhase( pModuleContext, CELLULAR_BG96_BOOT_PHASE_RDY );
+
+            /* The sockets are lost. The application or the session restore
+             * opens the window again. */
+            _Cellular_PsmWindowClose( pModuleContext );
+            _Cellular_PowerStateChange( pModuleContext, CELLULAR_BG96_POWER_ACTIVE );
+            _Cellular_SessionModemReady( pModuleContext );
+        }
+
         _Cellular_ModemEventCallback( pContext, CELLULAR_MODEM_EVENT_BOOTUP_OR_REBOOT );
     }
 }
@@ -1040,6 +1515,32 @@ CellularPktStatus_t _Cellular_ParseSimstat( char * pInputStr,
 }
 /*-----------------------------------------------------------*/
 
+void _Cellular_SignalStrengthUrcCleanup( cellularModuleContext_t * pModuleContext )
+{
+    bool threadStarted = false;
+
+    PlatformMutex_Lock( &pModuleContext->stateMutex );
+    threadStarted = ( pModuleContext->csqUrcEvent != NULL );
+    PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+    if( threadStarted == true )
+    {
+        ( void ) PlatformEventGroup_SetBits( pModuleContext->csqUrcEvent, CSQ_URC_EVT_STOP );
+        ( void ) PlatformEventGroup_WaitBits( pModuleContext->csqUrcEvent, CSQ_URC_EVT_THREAD_STOPPED,
+                                              pdTRUE, pdFALSE, portMAX_DELAY );
+
+        PlatformMutex_Lock( &pModuleContext->stateMutex );
+        pModuleContext->csqUrcThreadStarted = false;
+        pModuleContext->csqUrcPending = false;
+        PlatformMutex_Unlock( &pModuleContext->stateMutex );
+
+        PlatformEventGroup_Delete( pModuleContext->csqUrcEvent );
+        pModuleContext->csqUrcEvent = NULL;
+    }
+}
+
+/*-----------------------------------------------------------*/
+
 #if ( CELLULAR_BG96_SUPPPORT_DIRECT_PUSH_SOCKET == 1 )
     CellularPktStatus_t Cellular_BG96InputBufferCallback( void * pInputBufferCallbackContext,
                                                           char * pBuffer,